@@ -16,27 +16,11 @@ namespace FomodInstaller.Interface
         private FileTree m_ftFiles;
         private static IList<string> m_lstIgnore = new List<string> { "^__MACOSX" };
         private static ISet<string> m_setIgnore = new HashSet<string>(m_lstIgnore);
+        internal static readonly Regex SkipExpression = new Regex(string.Join("|", m_lstIgnore), RegexOptions.IgnoreCase | RegexOptions.Compiled);
 
         public static string FindPathPrefix(IList<string> fileList, IList<string> expressions)
         {
-            Regex skipExpression = new Regex(string.Join("|", m_lstIgnore), RegexOptions.IgnoreCase);
-            Regex matchExpression = new Regex(string.Join("|", expressions), RegexOptions.IgnoreCase);
-            int index = 0;
-            string res = fileList.FirstOrDefault(filePath => {
-                if (skipExpression.IsMatch(filePath))
-                {
-                    return false;
-                }
-                Match match = matchExpression.Match(filePath.Replace('\\', '/'));
-                if (match.Success)
-                {
-                    index = match.Index;
-                }
-                return match.Success;
-            });
-            return (res != null)
-                ? res.Substring(0, index)
-                : "";
+            return StopPatternSet.GetOrCreate(expressions).FindPathPrefix(fileList);
         }
 
         public ArchiveStructure(IEnumerable<string> files)
@@ -1,4 +1,5 @@
 ﻿using FomodInstaller.Interface.ui;
+using FomodInstaller.Scripting;
 
 namespace FomodInstaller.Interface
 {
@@ -8,5 +9,9 @@ namespace FomodInstaller.Interface
         public abstract IniDelegates ini { get; }
         public abstract ContextDelegates context { get; }
         public abstract UIDelegates ui { get; }
+        /// <summary>
+        /// Reads the images of the dialog ahead of the host, null to not prefetch them
+        /// </summary>
+        public virtual ImagePrefetcher imagePrefetcher => null;
     }
 }
@@ -153,7 +153,7 @@ namespace FomodInstaller.Interface
             if (!string.IsNullOrEmpty(InstallScriptPath))
             {
                 var scriptData = FileSystem.ReadAllBytes(Path.Combine(TempPath, InstallScriptPath));
-                ModInstallScript = InstallScriptType.LoadScript(TextUtil.ByteToString(scriptData), validate);
+                ModInstallScript = ScriptCache.Shared.GetOrLoad(InstallScriptType, InstallScriptPath, scriptData, validate);
                 // when we have an install script, do we really assume that this script uses paths relative
                 // to what our heuristics assumes is the top level directory?
                 int offset = InstallScriptPath.IndexOf(Path.Combine("fomod", "ModuleConfig.xml"), StringComparison.InvariantCultureIgnoreCase);
@@ -0,0 +1,73 @@
+﻿using System;
+using System.Collections.Concurrent;
+using System.Collections.Generic;
+using System.Text.RegularExpressions;
+
+namespace FomodInstaller.Interface
+{
+    /// <summary>
+    /// Stop patterns compiled into a single expression.
+    /// Hosts pass the same game specific patterns on every install, so compiled sets are shared
+    /// between installs with the same patterns.
+    /// </summary>
+    public sealed class StopPatternSet
+    {
+        private const int MaxCachedSets = 64;
+
+        private static readonly ConcurrentDictionary<string, StopPatternSet> Cache = new ConcurrentDictionary<string, StopPatternSet>(StringComparer.Ordinal);
+
+        private readonly Regex m_rgxMatch;
+
+        private StopPatternSet(IList<string> patterns)
+        {
+            // No patterns match at the start of the first file, which is an empty prefix
+            m_rgxMatch = patterns.Count == 0
+                ? null
+                : new Regex(string.Join("|", patterns), RegexOptions.IgnoreCase | RegexOptions.Compiled);
+        }
+
+        /// <summary>
+        /// Returns the compiled set for the patterns, compiling them on first use
+        /// </summary>
+        public static StopPatternSet GetOrCreate(IList<string> patterns)
+        {
+            var key = string.Join("\n", patterns);
+            if (Cache.TryGetValue(key, out var set))
+            {
+                return set;
+            }
+
+            // Hosts use a handful of sets, anything beyond that is not worth keeping
+            if (Cache.Count >= MaxCachedSets)
+            {
+                Cache.Clear();
+            }
+            return Cache.GetOrAdd(key, _ => new StopPatternSet(patterns));
+        }
+
+        /// <summary>
+        /// Finds the path up to the first stop pattern match in a single pass over the file list
+        /// </summary>
+        public string FindPathPrefix(IList<string> fileList)
+        {
+            foreach (var filePath in fileList)
+            {
+                if (ArchiveStructure.SkipExpression.IsMatch(filePath))
+                {
+                    continue;
+                }
+                if (m_rgxMatch == null)
+                {
+                    return "";
+                }
+
+                var match = m_rgxMatch.Match(filePath.Replace('\\', '/'));
+                if (match.Success)
+                {
+                    return filePath.Substring(0, match.Index);
+                }
+            }
+            return "";
+        }
+    }
+}
@@ -10,6 +10,16 @@ namespace FomodInstaller.Scripting
 	/// </summary>
 	public interface IScriptExecutor
 	{
+		/// <summary>
+		/// Gets or sets whether the script runs without a dialog, taking the preset or the default choices.
+		/// </summary>
+		bool Headless { get; set; }
+
+		/// <summary>
+		/// Gets or sets the list a headless run appends its choices to, <c>null</c> to not log them.
+		/// </summary>
+		IList<InstallDecision> DecisionLog { get; set; }
+
 		/// <summary>
 		/// Executes the script.
 		/// </summary>
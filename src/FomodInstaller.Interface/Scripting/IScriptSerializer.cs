@@ -0,0 +1,34 @@
+﻿using System.IO;
+
+namespace FomodInstaller.Scripting
+{
+	/// <summary>
+	/// Describes a script type that can store parsed scripts in a binary form.
+	/// </summary>
+	/// <remarks>
+	/// Loading the binary form skips parsing and validating the script source, which is
+	/// what the on-disk part of the <see cref="ScriptCache"/> uses it for.
+	/// </remarks>
+	public interface IScriptSerializer
+	{
+		/// <summary>
+		/// Gets the version of the binary format; data written with a different version is ignored.
+		/// </summary>
+		/// <value>The version of the binary format.</value>
+		int SerializationVersion { get; }
+
+		/// <summary>
+		/// Writes the given script in binary form.
+		/// </summary>
+		/// <param name="p_scpScript">The <see cref="IScript"/> to write.</param>
+		/// <param name="p_stmOutput">The stream to write to.</param>
+		void SerializeScript(IScript p_scpScript, Stream p_stmOutput);
+
+		/// <summary>
+		/// Reads a script written by <see cref="SerializeScript"/>.
+		/// </summary>
+		/// <param name="p_stmInput">The stream to read from.</param>
+		/// <returns>The <see cref="IScript"/> stored in the stream.</returns>
+		IScript DeserializeScript(Stream p_stmInput);
+	}
+}
\ No newline at end of file
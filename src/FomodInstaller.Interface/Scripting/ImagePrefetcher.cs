@@ -0,0 +1,324 @@
+﻿using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Threading;
+using System.Threading.Tasks;
+using Utils;
+
+namespace FomodInstaller.Scripting
+{
+    /// <summary>
+    /// A snapshot of the <see cref="ImagePrefetcher"/> counters.
+    /// </summary>
+    public record ImagePrefetchStats
+    {
+        public int Count { get; set; }
+        public long Bytes { get; set; }
+        public long Capacity { get; set; }
+        public long Hits { get; set; }
+        public long Misses { get; set; }
+        public long Evictions { get; set; }
+        public long Reads { get; set; }
+        public long Failures { get; set; }
+        public int Pending { get; set; }
+    }
+
+    /// <summary>
+    /// Reads the images of the active installer step ahead of the host.
+    /// </summary>
+    /// <remarks>
+    /// Each installer has its own prefetcher, image paths are only unique within one mod archive.
+    /// Images are keyed by the path the dialog was given for them, and are evicted
+    /// least-recently-used first once their total size exceeds <see cref="Capacity"/>.
+    /// A capacity of 0, the default, disables prefetching.
+    /// At most <see cref="MaxConcurrentReads"/> reads run at a time on the thread pool, each one
+    /// blocks a thread on the file system bridge. Starting the reads for a step drops the ones of the
+    /// previous step that haven't started yet, and <see cref="TryGet"/> never waits for a pending
+    /// read, it reports a miss and the host loads the image itself.
+    /// </remarks>
+    public sealed class ImagePrefetcher
+    {
+        private sealed class Entry
+        {
+            public string Key;
+            public byte[] Data;
+        }
+
+        private sealed class PendingRead
+        {
+            // set once the read holds a reader slot, a started read isn't dropped with its step
+            public bool Started;
+        }
+
+        /// <summary>
+        /// The number of images read at the same time.
+        /// </summary>
+        public const int MaxConcurrentReads = 4;
+
+        private static long s_DefaultCapacity;
+
+        /// <summary>
+        /// Gets or sets the capacity of the prefetchers created without one, in bytes.
+        /// </summary>
+        /// <remarks>
+        /// Existing prefetchers apply a new value when they start the reads of the next step.
+        /// </remarks>
+        public static long DefaultCapacity
+        {
+            get => Interlocked.Read(ref s_DefaultCapacity);
+            set => Interlocked.Exchange(ref s_DefaultCapacity, Math.Max(0, value));
+        }
+
+        private readonly object m_Lock = new object();
+        private readonly Dictionary<string, LinkedListNode<Entry>> m_Entries = new Dictionary<string, LinkedListNode<Entry>>(StringComparer.OrdinalIgnoreCase);
+        // a read only stores its image while it is still the pending read of its key
+        private readonly Dictionary<string, PendingRead> m_Pending = new Dictionary<string, PendingRead>(StringComparer.OrdinalIgnoreCase);
+        private readonly LinkedList<Entry> m_Lru = new LinkedList<Entry>();
+        private readonly SemaphoreSlim m_Readers = new SemaphoreSlim(MaxConcurrentReads);
+        private CancellationTokenSource m_Step = new CancellationTokenSource();
+        // null follows DefaultCapacity
+        private long? m_Capacity;
+        private long m_Bytes;
+        private long m_Hits;
+        private long m_Misses;
+        private long m_Evictions;
+        private long m_Reads;
+        private long m_Failures;
+
+        /// <summary>
+        /// Creates a prefetcher following <see cref="DefaultCapacity"/>.
+        /// </summary>
+        public ImagePrefetcher()
+        {
+        }
+
+        /// <summary>
+        /// Creates a prefetcher with a fixed capacity.
+        /// </summary>
+        /// <param name="capacity">The maximum total size, in bytes, of the cached images.</param>
+        public ImagePrefetcher(long capacity)
+        {
+            m_Capacity = Math.Max(0, capacity);
+        }
+
+        /// <summary>
+        /// Gets or sets the maximum total size, in bytes, of the cached images.
+        /// </summary>
+        public long Capacity
+        {
+            get
+            {
+                lock (m_Lock)
+                    return CurrentCapacity;
+            }
+            set
+            {
+                lock (m_Lock)
+                {
+                    m_Capacity = Math.Max(0, value);
+                    Trim();
+                }
+            }
+        }
+
+        /// <summary>
+        /// Starts reading the given images in the background, cancelling the reads of the previous call.
+        /// </summary>
+        /// <param name="basePath">The directory the image paths are relative to.</param>
+        /// <param name="paths">The image paths, as passed to the dialog.</param>
+        public void Prefetch(string basePath, IEnumerable<string> paths)
+        {
+            CancellationToken token;
+            List<(string Key, string Path, PendingRead Read)> missing = new List<(string Key, string Path, PendingRead Read)>();
+            lock (m_Lock)
+            {
+                CancelStep(false);
+                Trim();
+                if (CurrentCapacity <= 0)
+                    return;
+
+                token = m_Step.Token;
+                foreach (string path in paths)
+                {
+                    if (string.IsNullOrEmpty(path))
+                        continue;
+                    // an image shared with the previous step, like the banner, may still be read for it
+                    string key = NormalizeKey(path);
+                    if (m_Entries.ContainsKey(key) || m_Pending.ContainsKey(key))
+                        continue;
+                    PendingRead read = new PendingRead();
+                    m_Pending.Add(key, read);
+                    missing.Add((key, path, read));
+                }
+            }
+
+            // the caller is the installer thread, even the first read must not run on it
+            foreach ((string key, string path, PendingRead read) in missing)
+                Task.Run(() => ReadAsync(key, Path.Combine(basePath ?? string.Empty, path), read, token));
+        }
+
+        /// <summary>
+        /// Returns the cached content of the image, <c>null</c> if it isn't cached (yet).
+        /// </summary>
+        /// <param name="path">The image path, as passed to the dialog.</param>
+        public byte[] TryGet(string path)
+        {
+            if (string.IsNullOrEmpty(path))
+                return null;
+
+            string key = NormalizeKey(path);
+            lock (m_Lock)
+            {
+                if (m_Entries.TryGetValue(key, out LinkedListNode<Entry> node))
+                {
+                    m_Lru.Remove(node);
+                    m_Lru.AddFirst(node);
+                    ++m_Hits;
+                    return node.Value.Data;
+                }
+                ++m_Misses;
+                return null;
+            }
+        }
+
+        /// <summary>
+        /// Removes all images from the cache and drops pending reads.
+        /// </summary>
+        public void Clear()
+        {
+            lock (m_Lock)
+            {
+                // reads finishing after this belong to the discarded content
+                CancelStep(true);
+                m_Entries.Clear();
+                m_Lru.Clear();
+                m_Bytes = 0;
+            }
+        }
+
+        /// <summary>
+        /// Gets a snapshot of the prefetcher counters.
+        /// </summary>
+        public ImagePrefetchStats GetStats()
+        {
+            lock (m_Lock)
+            {
+                return new ImagePrefetchStats
+                {
+                    Count = m_Entries.Count,
+                    Bytes = m_Bytes,
+                    Capacity = CurrentCapacity,
+                    Hits = m_Hits,
+                    Misses = m_Misses,
+                    Evictions = m_Evictions,
+                    Reads = m_Reads,
+                    Failures = m_Failures,
+                    Pending = m_Pending.Count,
+                };
+            }
+        }
+
+        /// <summary>
+        /// Cancels the reads of the current step. Their keys are dropped right away, so the next step
+        /// starts its own read for an image they share.
+        /// </summary>
+        /// <param name="started">Whether reads already running are dropped too.</param>
+        private void CancelStep(bool started)
+        {
+            m_Step.Cancel();
+            m_Step = new CancellationTokenSource();
+            List<string> dropped = new List<string>();
+            foreach (KeyValuePair<string, PendingRead> pending in m_Pending)
+            {
+                if (started || !pending.Value.Started)
+                    dropped.Add(pending.Key);
+            }
+            foreach (string key in dropped)
+                m_Pending.Remove(key);
+        }
+
+        private bool IsPending(string key, PendingRead read)
+        {
+            return m_Pending.TryGetValue(key, out PendingRead pending) && (pending == read);
+        }
+
+        private async Task ReadAsync(string key, string filePath, PendingRead read, CancellationToken token)
+        {
+            try
+            {
+                await m_Readers.WaitAsync(token).ConfigureAwait(false);
+            }
+            catch (OperationCanceledException)
+            {
+                return;
+            }
+
+            try
+            {
+                lock (m_Lock)
+                {
+                    if (token.IsCancellationRequested || !IsPending(key, read))
+                        return;
+                    read.Started = true;
+                }
+                Read(key, filePath, read);
+            }
+            finally
+            {
+                m_Readers.Release();
+            }
+        }
+
+        private void Read(string key, string filePath, PendingRead read)
+        {
+            byte[] data = null;
+            try
+            {
+                data = FileSystem.ReadAllBytes(filePath);
+            }
+            catch (Exception)
+            {
+                // a missing or unreadable image is left to the host
+            }
+
+            lock (m_Lock)
+            {
+                bool pending = IsPending(key, read);
+                if (pending)
+                    m_Pending.Remove(key);
+                if (data == null)
+                {
+                    ++m_Failures;
+                    return;
+                }
+
+                ++m_Reads;
+                if (!pending || (data.Length > CurrentCapacity) || m_Entries.ContainsKey(key))
+                    return;
+                m_Entries[key] = m_Lru.AddFirst(new Entry { Key = key, Data = data });
+                m_Bytes += data.Length;
+                Trim();
+            }
+        }
+
+        private long CurrentCapacity => m_Capacity ?? DefaultCapacity;
+
+        private void Trim()
+        {
+            long capacity = CurrentCapacity;
+            while ((m_Bytes > capacity) && (m_Lru.Count > 0))
+            {
+                Entry entry = m_Lru.Last.Value;
+                m_Lru.RemoveLast();
+                m_Entries.Remove(entry.Key);
+                m_Bytes -= entry.Data.Length;
+                ++m_Evictions;
+            }
+        }
+
+        private static string NormalizeKey(string path)
+        {
+            return path.Replace('/', '\\').TrimStart('\\');
+        }
+    }
+}
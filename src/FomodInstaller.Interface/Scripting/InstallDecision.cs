@@ -0,0 +1,18 @@
+﻿using System.Collections.Generic;
+
+namespace FomodInstaller.Scripting
+{
+    /// <summary>
+    /// The options a headless install selected in one group of a step.
+    /// </summary>
+    public record InstallDecision
+    {
+        public string Step { get; set; }
+        public string Group { get; set; }
+        public List<string> Selected { get; set; }
+        /// <summary>
+        /// Whether the selection came from the preset rather than the script's defaults
+        /// </summary>
+        public bool FromPreset { get; set; }
+    }
+}
@@ -0,0 +1,336 @@
+﻿using System;
+using System.Collections.Generic;
+using System.IO;
+using System.IO.MemoryMappedFiles;
+using System.Security.Cryptography;
+using System.Text;
+using Utils;
+
+namespace FomodInstaller.Scripting
+{
+    /// <summary>
+    /// A snapshot of the <see cref="ScriptCache"/> counters.
+    /// </summary>
+    public record ScriptCacheStats
+    {
+        public int Count { get; set; }
+        public long Bytes { get; set; }
+        public long Capacity { get; set; }
+        public long Hits { get; set; }
+        public long Misses { get; set; }
+        public long Evictions { get; set; }
+        public long DiskHits { get; set; }
+        public long DiskWrites { get; set; }
+    }
+
+    /// <summary>
+    /// An in-process cache of parsed install scripts.
+    /// </summary>
+    /// <remarks>
+    /// Entries are keyed by script type, archive-relative script path and a SHA-256 of the script
+    /// content, and are evicted least-recently-used first once the size of the cached script sources
+    /// exceeds <see cref="Capacity"/>. Cached scripts are shared between installs, so executors
+    /// must not modify them.
+    /// If <see cref="CacheDirectory"/> is set, scripts of types implementing <see cref="IScriptSerializer"/>
+    /// are also stored there in binary form, keyed by content only, so later processes can skip
+    /// parsing and validation. Failing to read or write that directory is never an error.
+    /// </remarks>
+    public sealed class ScriptCache
+    {
+        private sealed class Entry
+        {
+            public string Key;
+            public IScript Script;
+            public bool Validated;
+            public long Size;
+        }
+
+        public const long DefaultCapacity = 64 * 1024 * 1024;
+
+        // "FMSC", followed by the layout version of the file header
+        private const int DiskMagic = 0x43534d46;
+        private const int DiskLayoutVersion = 1;
+
+        /// <summary>
+        /// Gets the cache used by the installer.
+        /// </summary>
+        public static ScriptCache Shared { get; } = new ScriptCache(DefaultCapacity);
+
+        private readonly object m_Lock = new object();
+        private readonly Dictionary<string, LinkedListNode<Entry>> m_Entries = new Dictionary<string, LinkedListNode<Entry>>(StringComparer.Ordinal);
+        private readonly LinkedList<Entry> m_Lru = new LinkedList<Entry>();
+        private long m_Capacity;
+        private long m_Bytes;
+        private long m_Hits;
+        private long m_Misses;
+        private long m_Evictions;
+        private long m_DiskHits;
+        private long m_DiskWrites;
+        private string m_CacheDirectory;
+
+        public ScriptCache(long capacity)
+        {
+            m_Capacity = capacity;
+        }
+
+        /// <summary>
+        /// Gets or sets the maximum total size, in bytes of script source, of the cached scripts.
+        /// </summary>
+        public long Capacity
+        {
+            get
+            {
+                lock (m_Lock)
+                    return m_Capacity;
+            }
+            set
+            {
+                lock (m_Lock)
+                {
+                    m_Capacity = value;
+                    Trim();
+                }
+            }
+        }
+
+        /// <summary>
+        /// Gets or sets the directory used to persist parsed scripts between processes;
+        /// <c>null</c> disables the on-disk cache.
+        /// </summary>
+        public string CacheDirectory
+        {
+            get
+            {
+                lock (m_Lock)
+                    return m_CacheDirectory;
+            }
+            set
+            {
+                lock (m_Lock)
+                    m_CacheDirectory = string.IsNullOrEmpty(value) ? null : value;
+            }
+        }
+
+        /// <summary>
+        /// Returns the cached script for the given data, parsing and caching it if needed.
+        /// </summary>
+        /// <param name="scriptType">The type of the script.</param>
+        /// <param name="scriptPath">The path of the script file.</param>
+        /// <param name="scriptData">The raw content of the script file.</param>
+        /// <param name="validate">Whether the script has to be validated against its schema.</param>
+        /// <returns>The parsed script.</returns>
+        public IScript GetOrLoad(IScriptType scriptType, string scriptPath, byte[] scriptData, bool validate)
+        {
+            return GetOrLoad(scriptType, scriptPath, scriptData, validate, out _);
+        }
+
+        /// <summary>
+        /// Returns the cached script for the given data, parsing and caching it if needed.
+        /// </summary>
+        /// <param name="scriptType">The type of the script.</param>
+        /// <param name="scriptPath">The path of the script file.</param>
+        /// <param name="scriptData">The raw content of the script file.</param>
+        /// <param name="validate">Whether the script has to be validated against its schema.</param>
+        /// <param name="loaded">Set to <c>true</c> if the script wasn't cached and had to be parsed.</param>
+        /// <returns>The parsed script.</returns>
+        public IScript GetOrLoad(IScriptType scriptType, string scriptPath, byte[] scriptData, bool validate, out bool loaded)
+        {
+            string hash = ComputeHash(scriptData);
+            string key = CreateKey(scriptType, scriptPath, hash);
+            string cacheDirectory;
+
+            lock (m_Lock)
+            {
+                // a script that was parsed without validation doesn't satisfy a validating load
+                if (m_Entries.TryGetValue(key, out LinkedListNode<Entry> node) && (node.Value.Validated || !validate))
+                {
+                    m_Lru.Remove(node);
+                    m_Lru.AddFirst(node);
+                    m_Hits++;
+                    loaded = false;
+                    return node.Value.Script;
+                }
+                m_Misses++;
+                cacheDirectory = m_CacheDirectory;
+            }
+
+            // parse outside of the lock, concurrent loads of the same script are harmless
+            IScriptSerializer serializer = (cacheDirectory != null) ? scriptType as IScriptSerializer : null;
+            string diskPath = (serializer != null) ? Path.Combine(cacheDirectory, scriptType.TypeId + "-" + hash + ".bin") : null;
+            bool fromDisk = false;
+            IScript script = (diskPath != null) ? ReadFromDisk(serializer, diskPath, validate) : null;
+            if (script != null)
+                fromDisk = true;
+            else
+                script = scriptType.LoadScript(TextUtil.ByteToString(scriptData), validate);
+
+            bool written = (diskPath != null) && !fromDisk && WriteToDisk(serializer, diskPath, script, validate);
+
+            lock (m_Lock)
+            {
+                if (m_Entries.TryGetValue(key, out LinkedListNode<Entry> existing))
+                {
+                    m_Lru.Remove(existing);
+                    m_Entries.Remove(key);
+                    m_Bytes -= existing.Value.Size;
+                }
+
+                Entry entry = new Entry { Key = key, Script = script, Validated = validate, Size = scriptData.LongLength };
+                m_Entries[key] = m_Lru.AddFirst(entry);
+                m_Bytes += entry.Size;
+                if (fromDisk)
+                    m_DiskHits++;
+                if (written)
+                    m_DiskWrites++;
+                Trim();
+            }
+
+            loaded = !fromDisk;
+            return script;
+        }
+
+        /// <summary>
+        /// Removes all cached scripts and resets the counters.
+        /// </summary>
+        public void Clear()
+        {
+            lock (m_Lock)
+            {
+                m_Entries.Clear();
+                m_Lru.Clear();
+                m_Bytes = 0;
+                m_Hits = 0;
+                m_Misses = 0;
+                m_Evictions = 0;
+                m_DiskHits = 0;
+                m_DiskWrites = 0;
+            }
+        }
+
+        /// <summary>
+        /// Gets a snapshot of the cache counters.
+        /// </summary>
+        public ScriptCacheStats GetStats()
+        {
+            lock (m_Lock)
+            {
+                return new ScriptCacheStats
+                {
+                    Count = m_Entries.Count,
+                    Bytes = m_Bytes,
+                    Capacity = m_Capacity,
+                    Hits = m_Hits,
+                    Misses = m_Misses,
+                    Evictions = m_Evictions,
+                    DiskHits = m_DiskHits,
+                    DiskWrites = m_DiskWrites,
+                };
+            }
+        }
+
+        private static IScript ReadFromDisk(IScriptSerializer serializer, string path, bool validate)
+        {
+            try
+            {
+                if (!File.Exists(path))
+                    return null;
+
+                // map the file instead of reading it, the deserializer only touches each byte once
+                using (MemoryMappedFile mapped = MemoryMappedFile.CreateFromFile(path, FileMode.Open, null, 0, MemoryMappedFileAccess.Read))
+                using (MemoryMappedViewStream stream = mapped.CreateViewStream(0, 0, MemoryMappedFileAccess.Read))
+                using (BinaryReader reader = new BinaryReader(stream, Encoding.UTF8, true))
+                {
+                    if ((reader.ReadInt32() != DiskMagic)
+                        || (reader.ReadInt32() != DiskLayoutVersion)
+                        || (reader.ReadInt32() != serializer.SerializationVersion))
+                        return null;
+                    bool validated = reader.ReadBoolean();
+                    if (validate && !validated)
+                        return null;
+                    return serializer.DeserializeScript(stream);
+                }
+            }
+            catch (Exception)
+            {
+                // a stale or damaged file is just a miss, it gets rewritten after parsing
+                return null;
+            }
+        }
+
+        private static bool WriteToDisk(IScriptSerializer serializer, string path, IScript script, bool validated)
+        {
+            string tempPath = path + "." + Guid.NewGuid().ToString("N") + ".tmp";
+            try
+            {
+                Directory.CreateDirectory(Path.GetDirectoryName(path));
+                using (FileStream stream = new FileStream(tempPath, FileMode.CreateNew, FileAccess.Write))
+                using (BinaryWriter writer = new BinaryWriter(stream, Encoding.UTF8, true))
+                {
+                    writer.Write(DiskMagic);
+                    writer.Write(DiskLayoutVersion);
+                    writer.Write(serializer.SerializationVersion);
+                    writer.Write(validated);
+                    writer.Flush();
+                    serializer.SerializeScript(script, stream);
+                }
+                // readers never see a partially written or missing file
+                File.Move(tempPath, path, true);
+                return true;
+            }
+            catch (Exception)
+            {
+                try
+                {
+                    File.Delete(tempPath);
+                }
+                catch (Exception)
+                {
+                }
+                return false;
+            }
+        }
+
+        private void Trim()
+        {
+            // the most recently used entry is kept even if it's larger than the whole budget
+            while ((m_Bytes > m_Capacity) && (m_Lru.Count > 1 || m_Capacity <= 0) && (m_Lru.Last != null))
+            {
+                Entry last = m_Lru.Last.Value;
+                m_Lru.RemoveLast();
+                m_Entries.Remove(last.Key);
+                m_Bytes -= last.Size;
+                m_Evictions++;
+            }
+        }
+
+        /// <summary>
+        /// Reduces a script path to the part starting at the fomod directory, so the same script
+        /// maps to the same entry regardless of where the archive was extracted.
+        /// </summary>
+        public static string GetKeyPath(string scriptPath)
+        {
+            string normalized = TextUtil.NormalizePath(scriptPath ?? string.Empty, false, true);
+            int offset = normalized.LastIndexOf("fomod/", StringComparison.OrdinalIgnoreCase);
+            if ((offset > 0) && (normalized[offset - 1] != '/'))
+                offset = -1;
+            return offset >= 0 ? normalized.Substring(offset) : normalized;
+        }
+
+        private static string ComputeHash(byte[] scriptData)
+        {
+            byte[] hash;
+            using (SHA256 sha = SHA256.Create())
+                hash = sha.ComputeHash(scriptData);
+
+            StringBuilder hex = new StringBuilder(hash.Length * 2);
+            foreach (byte b in hash)
+                hex.Append(b.ToString("x2"));
+            return hex.ToString();
+        }
+
+        private static string CreateKey(IScriptType scriptType, string scriptPath, string hash)
+        {
+            return scriptType.TypeId + "|" + GetKeyPath(scriptPath) + "|" + hash;
+        }
+    }
+}
\ No newline at end of file
@@ -48,6 +48,18 @@ namespace FomodInstaller.Scripting
         /// <value>Whether the executor is queued.</value>
         public bool IsQueued { get; set; }
 
+        /// <summary>
+        /// Gets or sets whether the script runs without a dialog, taking the preset or the default choices.
+        /// </summary>
+        /// <value>Whether the script runs without a dialog.</value>
+        public bool Headless { get; set; }
+
+        /// <summary>
+        /// Gets or sets the list a headless run appends its choices to.
+        /// </summary>
+        /// <value>The list a headless run appends its choices to, <c>null</c> to not log them.</value>
+        public IList<InstallDecision> DecisionLog { get; set; }
+
         #endregion
 
         #region Event Raising
@@ -0,0 +1,163 @@
+﻿using System.Collections.Generic;
+using FomodInstaller.Interface;
+
+namespace FomodInstaller.Scripting.XmlScript
+{
+	/// <summary>
+	/// Memoizes step visibility and option types for one execution of a script.
+	/// </summary>
+	/// <remarks>
+	/// Each condition is compiled on first use into the set of flags it reads. Plugin and version
+	/// conditions depend on the game and the mod manager, which don't change while the installer runs,
+	/// so they are evaluated once. When a flag changes only the results that read it are dropped, so a
+	/// selection change costs as much as the conditions depending on the flags it touched.
+	/// Condition types this class doesn't know are never cached.
+	/// </remarks>
+	public class ConditionCache
+	{
+		private class Entry
+		{
+			public bool Valid;
+			public bool Fulfilled;
+			public OptionType Type;
+		}
+
+		private readonly ConditionStateManager m_csmState;
+		private readonly CoreDelegates m_Delegates;
+		private readonly Dictionary<ICondition, Entry> m_dicConditions = new Dictionary<ICondition, Entry>(ReferenceEqualityComparer.Instance);
+		private readonly Dictionary<Option, Entry> m_dicOptions = new Dictionary<Option, Entry>(ReferenceEqualityComparer.Instance);
+		private readonly Dictionary<string, List<Entry>> m_dicDependents = new Dictionary<string, List<Entry>>();
+
+		#region Constructors
+
+		/// <summary>
+		/// A simple constructor that initializes the object with the given values.
+		/// </summary>
+		/// <param name="csmState">The state the conditions are evaluated against.</param>
+		/// <param name="coreDelegates">The Core delegates component.</param>
+		public ConditionCache(ConditionStateManager csmState, CoreDelegates coreDelegates)
+		{
+			m_csmState = csmState;
+			m_Delegates = coreDelegates;
+			m_csmState.FlagChanged += InvalidateFlag;
+		}
+
+		#endregion
+
+		/// <summary>
+		/// Gets whether or not the condition is fulfilled.
+		/// </summary>
+		/// <param name="condition">The condition to evaluate.</param>
+		/// <returns><c>true</c> if the condition is fulfilled;
+		/// <c>false</c> otherwise.</returns>
+		public bool IsFulfilled(ICondition condition)
+		{
+			if (!m_dicConditions.TryGetValue(condition, out Entry entry))
+			{
+				HashSet<string> flags = new HashSet<string>();
+				entry = CollectFlags(condition, flags) ? Register(flags) : null;
+				m_dicConditions[condition] = entry;
+			}
+
+			if (entry == null)
+				return condition.GetIsFulfilled(m_csmState, m_Delegates);
+			if (!entry.Valid)
+			{
+				entry.Fulfilled = condition.GetIsFulfilled(m_csmState, m_Delegates);
+				entry.Valid = true;
+			}
+			return entry.Fulfilled;
+		}
+
+		/// <summary>
+		/// Gets the <see cref="OptionType"/> of the option.
+		/// </summary>
+		/// <param name="option">The option whose type is to be resolved.</param>
+		/// <returns>The current type of the option.</returns>
+		public OptionType ResolveOptionType(Option option)
+		{
+			if (!m_dicOptions.TryGetValue(option, out Entry entry))
+			{
+				entry = Compile(option.OptionTypeResolver);
+				m_dicOptions[option] = entry;
+			}
+
+			if (entry == null)
+				return option.GetOptionType(m_csmState, m_Delegates);
+			if (!entry.Valid)
+			{
+				entry.Type = option.GetOptionType(m_csmState, m_Delegates);
+				entry.Valid = true;
+			}
+			return entry.Type;
+		}
+
+		private Entry Compile(IOptionTypeResolver resolver)
+		{
+			if (resolver is StaticOptionTypeResolver)
+				return Register(new HashSet<string>());
+
+			if (resolver is ConditionalOptionTypeResolver conditional)
+			{
+				HashSet<string> flags = new HashSet<string>();
+				foreach (ConditionalOptionTypeResolver.ConditionalTypePattern pattern in conditional.ConditionalTypePatterns)
+				{
+					if (!CollectFlags(pattern.Condition, flags))
+						return null;
+				}
+				return Register(flags);
+			}
+
+			return null;
+		}
+
+		/// <summary>
+		/// Adds the flags the condition reads, false if it contains conditions that can't be cached.
+		/// </summary>
+		private static bool CollectFlags(ICondition condition, HashSet<string> flags)
+		{
+			switch (condition)
+			{
+				case FlagCondition flag:
+					flags.Add(flag.FlagName);
+					return true;
+				case CompositeCondition composite:
+					foreach (ICondition child in composite.Conditions)
+					{
+						if (!CollectFlags(child, flags))
+							return false;
+					}
+					return true;
+				case PluginCondition _:
+				case VersionCondition _:
+					return true;
+				default:
+					return false;
+			}
+		}
+
+		private Entry Register(HashSet<string> flags)
+		{
+			Entry entry = new Entry();
+			foreach (string flag in flags)
+			{
+				if (!m_dicDependents.TryGetValue(flag, out List<Entry> dependents))
+				{
+					dependents = new List<Entry>();
+					m_dicDependents[flag] = dependents;
+				}
+				dependents.Add(entry);
+			}
+			return entry;
+		}
+
+		private void InvalidateFlag(string flagName)
+		{
+			if (m_dicDependents.TryGetValue(flagName, out List<Entry> dependents))
+			{
+				foreach (Entry entry in dependents)
+					entry.Valid = false;
+			}
+		}
+	}
+}
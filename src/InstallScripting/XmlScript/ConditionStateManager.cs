@@ -29,6 +29,11 @@ namespace FomodInstaller.Scripting.XmlScript
 
 		private Dictionary<string, FlagValue> m_dicFlags = new Dictionary<string, FlagValue>();
 
+		/// <summary>
+		/// Raised with the flag name whenever the value of a flag changes, including when it is removed.
+		/// </summary>
+		public event Action<string> FlagChanged;
+
 		#region Properties
 
         public Version GameVersion
@@ -64,6 +69,24 @@ namespace FomodInstaller.Scripting.XmlScript
 
 		#endregion
 
+		/// <summary>
+		/// Gets the current value of a single flag.
+		/// </summary>
+		/// <param name="p_strFlagName">The name of the flag whose value is to be retrieved.</param>
+		/// <param name="p_strValue">The value of the flag, <c>null</c> if it is not set.</param>
+		/// <returns><c>true</c> if the flag is set;
+		/// <c>false</c> otherwise.</returns>
+		public bool TryGetFlagValue(string p_strFlagName, out string p_strValue)
+		{
+			if (m_dicFlags.TryGetValue(p_strFlagName, out FlagValue fvlValue))
+			{
+				p_strValue = fvlValue.Value;
+				return true;
+			}
+			p_strValue = null;
+			return false;
+		}
+
 		/// <summary>
 		/// Sets the value of a conditional flag.
 		/// </summary>
@@ -72,10 +95,16 @@ namespace FomodInstaller.Scripting.XmlScript
 		/// <param name="p_pifPlugin">The plugin that is responsible for setting the flag's value.</param>
 		public void SetFlagValue(string p_strFlagName, string p_strValue, Option p_pifPlugin)
 		{
-			if (!m_dicFlags.ContainsKey(p_strFlagName))
-				m_dicFlags[p_strFlagName] = new FlagValue();
-			m_dicFlags[p_strFlagName].Value = p_strValue;
-			m_dicFlags[p_strFlagName].Owner = p_pifPlugin;
+			if (!m_dicFlags.TryGetValue(p_strFlagName, out FlagValue fvlValue))
+			{
+				fvlValue = new FlagValue();
+				m_dicFlags[p_strFlagName] = fvlValue;
+			}
+			bool booChanged = !string.Equals(fvlValue.Value, p_strValue);
+			fvlValue.Value = p_strValue;
+			fvlValue.Owner = p_pifPlugin;
+			if (booChanged)
+				FlagChanged?.Invoke(p_strFlagName);
 		}
 
 		/// <summary>
@@ -87,7 +116,10 @@ namespace FomodInstaller.Scripting.XmlScript
 			List<string> lstFlags = new List<string>(m_dicFlags.Keys);
 			foreach (string strFlag in lstFlags)
 				if (m_dicFlags[strFlag].Owner == p_pifPlugin)
+				{
 					m_dicFlags.Remove(strFlag);
+					FlagChanged?.Invoke(strFlag);
+				}
 		}
 	}
 }
@@ -78,7 +78,7 @@ namespace FomodInstaller.Scripting.XmlScript
 		{
 			string strValue = null;
 
-            csmState.FlagValues.TryGetValue(FlagName, out strValue);
+            csmState.TryGetFlagValue(FlagName, out strValue);
 			if (string.IsNullOrEmpty(Value))
 				return string.IsNullOrEmpty(strValue);
 			return Value.Equals(strValue);
@@ -152,6 +152,30 @@ namespace FomodInstaller.Scripting.XmlScript
 			}
 		}
 
+		/// <summary>
+		/// Gets the stored show-image setting, which <see cref="ShowImage"/> combines with the image path.
+		/// </summary>
+		/// <value>The stored show-image setting.</value>
+		internal bool ShowImageSetting
+		{
+			get
+			{
+				return m_booShowImage;
+			}
+		}
+
+		/// <summary>
+		/// Gets the stored show-fade setting, which <see cref="ShowFade"/> combines with the show-image setting.
+		/// </summary>
+		/// <value>The stored show-fade setting.</value>
+		internal bool ShowFadeSetting
+		{
+			get
+			{
+				return m_booShowFade;
+			}
+		}
+
 		#endregion
 
 		#region Constructors
@@ -12,6 +12,18 @@ namespace FomodInstaller.Scripting.XmlScript
     #region Constructors
     private string m_strExtender;
 
+    /// <summary>
+    /// Gets the identifier of the script extender.
+    /// </summary>
+    /// <value>The identifier of the script extender.</value>
+    public string Extender
+    {
+      get
+      {
+        return m_strExtender;
+      }
+    }
+
     /// <summary>
     /// A simple constructor that initializes the object with the given values.
     /// </summary>
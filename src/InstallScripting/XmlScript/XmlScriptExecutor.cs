@@ -41,9 +41,14 @@ namespace FomodInstaller.Scripting.XmlScript
         private Mod ModArchive = null;
         private CoreDelegates m_Delegates;
         private ConditionStateManager m_csmState;
+        private ConditionCache m_Conditions;
         private ISet<Option> m_SelectedOptions;
         private OptionsPreset? m_Preset;
         private bool m_Preselect;
+        // Per-execution overrides, so the (possibly cached and shared) script itself is never modified
+        private Dictionary<OptionGroup, OptionGroupType> m_GroupTypes;
+        private Dictionary<Option, OptionType> m_OptionTypes;
+        private string m_BannerPath;
 
         #region Constructors
 
@@ -79,6 +84,9 @@ namespace FomodInstaller.Scripting.XmlScript
             List<InstallableFile> PluginsToActivate = new List<InstallableFile>();
 
             m_csmState = new ConditionStateManager();
+            m_Conditions = new ConditionCache(m_csmState, m_Delegates);
+            m_GroupTypes = new Dictionary<OptionGroup, OptionGroupType>();
+            m_OptionTypes = new Dictionary<Option, OptionType>();
 
             if (preset is OptionsPreset preConverted)
             {
@@ -118,9 +126,10 @@ namespace FomodInstaller.Scripting.XmlScript
             IList<InstallStep> lstSteps = xscScript.InstallSteps;
             fixSteps(lstSteps);
 
-            // If a preset is provided and we're not in preselect mode, run headless and avoid all UI IPC.
+            // If a preset is provided and we're not in preselect mode, or the caller asked for it, run headless
+            // and avoid all UI IPC. Without a preset headless runs take the recommended/default choices.
             // In preselect mode the preset is used to pre-select options but the dialog is still shown.
-            if (m_Preset.HasValue && !m_Preselect)
+            if (Headless || (m_Preset.HasValue && !m_Preselect))
             {
                 // Preselect options for every step according to the preset (or recommended/default rules).
                 // Skip invisible steps just like manual mode does - this ensures we don't select options
@@ -128,7 +137,7 @@ namespace FomodInstaller.Scripting.XmlScript
                 foreach (var step in lstSteps)
                 {
                     if (step.VisibilityCondition != null &&
-                        !step.VisibilityCondition.GetIsFulfilled(m_csmState, m_Delegates))
+                        !m_Conditions.IsFulfilled(step.VisibilityCondition))
                     {
                         continue;
                     }
@@ -136,6 +145,7 @@ namespace FomodInstaller.Scripting.XmlScript
                     preselectOptions(step);
                     // Ensure required/not-usable flags are applied after preselection.
                     fixSelected(step);
+                    logDecisions(step);
                 }
 
                 var instructions = collectInstructions(lstSteps, xscScript, PluginsToActivate);
@@ -144,10 +154,12 @@ namespace FomodInstaller.Scripting.XmlScript
             }
 
             HeaderInfo hifHeaderInfo = xscScript.HeaderInfo;
-            if (string.IsNullOrEmpty(hifHeaderInfo.ImagePath))
-                hifHeaderInfo.ImagePath = string.IsNullOrEmpty(ModArchive.ScreenshotPath) ? null : Path.Combine(ModArchive.Prefix, ModArchive.ScreenshotPath);
-            if ((hifHeaderInfo.Height < 0) && hifHeaderInfo.ShowImage)
-                hifHeaderInfo.Height = 75;
+            string headerImagePath = hifHeaderInfo.ImagePath;
+            if (string.IsNullOrEmpty(headerImagePath))
+                headerImagePath = string.IsNullOrEmpty(ModArchive.ScreenshotPath) ? null : Path.Combine(ModArchive.Prefix, ModArchive.ScreenshotPath);
+            int headerHeight = hifHeaderInfo.Height;
+            if ((headerHeight < 0) && hifHeaderInfo.ShowImage)
+                headerHeight = 75;
 
             int stepIdx = findNextIdx(lstSteps, -1);
 
@@ -190,11 +202,13 @@ namespace FomodInstaller.Scripting.XmlScript
                 Source.SetCanceled();
             };
 
-            string bannerPath = string.IsNullOrEmpty(hifHeaderInfo.ImagePath)
+            // a reused installer still holds the images of its previous mod
+            m_Delegates.imagePrefetcher?.Clear();
+            m_BannerPath = string.IsNullOrEmpty(headerImagePath)
                 ? null
-                : Path.Combine(ModArchive.Prefix, hifHeaderInfo.ImagePath);
+                : Path.Combine(ModArchive.Prefix, headerImagePath);
             m_Delegates.ui.StartDialog(hifHeaderInfo.Title,
-                new HeaderImage(bannerPath, hifHeaderInfo.ShowFade, hifHeaderInfo.Height),
+                new HeaderImage(m_BannerPath, hifHeaderInfo.ShowFade, headerHeight),
                 select, cont, cancel);
 
             processStep(lstSteps, stepIdx, Source, xscScript, PluginsToActivate);
@@ -214,11 +228,28 @@ namespace FomodInstaller.Scripting.XmlScript
             }
             else
             {
+                prefetchImages(lstSteps[stepIdx]);
                 preselectOptions(lstSteps[stepIdx]);
                 sendState(lstSteps, ModArchive.Prefix, stepIdx);
             }
         }
 
+        /// <summary>
+        /// Starts reading the banner and the option images of the step before the host asks for them.
+        /// </summary>
+        /// <param name="step">The step that is about to be shown.</param>
+        private void prefetchImages(InstallStep step)
+        {
+            // the paths have to match the ones sendState passes to the dialog
+            IEnumerable<string> images = step.OptionGroups
+                .SelectMany(group => group.Options)
+                .Where(option => !string.IsNullOrEmpty(option.ImagePath))
+                .Select(option => Path.Combine(ModArchive.Prefix, option.ImagePath));
+            if (m_BannerPath != null)
+                images = images.Prepend(m_BannerPath);
+            m_Delegates.imagePrefetcher?.Prefetch(ModArchive.TempPath, images);
+        }
+
         private IList<Instruction> collectInstructions(IList<InstallStep> lstSteps, XmlScript xscScript, List<InstallableFile> PluginsToActivate)
         {
             XmlScriptInstaller xsiInstaller = new XmlScriptInstaller(ModArchive);
@@ -236,7 +267,7 @@ namespace FomodInstaller.Scripting.XmlScript
                         else
                         {
                             IEnumerable<InstallableFile> installAnyway = option.Files.Where(file => file.AlwaysInstall ||
-                                                                                                    (file.InstallIfUsable && option.GetOptionType(m_csmState, m_Delegates) !=
+                                                                                                    (file.InstallIfUsable && resolveOptionType(option) !=
                                                                                                         OptionType.NotUsable));
                             if (installAnyway.Any())
                             {
@@ -268,7 +299,14 @@ namespace FomodInstaller.Scripting.XmlScript
 
         private OptionType resolveOptionType(Option opt)
         {
-            return opt.GetOptionType(m_csmState, m_Delegates);
+            if (m_OptionTypes.TryGetValue(opt, out OptionType forced))
+                return forced;
+            return m_Conditions.ResolveOptionType(opt);
+        }
+
+        private OptionGroupType resolveGroupType(OptionGroup group)
+        {
+            return m_GroupTypes.TryGetValue(group, out OptionGroupType fixedType) ? fixedType : group.Type;
         }
 
 
@@ -294,7 +332,8 @@ namespace FomodInstaller.Scripting.XmlScript
 
                 if (group.Options.FirstOrDefault(opt => m_SelectedOptions.Contains(opt)) == null)
                 {
-                    bool setFirst = group.Type == OptionGroupType.SelectExactlyOne;
+                    OptionGroupType groupType = resolveGroupType(group);
+                    bool setFirst = groupType == OptionGroupType.SelectExactlyOne;
                     foreach (Option option in group.Options)
                     {
                         OptionType type = resolveOptionType(option);
@@ -310,12 +349,12 @@ namespace FomodInstaller.Scripting.XmlScript
                         {
                             // force preset options to be selectable, otherwise the user might not be able to deselect it
                             // even if it is actually invalid
-                            option.OptionTypeResolver = new StaticOptionTypeResolver(OptionType.CouldBeUsable);
+                            m_OptionTypes[option] = OptionType.CouldBeUsable;
                             type = OptionType.CouldBeUsable;
                         }
                         if ((type == OptionType.Required)
                             || (!m_Preset.HasValue && (type == OptionType.Recommended))
-                            || (group.Type == OptionGroupType.SelectAll)
+                            || (groupType == OptionGroupType.SelectAll)
                             || isPreset)
                         {
                             // in case there are multiple recommended options in a group that only
@@ -323,8 +362,8 @@ namespace FomodInstaller.Scripting.XmlScript
                             // create an invalid pre-selection
                             if (!m_Preset.HasValue
                                 && (type == OptionType.Recommended)
-                                && ((group.Type == OptionGroupType.SelectExactlyOne)
-                                    || (group.Type == OptionGroupType.SelectAtMostOne)))
+                                && ((groupType == OptionGroupType.SelectExactlyOne)
+                                    || (groupType == OptionGroupType.SelectAtMostOne)))
                             {
                                 foreach (Option innerOption in group.Options)
                                 {
@@ -353,6 +392,27 @@ namespace FomodInstaller.Scripting.XmlScript
             }
         }
 
+        private void logDecisions(InstallStep step)
+        {
+            if (DecisionLog == null)
+                return;
+
+            OptionsPresetStep[] stepPresets = m_Preset.HasValue && (m_Preset.Value.steps != null)
+                ? m_Preset.Value.steps.Where(preStep => preStep.name == step.Name).ToArray()
+                : new OptionsPresetStep[0];
+
+            foreach (OptionGroup group in step.OptionGroups)
+            {
+                DecisionLog.Add(new InstallDecision
+                {
+                    Step = step.Name,
+                    Group = group.Name,
+                    Selected = group.Options.Where(option => m_SelectedOptions.Contains(option)).Select(option => option.Name).ToList(),
+                    FromPreset = stepPresets.Any(preStep => (preStep.groups != null) && preStep.groups.Any(preGroup => preGroup.name == group.Name)),
+                });
+            }
+        }
+
         private void fixSteps(IList<InstallStep> steps)
         {
             // fix incompatible step options
@@ -364,11 +424,11 @@ namespace FomodInstaller.Scripting.XmlScript
                     if ((requiredCount > 1) && (group.Type == OptionGroupType.SelectAtMostOne))
                     {
                         // multiple required but there should only be 0-1 selected.
-                        group.Type = OptionGroupType.SelectAny;
+                        m_GroupTypes[group] = OptionGroupType.SelectAny;
                     } else if ((requiredCount > 1) && (group.Type == OptionGroupType.SelectExactlyOne))
                     {
                         // multiple required but there should be exactly one selected.
-                        group.Type = OptionGroupType.SelectAtLeastOne;
+                        m_GroupTypes[group] = OptionGroupType.SelectAtLeastOne;
                     }
                 }
             }
@@ -395,7 +455,7 @@ namespace FomodInstaller.Scripting.XmlScript
             {
                 int idx = 0;
                 return steps.Select(step => new InstallerStep(idx++, step.Name,
-                    step.VisibilityCondition == null || step.VisibilityCondition.GetIsFulfilled(m_csmState, m_Delegates)));
+                    step.VisibilityCondition == null || m_Conditions.IsFulfilled(step.VisibilityCondition)));
             };
 
             Func<IEnumerable<Option>, OptionsPresetGroup?, bool, IEnumerable<Interface.ui.Option>> convertOptions = (options, groupPreset, selectAll) =>
@@ -433,8 +493,9 @@ namespace FomodInstaller.Scripting.XmlScript
                         groupPreset = stepPreset.Value.groups.FirstOrDefault(preGroup => preGroup.name == group.Name);
                     }
 
-                    return new Group(idx++, group.Name, group.Type.ToString(),
-                                     convertOptions(group.Options, groupPreset, group.Type == OptionGroupType.SelectAll).ToArray());
+                    OptionGroupType groupType = resolveGroupType(group);
+                    return new Group(idx++, group.Name, groupType.ToString(),
+                                     convertOptions(group.Options, groupPreset, groupType == OptionGroupType.SelectAll).ToArray());
                 });
             };
 
@@ -465,7 +526,7 @@ namespace FomodInstaller.Scripting.XmlScript
         {
             for (int i = currentIdx + 1; i < lstSteps.Count; ++i) {
                 if ((lstSteps[i].VisibilityCondition == null) ||
-                    lstSteps[i].VisibilityCondition.GetIsFulfilled(m_csmState, m_Delegates))
+                    m_Conditions.IsFulfilled(lstSteps[i].VisibilityCondition))
                 {
                     return i;
                 }
@@ -477,7 +538,7 @@ namespace FomodInstaller.Scripting.XmlScript
         {
             for (int i = currentIdx - 1; i >= 0; --i) {
                 if ((lstSteps[i].VisibilityCondition == null) ||
-                    lstSteps[i].VisibilityCondition.GetIsFulfilled(m_csmState, m_Delegates))
+                    m_Conditions.IsFulfilled(lstSteps[i].VisibilityCondition))
                 {
                     return i;
                 }
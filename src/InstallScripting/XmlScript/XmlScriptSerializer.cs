@@ -0,0 +1,408 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Drawing;
+using System.IO;
+using System.Text;
+
+namespace FomodInstaller.Scripting.XmlScript
+{
+	/// <summary>
+	/// Reads and writes the binary form of a parsed <see cref="XmlScript"/>.
+	/// </summary>
+	/// <remarks>
+	/// The format is a flat pre-order walk of the script model. Strings are written once and
+	/// referenced by index afterwards, since install scripts repeat the same paths and flag names
+	/// many times. Bump <see cref="FormatVersion"/> whenever the layout changes.
+	/// </remarks>
+	public static class XmlScriptSerializer
+	{
+		public const int FormatVersion = 1;
+
+		private const byte ConditionNone = 0;
+		private const byte ConditionComposite = 1;
+		private const byte ConditionFlag = 2;
+		private const byte ConditionPlugin = 3;
+		private const byte ConditionGameVersion = 4;
+		private const byte ConditionModManager = 5;
+		private const byte ConditionSEVersion = 6;
+
+		private const byte ResolverStatic = 0;
+		private const byte ResolverConditional = 1;
+
+		#region Writing
+
+		private sealed class Writer
+		{
+			private readonly BinaryWriter m_bwrWriter;
+			private readonly Dictionary<string, int> m_dicStrings = new Dictionary<string, int>(StringComparer.Ordinal);
+
+			public Writer(BinaryWriter p_bwrWriter)
+			{
+				m_bwrWriter = p_bwrWriter;
+			}
+
+			public void Write(XmlScript p_xscScript)
+			{
+				WriteVersion(p_xscScript.Version);
+				WriteHeader(p_xscScript.HeaderInfo);
+				WriteCondition(p_xscScript.ModPrerequisites);
+				WriteFiles(p_xscScript.RequiredInstallFiles);
+				m_bwrWriter.Write((byte)p_xscScript.InstallStepSortOrder);
+				m_bwrWriter.Write(p_xscScript.InstallSteps.Count);
+				foreach (InstallStep stpStep in p_xscScript.InstallSteps)
+					WriteStep(stpStep);
+				m_bwrWriter.Write(p_xscScript.ConditionallyInstalledFileSets.Count);
+				foreach (ConditionallyInstalledFileSet cisFileSet in p_xscScript.ConditionallyInstalledFileSets)
+				{
+					WriteCondition(cisFileSet.Condition);
+					WriteFiles(cisFileSet.Files);
+				}
+			}
+
+			private void WriteString(string p_strValue)
+			{
+				if (p_strValue == null)
+				{
+					m_bwrWriter.Write(-1);
+					return;
+				}
+				if (m_dicStrings.TryGetValue(p_strValue, out int intIndex))
+				{
+					m_bwrWriter.Write(intIndex);
+					return;
+				}
+				intIndex = m_dicStrings.Count;
+				m_dicStrings[p_strValue] = intIndex;
+				m_bwrWriter.Write(intIndex);
+				m_bwrWriter.Write(p_strValue);
+			}
+
+			private void WriteVersion(Version p_verVersion)
+			{
+				WriteString(p_verVersion?.ToString());
+			}
+
+			private void WriteHeader(HeaderInfo p_hifHeader)
+			{
+				m_bwrWriter.Write(p_hifHeader != null);
+				if (p_hifHeader == null)
+					return;
+				WriteString(p_hifHeader.Title);
+				m_bwrWriter.Write(p_hifHeader.TextColour.ToArgb());
+				m_bwrWriter.Write((byte)p_hifHeader.TextPosition);
+				WriteString(p_hifHeader.ImagePath);
+				m_bwrWriter.Write(p_hifHeader.ShowImageSetting);
+				m_bwrWriter.Write(p_hifHeader.ShowFadeSetting);
+				m_bwrWriter.Write(p_hifHeader.Height);
+			}
+
+			private void WriteCondition(ICondition p_cndCondition)
+			{
+				switch (p_cndCondition)
+				{
+					case null:
+						m_bwrWriter.Write(ConditionNone);
+						break;
+					case CompositeCondition cpcCondition:
+						m_bwrWriter.Write(ConditionComposite);
+						m_bwrWriter.Write((byte)cpcCondition.Operator);
+						m_bwrWriter.Write(cpcCondition.Conditions.Count);
+						foreach (ICondition cndChild in cpcCondition.Conditions)
+							WriteCondition(cndChild);
+						break;
+					case FlagCondition flcCondition:
+						m_bwrWriter.Write(ConditionFlag);
+						WriteString(flcCondition.FlagName);
+						WriteString(flcCondition.Value);
+						break;
+					case PluginCondition pncCondition:
+						m_bwrWriter.Write(ConditionPlugin);
+						WriteString(pncCondition.PluginPath);
+						m_bwrWriter.Write((byte)pncCondition.State);
+						break;
+					case GameVersionCondition gvcCondition:
+						m_bwrWriter.Write(ConditionGameVersion);
+						WriteVersion(gvcCondition.MinimumVersion);
+						break;
+					case ModManagerCondition mmcCondition:
+						m_bwrWriter.Write(ConditionModManager);
+						WriteVersion(mmcCondition.MinimumVersion);
+						break;
+					case SEVersionCondition svcCondition:
+						m_bwrWriter.Write(ConditionSEVersion);
+						WriteVersion(svcCondition.MinimumVersion);
+						WriteString(svcCondition.Extender);
+						break;
+					default:
+						throw new NotSupportedException("Unsupported condition type " + p_cndCondition.GetType().Name);
+				}
+			}
+
+			private void WriteFiles(IList<InstallableFile> p_lstFiles)
+			{
+				m_bwrWriter.Write(p_lstFiles.Count);
+				foreach (InstallableFile iflFile in p_lstFiles)
+				{
+					WriteString(iflFile.Source);
+					WriteString(iflFile.Destination);
+					m_bwrWriter.Write(iflFile.IsFolder);
+					m_bwrWriter.Write(iflFile.Priority);
+					m_bwrWriter.Write(iflFile.AlwaysInstall);
+					m_bwrWriter.Write(iflFile.InstallIfUsable);
+				}
+			}
+
+			private void WriteStep(InstallStep p_stpStep)
+			{
+				WriteString(p_stpStep.Name);
+				WriteCondition(p_stpStep.VisibilityCondition);
+				m_bwrWriter.Write((byte)p_stpStep.GroupSortOrder);
+				m_bwrWriter.Write(p_stpStep.OptionGroups.Count);
+				foreach (OptionGroup grpGroup in p_stpStep.OptionGroups)
+				{
+					WriteString(grpGroup.Name);
+					m_bwrWriter.Write((byte)grpGroup.Type);
+					m_bwrWriter.Write((byte)grpGroup.OptionSortOrder);
+					m_bwrWriter.Write(grpGroup.Options.Count);
+					foreach (Option optOption in grpGroup.Options)
+						WriteOption(optOption);
+				}
+			}
+
+			private void WriteOption(Option p_optOption)
+			{
+				WriteString(p_optOption.Name);
+				WriteString(p_optOption.Description);
+				WriteString(p_optOption.ImagePath);
+				switch (p_optOption.OptionTypeResolver)
+				{
+					case StaticOptionTypeResolver sorResolver:
+						m_bwrWriter.Write(ResolverStatic);
+						m_bwrWriter.Write((byte)sorResolver.Type);
+						break;
+					case ConditionalOptionTypeResolver corResolver:
+						m_bwrWriter.Write(ResolverConditional);
+						m_bwrWriter.Write((byte)corResolver.DefaultType);
+						m_bwrWriter.Write(corResolver.ConditionalTypePatterns.Count);
+						foreach (ConditionalOptionTypeResolver.ConditionalTypePattern ctpPattern in corResolver.ConditionalTypePatterns)
+						{
+							m_bwrWriter.Write((byte)ctpPattern.Type);
+							WriteCondition(ctpPattern.Condition);
+						}
+						break;
+					default:
+						throw new NotSupportedException("Unsupported option type resolver " + p_optOption.OptionTypeResolver.GetType().Name);
+				}
+				WriteFiles(p_optOption.Files);
+				m_bwrWriter.Write(p_optOption.Flags.Count);
+				foreach (ConditionalFlag cflFlag in p_optOption.Flags)
+				{
+					WriteString(cflFlag.Name);
+					WriteString(cflFlag.ConditionalValue);
+				}
+			}
+		}
+
+		#endregion
+
+		#region Reading
+
+		private sealed class Reader
+		{
+			private readonly BinaryReader m_brdReader;
+			private readonly List<string> m_lstStrings = new List<string>();
+
+			public Reader(BinaryReader p_brdReader)
+			{
+				m_brdReader = p_brdReader;
+			}
+
+			public XmlScript Read(XmlScriptType p_xstType)
+			{
+				Version verVersion = ReadVersion();
+				HeaderInfo hifHeader = ReadHeader();
+				ICondition cndPrerequisites = ReadCondition();
+				List<InstallableFile> lstRequiredFiles = ReadFiles();
+				SortOrder srtStepOrder = (SortOrder)m_brdReader.ReadByte();
+				int intStepCount = m_brdReader.ReadInt32();
+				List<InstallStep> lstSteps = new List<InstallStep>(intStepCount);
+				for (int i = 0; i < intStepCount; i++)
+					lstSteps.Add(ReadStep());
+				int intSetCount = m_brdReader.ReadInt32();
+				List<ConditionallyInstalledFileSet> lstFileSets = new List<ConditionallyInstalledFileSet>(intSetCount);
+				for (int i = 0; i < intSetCount; i++)
+				{
+					ICondition cndCondition = ReadCondition();
+					lstFileSets.Add(new ConditionallyInstalledFileSet(cndCondition, ReadFiles()));
+				}
+				return new XmlScript(p_xstType, verVersion, hifHeader, cndPrerequisites, lstRequiredFiles, lstSteps, srtStepOrder, lstFileSets);
+			}
+
+			private string ReadString()
+			{
+				int intIndex = m_brdReader.ReadInt32();
+				if (intIndex < 0)
+					return null;
+				if (intIndex < m_lstStrings.Count)
+					return m_lstStrings[intIndex];
+				if (intIndex != m_lstStrings.Count)
+					throw new InvalidDataException("Corrupt string table in serialized script.");
+				string strValue = m_brdReader.ReadString();
+				m_lstStrings.Add(strValue);
+				return strValue;
+			}
+
+			private Version ReadVersion()
+			{
+				string strVersion = ReadString();
+				return strVersion == null ? null : new Version(strVersion);
+			}
+
+			private HeaderInfo ReadHeader()
+			{
+				if (!m_brdReader.ReadBoolean())
+					return null;
+				string strTitle = ReadString();
+				Color clrColour = Color.FromArgb(m_brdReader.ReadInt32());
+				TextPosition tpsPosition = (TextPosition)m_brdReader.ReadByte();
+				string strImagePath = ReadString();
+				bool booShowImage = m_brdReader.ReadBoolean();
+				bool booShowFade = m_brdReader.ReadBoolean();
+				int intHeight = m_brdReader.ReadInt32();
+				return new HeaderInfo(strTitle, clrColour, tpsPosition, strImagePath, booShowImage, booShowFade, intHeight);
+			}
+
+			private ICondition ReadCondition()
+			{
+				byte bteKind = m_brdReader.ReadByte();
+				switch (bteKind)
+				{
+					case ConditionNone:
+						return null;
+					case ConditionComposite:
+						CompositeCondition cpcCondition = new CompositeCondition((ConditionOperator)m_brdReader.ReadByte());
+						int intCount = m_brdReader.ReadInt32();
+						for (int i = 0; i < intCount; i++)
+							cpcCondition.Conditions.Add(ReadCondition());
+						return cpcCondition;
+					case ConditionFlag:
+						string strFlagName = ReadString();
+						return new FlagCondition(strFlagName, ReadString());
+					case ConditionPlugin:
+						string strPluginPath = ReadString();
+						return new PluginCondition(strPluginPath, (PluginState)m_brdReader.ReadByte());
+					case ConditionGameVersion:
+						return new GameVersionCondition(ReadVersion());
+					case ConditionModManager:
+						return new ModManagerCondition(ReadVersion());
+					case ConditionSEVersion:
+						Version verMinimum = ReadVersion();
+						return new SEVersionCondition(verMinimum, ReadString());
+					default:
+						throw new InvalidDataException("Unknown condition kind " + bteKind + " in serialized script.");
+				}
+			}
+
+			private List<InstallableFile> ReadFiles()
+			{
+				int intCount = m_brdReader.ReadInt32();
+				List<InstallableFile> lstFiles = new List<InstallableFile>(intCount);
+				for (int i = 0; i < intCount; i++)
+				{
+					string strSource = ReadString();
+					string strDestination = ReadString();
+					bool booIsFolder = m_brdReader.ReadBoolean();
+					int intPriority = m_brdReader.ReadInt32();
+					bool booAlwaysInstall = m_brdReader.ReadBoolean();
+					bool booInstallIfUsable = m_brdReader.ReadBoolean();
+					lstFiles.Add(new InstallableFile(strSource, strDestination, booIsFolder, intPriority, booAlwaysInstall, booInstallIfUsable));
+				}
+				return lstFiles;
+			}
+
+			private InstallStep ReadStep()
+			{
+				string strName = ReadString();
+				ICondition cndVisibility = ReadCondition();
+				InstallStep stpStep = new InstallStep(strName, cndVisibility, (SortOrder)m_brdReader.ReadByte());
+				int intGroupCount = m_brdReader.ReadInt32();
+				for (int i = 0; i < intGroupCount; i++)
+				{
+					string strGroupName = ReadString();
+					OptionGroupType gtpType = (OptionGroupType)m_brdReader.ReadByte();
+					OptionGroup grpGroup = new OptionGroup(strGroupName, gtpType, (SortOrder)m_brdReader.ReadByte());
+					int intOptionCount = m_brdReader.ReadInt32();
+					for (int j = 0; j < intOptionCount; j++)
+						grpGroup.Options.Add(ReadOption());
+					stpStep.OptionGroups.Add(grpGroup);
+				}
+				return stpStep;
+			}
+
+			private Option ReadOption()
+			{
+				string strName = ReadString();
+				string strDescription = ReadString();
+				string strImagePath = ReadString();
+				IOptionTypeResolver otrResolver;
+				byte bteKind = m_brdReader.ReadByte();
+				switch (bteKind)
+				{
+					case ResolverStatic:
+						otrResolver = new StaticOptionTypeResolver((OptionType)m_brdReader.ReadByte());
+						break;
+					case ResolverConditional:
+						ConditionalOptionTypeResolver corResolver = new ConditionalOptionTypeResolver((OptionType)m_brdReader.ReadByte());
+						int intPatternCount = m_brdReader.ReadInt32();
+						for (int i = 0; i < intPatternCount; i++)
+						{
+							OptionType ptpType = (OptionType)m_brdReader.ReadByte();
+							corResolver.AddPattern(ptpType, ReadCondition());
+						}
+						otrResolver = corResolver;
+						break;
+					default:
+						throw new InvalidDataException("Unknown option type resolver " + bteKind + " in serialized script.");
+				}
+				Option optOption = new Option(strName, strDescription, strImagePath, otrResolver);
+				optOption.Files.AddRange(ReadFiles());
+				int intFlagCount = m_brdReader.ReadInt32();
+				for (int i = 0; i < intFlagCount; i++)
+				{
+					string strFlagName = ReadString();
+					optOption.Flags.Add(new ConditionalFlag(strFlagName, ReadString()));
+				}
+				return optOption;
+			}
+		}
+
+		#endregion
+
+		/// <summary>
+		/// Writes the given script to the given stream.
+		/// </summary>
+		/// <param name="p_xscScript">The script to write.</param>
+		/// <param name="p_stmOutput">The stream to write to.</param>
+		public static void Serialize(XmlScript p_xscScript, Stream p_stmOutput)
+		{
+			using (BinaryWriter bwrWriter = new BinaryWriter(p_stmOutput, Encoding.UTF8, true))
+			{
+				new Writer(bwrWriter).Write(p_xscScript);
+			}
+		}
+
+		/// <summary>
+		/// Reads a script written by <see cref="Serialize"/> from the given stream.
+		/// </summary>
+		/// <param name="p_xstType">The script type to attach to the script.</param>
+		/// <param name="p_stmInput">The stream to read from.</param>
+		/// <returns>The script stored in the stream.</returns>
+		public static XmlScript Deserialize(XmlScriptType p_xstType, Stream p_stmInput)
+		{
+			using (BinaryReader brdReader = new BinaryReader(p_stmInput, Encoding.UTF8, true))
+			{
+				return new Reader(brdReader).Read(p_xstType);
+			}
+		}
+	}
+}
\ No newline at end of file
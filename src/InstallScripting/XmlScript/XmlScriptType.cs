@@ -1,4 +1,5 @@
 ﻿using System;
+using System.Collections.Concurrent;
 using System.Collections.Generic;
 using System.IO;
 using System.Linq;
@@ -24,7 +25,7 @@ namespace FomodInstaller.Scripting.XmlScript
 	/// This is the script that allows scripting using an XML language. It is meant
 	/// to be easier to learn and more accessible than the more advanced C# script.
 	/// </remarks>
-	public class XmlScriptType : IScriptType
+	public class XmlScriptType : IScriptType, IScriptSerializer
 	{
 		private static Version[] SupportedScriptVersions = { new Version(1, 0),
 														new Version(2, 0),
@@ -32,6 +33,8 @@ namespace FomodInstaller.Scripting.XmlScript
 														new Version(4, 0),
 														new Version(5, 0) };
 		private static List<string> ListFileNames = new List<string>() { "script.xml", "ModuleConfig.xml" };
+		// each schema set is compiled once and shared; validation only reads a compiled set, so parallel installs validate concurrently
+		private static ConcurrentDictionary<string, Lazy<XmlSchemaSet>> CompiledSchemaSets = new ConcurrentDictionary<string, Lazy<XmlSchemaSet>>(StringComparer.Ordinal);
 
 		/// <summary>
 		/// Gets the list of available script versions.
@@ -117,11 +120,7 @@ namespace FomodInstaller.Scripting.XmlScript
 			using (var stream = StringStream(xmlData)) {
 				List<string> errors = new List<string>();
 
-				XmlSchema XMLSchema = GetXmlScriptSchema(GetXmlScriptVersion(xmlData));
-				XmlSchemaSet SchemaSet = new XmlSchemaSet();
-				SchemaSet.XmlResolver = new XmlSchemaResourceResolver();
-				SchemaSet.Add(XMLSchema);
-				SchemaSet.Compile();
+				XmlSchemaSet SchemaSet = GetXmlScriptSchemaSet(GetXmlScriptVersion(xmlData));
 
 				XmlReaderSettings settings = new XmlReaderSettings();
 				settings.Schemas = SchemaSet;
@@ -137,9 +136,10 @@ namespace FomodInstaller.Scripting.XmlScript
 					}
 				};
 
-				XmlReader reader = XmlReader.Create(stream, settings);
-
-				while (reader.Read()) { }
+				using (XmlReader reader = XmlReader.Create(stream, settings))
+				{
+					while (reader.Read()) { }
+				}
 
 				if (errors.Count > 0)
 				{
@@ -191,6 +191,42 @@ namespace FomodInstaller.Scripting.XmlScript
 
 		#endregion
 
+		#region IScriptSerializer Members
+
+		/// <summary>
+		/// Gets the version of the binary script format.
+		/// </summary>
+		/// <value>The version of the binary script format.</value>
+		public int SerializationVersion
+		{
+			get
+			{
+				return XmlScriptSerializer.FormatVersion;
+			}
+		}
+
+		/// <summary>
+		/// Writes the given script in binary form.
+		/// </summary>
+		/// <param name="p_scpScript">The <see cref="IScript"/> to write.</param>
+		/// <param name="p_stmOutput">The stream to write to.</param>
+		public void SerializeScript(IScript p_scpScript, Stream p_stmOutput)
+		{
+			XmlScriptSerializer.Serialize((XmlScript)p_scpScript, p_stmOutput);
+		}
+
+		/// <summary>
+		/// Reads a script written by <see cref="SerializeScript"/>.
+		/// </summary>
+		/// <param name="p_stmInput">The stream to read from.</param>
+		/// <returns>The <see cref="IScript"/> stored in the stream.</returns>
+		public IScript DeserializeScript(Stream p_stmInput)
+		{
+			return XmlScriptSerializer.Deserialize(this, p_stmInput);
+		}
+
+		#endregion
+
 		#region Properties
 
 		/// <summary>
@@ -290,17 +326,53 @@ namespace FomodInstaller.Scripting.XmlScript
 
 		#region Validation
 
+		/// <summary>
+		/// Gets the compiled schema set for the specified xml script version, compiling it on first use.
+		/// </summary>
+		/// <param name="XmlScriptVersion">The XML script file version for which to return a schema set.</param>
+		/// <returns>The compiled schema set for the specified xml script version.</returns>
+		public XmlSchemaSet GetXmlScriptSchemaSet(Version XmlScriptVersion)
+		{
+			string Key = string.Format("{0}|{1}.{2}", GetType().FullName, XmlScriptVersion.Major, XmlScriptVersion.Minor);
+			return CompiledSchemaSets.GetOrAdd(Key, (k) => new Lazy<XmlSchemaSet>(() =>
+			{
+				XmlSchemaSet SchemaSet = new XmlSchemaSet();
+				SchemaSet.XmlResolver = new XmlSchemaResourceResolver();
+				SchemaSet.Add(GetXmlScriptSchema(XmlScriptVersion));
+				SchemaSet.Compile();
+				return SchemaSet;
+			})).Value;
+		}
+
+		/// <summary>
+		/// Loads and compiles the schemas of all supported xml script versions.
+		/// </summary>
+		/// <returns>The number of schema sets that compiled and are ready for validation.</returns>
+		public int PreloadSchemas()
+		{
+			int Compiled = 0;
+			foreach (Version ScriptVersion in SupportedScriptVersions)
+			{
+				try
+				{
+					if (GetXmlScriptSchemaSet(ScriptVersion).IsCompiled)
+						++Compiled;
+				}
+				catch (Exception)
+				{
+					// the install using this version reports the error
+				}
+			}
+			return Compiled;
+		}
+
 		/// <summary>
 		/// Validates the given Xml Script against the appropriate schema.
 		/// </summary>
 		/// <param name="xmlScript">The script file.</param>
 		public void ValidateXmlScript(XElement xmlScript)
 		{
-			XmlSchema XMLSchema = GetXmlScriptSchema(GetXmlScriptVersion(xmlScript));
-			XmlSchemaSet SchemaSet = new XmlSchemaSet();
-			SchemaSet.XmlResolver = new XmlSchemaResourceResolver();
-			SchemaSet.Add(XMLSchema);
-			SchemaSet.Compile();
+			XmlSchemaSet SchemaSet = GetXmlScriptSchemaSet(GetXmlScriptVersion(xmlScript));
 
 			XDocument XDocScript = new XDocument(xmlScript);
 			XDocScript.Validate(SchemaSet, null, true);
@@ -1,4 +1,5 @@
 ﻿using FomodInstaller.Interface;
+using FomodInstaller.Scripting;
 
 using System.Collections.Generic;
 
@@ -8,4 +9,8 @@ public record InstallResult
 {
     public string Message { get; set; }
     public required List<Instruction> Instructions { get; set; }
+    /// <summary>
+    /// The choices of a headless install, null otherwise
+    /// </summary>
+    public List<InstallDecision>? Decisions { get; set; }
 }
\ No newline at end of file
@@ -1,19 +1,27 @@
 ﻿using FomodInstaller.Interface;
 using FomodInstaller.ModInstaller;
 using FomodInstaller.Scripting;
+using FomodInstaller.Scripting.XmlScript;
 
 using System;
 using System.Collections.Generic;
+using System.Diagnostics;
 using System.Globalization;
 using System.IO;
 using System.Linq;
 using System.Text.Json;
 using System.Threading.Tasks;
 
+using Utils;
+
 namespace ModInstaller.Lite;
 
 public static class Installer
 {
+    private const string WarmupScript =
+        "<config xmlns:xsi=\"http://www.w3.org/2001/XMLSchema-instance\" xsi:noNamespaceSchemaLocation=\"http://qconsulting.ca/fo3/ModConfig5.0.xsd\">" +
+        "<moduleName colour=\"000000\" position=\"Left\">Warmup</moduleName>" +
+        "</config>";
 
     /// <summary>
     /// This will determine whether the program can handle the specific archive.
@@ -59,6 +67,71 @@ public static class Installer
         };
     }
 
+    /// <summary>
+    /// Runs <see cref="TestSupported"/> for every request on the thread pool.
+    /// </summary>
+    /// <param name="requests">The file lists and allowed types of each archive to check.</param>
+    /// <returns>The results, in the same order as <paramref name="requests"/>.</returns>
+    public static SupportedResult[] TestSupportedMany(IReadOnlyList<SupportedRequest> requests)
+    {
+        var results = new SupportedResult[requests.Count];
+
+        Parallel.For(0, requests.Count, i =>
+        {
+            var request = requests[i];
+            results[i] = TestSupported(request.Files, request.AllowedTypes);
+        });
+
+        return results;
+    }
+
+    /// <summary>
+    /// Parses the given install script into the script cache, so a later install of the same script skips parsing.
+    /// </summary>
+    /// <param name="scriptPath">The path to the uncompressed install script file, e.g. fomod/ModuleConfig.xml.</param>
+    /// <param name="validate">Whether the script should also be validated against its schema.</param>
+    /// <returns><c>true</c> if the script was parsed; <c>false</c> if it was already cached.</returns>
+    public static bool PrecompileScript(string scriptPath, bool validate)
+    {
+        var scriptType = GetScriptType(new List<string> { scriptPath });
+        if (scriptType is null)
+            throw new UnsupportedException();
+
+        var scriptData = FileSystem.ReadAllBytes(scriptPath);
+        ScriptCache.Shared.GetOrLoad(scriptType, scriptPath, scriptData, validate, out var loaded);
+        return loaded;
+    }
+
+    /// <summary>
+    /// Performs the one-time initialisation that would otherwise land on the first install.
+    /// </summary>
+    /// <param name="options">Which parts to initialise. <see cref="WarmupOptions.Logger"/> is handled by the host.</param>
+    /// <returns>The time spent on each part.</returns>
+    public static WarmupResult Warmup(WarmupOptions options)
+    {
+        var result = new WarmupResult();
+        var stopwatch = Stopwatch.StartNew();
+
+        if (options.ScriptTypes)
+        {
+            // builds the script type registry and runs the parser once over a minimal script
+            var scriptType = GetScriptType(new List<string> { Path.Combine("fomod", "ModuleConfig.xml") });
+            if (scriptType?.LoadScript(WarmupScript, false) is not null)
+                result.ScriptsParsed++;
+            result.ScriptTypes = stopwatch.Elapsed.TotalMilliseconds;
+        }
+
+        if (options.Schemas)
+        {
+            var start = stopwatch.Elapsed;
+            result.SchemaSets = new XmlScriptType().PreloadSchemas();
+            result.Schemas = (stopwatch.Elapsed - start).TotalMilliseconds;
+        }
+
+        result.Total = stopwatch.Elapsed.TotalMilliseconds;
+        return result;
+    }
+
     /// <summary>
     /// This will simulate the mod installation and decide installation choices and files final paths.
     /// </summary>
@@ -69,6 +142,8 @@ public static class Installer
     /// <param name="preselect">if true, the preset pre-selects options in the dialog instead of auto-confirming headlessly</param>
     /// <param name="progressDelegate">A delegate to provide progress feedback.</param>
     /// <param name="coreDelegate">A delegate for all the interactions with the js core.</param>
+    /// <param name="headless">if true, the installer never opens a dialog and applies the preset or the default choices.
+    ///   The choices are returned in <see cref="InstallResult.Decisions"/></param>
     public static async Task<InstallResult> Install(
         List<string> modArchiveFileList,
         List<string> stopPatterns,
@@ -78,10 +153,14 @@ public static class Installer
         bool preselect,
         bool validate,
         ProgressDelegate progressDelegate,
-        CoreDelegates coreDelegate)
+        CoreDelegates coreDelegate,
+        bool headless = false)
     {
         CultureInfo.DefaultThreadCurrentCulture = CultureInfo.DefaultThreadCurrentUICulture = CultureInfo.InvariantCulture;
+        // file handles a script left open are closed with the install
+        using var openStreams = FileSystemStream.TrackOpenStreams();
         var instructions = new List<Instruction>();
+        var decisions = headless ? new List<InstallDecision>() : null;
         string scriptFilePath = null;
 
         try
@@ -100,7 +179,7 @@ public static class Installer
 
         if (modToInstall.HasInstallScript)
         {
-            instructions = await ScriptedModInstall(modToInstall, preset, preselect, coreDelegate) ??
+            instructions = await ScriptedModInstall(modToInstall, preset, preselect, headless, decisions, coreDelegate) ??
                            Instruction.InstallErrorList("warning", "Installer failed (it should have reported an error message)");
         }
         else
@@ -129,6 +208,7 @@ public static class Installer
         {
             Message = "Installation successful",
             Instructions = instructions,
+            Decisions = decisions,
         };
     }
 
@@ -194,11 +274,15 @@ public static class Installer
         Mod modArchive,
         JsonDocument? preset,
         bool preselect,
+        bool headless,
+        List<InstallDecision>? decisions,
         CoreDelegates coreDelegate)
     {
         var presetExpando = preset is not null ? JsonUtils.ParseJsonArray(preset) : null;
 
         var sexScript = modArchive.InstallScript.Type.CreateExecutor(modArchive, coreDelegate);
+        sexScript.Headless = headless;
+        sexScript.DecisionLog = decisions;
         return (await sexScript.Execute(modArchive.InstallScript, modArchive.TempPath, presetExpando, preselect)).ToList();
     }
 }
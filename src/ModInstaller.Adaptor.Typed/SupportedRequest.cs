@@ -0,0 +1,9 @@
+﻿using System.Collections.Generic;
+
+namespace ModInstaller.Lite;
+
+public record SupportedRequest
+{
+    public List<string> Files { get; set; } = new();
+    public List<string> AllowedTypes { get; set; } = new();
+}
\ No newline at end of file
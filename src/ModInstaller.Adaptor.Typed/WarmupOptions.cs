@@ -0,0 +1,13 @@
+﻿namespace ModInstaller.Lite;
+
+/// <summary>
+/// The parts of <see cref="Installer.Warmup"/> to run. Parts that aren't set are skipped.
+/// </summary>
+public record WarmupOptions
+{
+    public static WarmupOptions All { get; } = new() { Schemas = true, ScriptTypes = true, Logger = true };
+
+    public bool Schemas { get; set; }
+    public bool ScriptTypes { get; set; }
+    public bool Logger { get; set; }
+}
\ No newline at end of file
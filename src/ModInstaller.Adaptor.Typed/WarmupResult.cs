@@ -0,0 +1,17 @@
+﻿namespace ModInstaller.Lite;
+
+/// <summary>
+/// How long each part of <see cref="Installer.Warmup"/> took, in milliseconds, and how many items it warmed.
+/// Skipped parts are 0.
+/// </summary>
+public record WarmupResult
+{
+    public int SchemaSets { get; set; }
+    public int ScriptsParsed { get; set; }
+
+    public double Schemas { get; set; }
+    public double ScriptTypes { get; set; }
+    public double Logger { get; set; }
+    public double Serializers { get; set; }
+    public double Total { get; set; }
+}
\ No newline at end of file
@@ -0,0 +1,77 @@
+/**
+ * Writes synthetic FOMODs to disk
+ * For every requested schema version emits <out>/<version>/fomod/ModuleConfig.xml and
+ * <out>/<version>/files.txt with the matching archive listing.
+ *
+ * Usage: npx ts-node --project tsconfig.test.json bench/generate-fomod.ts [options]
+ *   --out <dir>            Output directory (default ./synthetic-fomods)
+ *   --versions <list>      Comma separated schema versions, e.g. 1.0,5.0 (default all)
+ *   --preset <name>        small, medium or large (default medium)
+ *   --scale <factor>       Scale factor applied to the preset (default 1)
+ *   --set <key>=<value>    Overrides a single size option, may be repeated
+ *   --materialize          Also create empty placeholder files for the whole listing
+ */
+
+import * as fs from 'fs';
+import * as path from 'path';
+import {
+  generateSyntheticFomod,
+  scaleSyntheticOptions,
+  SyntheticFomodOptions,
+  SYNTHETIC_PRESETS,
+  XML_SCRIPT_VERSIONS,
+  XmlScriptVersion
+} from '../test/syntheticFomod';
+
+const args = process.argv.slice(2);
+const option = (name: string, fallback: string): string => {
+  const index = args.indexOf(name);
+  return index >= 0 && index + 1 < args.length ? args[index + 1] : fallback;
+};
+
+const outDir = path.resolve(option('--out', 'synthetic-fomods'));
+const versionsArg = option('--versions', 'all');
+const versions = versionsArg === 'all' ? XML_SCRIPT_VERSIONS : versionsArg.split(',') as XmlScriptVersion[];
+const presetName = option('--preset', 'medium');
+const scale = parseFloat(option('--scale', '1'));
+const materialize = args.includes('--materialize');
+
+const preset = SYNTHETIC_PRESETS[presetName];
+if (!preset) {
+  console.error(`Unknown preset '${presetName}', expected one of ${Object.keys(SYNTHETIC_PRESETS).join(', ')}`);
+  process.exit(1);
+}
+
+const options: SyntheticFomodOptions = scaleSyntheticOptions(preset, scale);
+args.forEach((arg, i) => {
+  if (arg !== '--set') return;
+  const [key, value] = args[i + 1].split('=');
+  if (!(key in options)) {
+    console.error(`Unknown option '${key}'`);
+    process.exit(1);
+  }
+  (options as any)[key] = parseInt(value, 10);
+});
+
+for (const version of versions) {
+  const fomod = generateSyntheticFomod(version, options);
+  const root = path.join(outDir, version);
+  const fomodDir = path.join(root, 'fomod');
+  fs.mkdirSync(fomodDir, { recursive: true });
+  fs.writeFileSync(path.join(fomodDir, 'ModuleConfig.xml'), fomod.moduleConfig);
+  fs.writeFileSync(path.join(root, 'files.txt'), fomod.files.join('\n') + '\n');
+
+  if (materialize) {
+    for (const file of fomod.files) {
+      const target = path.join(root, file.replace(/\\/g, '/'));
+      if (file.endsWith('/') || file.endsWith('\\')) {
+        fs.mkdirSync(target, { recursive: true });
+      } else if (!fs.existsSync(target)) {
+        fs.mkdirSync(path.dirname(target), { recursive: true });
+        fs.writeFileSync(target, '');
+      }
+    }
+  }
+
+  console.log(`${version}: ${(fomod.moduleConfig.length / 1024).toFixed(0)} KiB script, ${fomod.files.length} archive entries -> ${root}`);
+}
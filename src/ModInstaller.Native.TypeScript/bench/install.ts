@@ -0,0 +1,492 @@
+/**
+ * End-to-end install benchmark over the shared test data
+ * Replays every case from test/sharedTestData.ts and reports throughput, latency percentiles,
+ * peak RSS and allocAliveCount per FileSystem mode and preset mode.
+ *
+ * Usage: npx ts-node --project tsconfig.test.json bench/install.ts [options]
+ *   --iterations <n>   Measured installs per case (default 20)
+ *   --warmup <n>       Unmeasured installs per case (default 2)
+ *   --filter <text>    Only run cases whose "game: name" contains the text
+ *   --fs <modes>       Comma separated FileSystem modes: default,callbacks (default both)
+ *   --preset <modes>   Comma separated preset modes: none,preset,headless (default none,preset)
+ *                      headless installs without a dialog from the preset, or the defaults if there is none
+ *   --json [path]      Write the report as JSON to the path, or stdout
+ *   --synthetic <versions>     Run generated FOMODs instead of the shared cases, e.g. 1.0,5.0 or all
+ *   --synthetic-preset <name>  Size preset from test/syntheticFomod.ts (default small)
+ *   --synthetic-scale <list>   Comma separated scale factors applied to the preset (default 1)
+ *   --record <dir>     Record the callback traffic of one extra install per case for bench/replay.ts
+ */
+
+import * as fs from 'fs';
+import * as os from 'os';
+import * as path from 'path';
+import { performance } from 'perf_hooks';
+import { NativeModInstaller, NativeFileSystem, allocAliveCount, startRecording, stopRecording } from '../src';
+import * as types from '../src/types';
+import { getAllTestCases, getStopPatterns, preloadArchive, TestCase, SelectedOption } from '../test/sharedTestData';
+import {
+  generateSyntheticFomod,
+  scaleSyntheticOptions,
+  SyntheticFomodOptions,
+  SYNTHETIC_PRESETS,
+  XML_SCRIPT_VERSIONS,
+  XmlScriptVersion
+} from '../test/syntheticFomod';
+
+type FileSystemMode = 'default' | 'callbacks';
+type PresetMode = 'none' | 'preset' | 'headless';
+
+interface Options {
+  iterations: number;
+  warmup: number;
+  filter: string | null;
+  fileSystemModes: FileSystemMode[];
+  presetModes: PresetMode[];
+  json: string | boolean;
+  synthetic: XmlScriptVersion[] | null;
+  syntheticPreset: string;
+  syntheticScales: number[];
+  record: string | null;
+}
+
+interface SyntheticInfo {
+  version: XmlScriptVersion;
+  scale: number;
+  scriptBytes: number;
+  archiveFiles: number;
+  options: SyntheticFomodOptions;
+}
+
+interface Stats {
+  installs: number;
+  failures: number;
+  totalMs: number;
+  installsPerSecond: number;
+  p50Ms: number;
+  p99Ms: number;
+  maxMs: number;
+  peakRssBytes: number;
+  allocAliveCount: number;
+}
+
+interface CaseReport extends Stats {
+  name: string;
+  fileSystem: FileSystemMode;
+  preset: PresetMode;
+  synthetic?: SyntheticInfo;
+}
+
+interface ModeReport extends Stats {
+  fileSystem: FileSystemMode;
+  preset: PresetMode;
+  cases: CaseReport[];
+}
+
+interface LoadedCase {
+  testCase: TestCase;
+  files: string[];
+  fileCache: Map<string, Uint8Array>;
+  // Directory with the extracted archive for the default FileSystem
+  extractedPath: string;
+  synthetic?: SyntheticInfo;
+  close: () => Promise<void>;
+}
+
+const parseOptions = (argv: string[]): Options => {
+  const options: Options = {
+    iterations: 20,
+    warmup: 2,
+    filter: null,
+    fileSystemModes: ['default', 'callbacks'],
+    presetModes: ['none', 'preset'],
+    json: false,
+    synthetic: null,
+    syntheticPreset: 'small',
+    syntheticScales: [1],
+    record: null,
+  };
+  for (let i = 0; i < argv.length; i++) {
+    const next = argv[i + 1];
+    switch (argv[i]) {
+      case '--iterations': options.iterations = parseInt(next, 10); i++; break;
+      case '--warmup': options.warmup = parseInt(next, 10); i++; break;
+      case '--filter': options.filter = next; i++; break;
+      case '--fs': options.fileSystemModes = next.split(',') as FileSystemMode[]; i++; break;
+      case '--preset': options.presetModes = next.split(',') as PresetMode[]; i++; break;
+      case '--json':
+        if (next !== undefined && !next.startsWith('--')) {
+          options.json = next;
+          i++;
+        } else {
+          options.json = true;
+        }
+        break;
+      case '--synthetic':
+        options.synthetic = next === 'all' ? XML_SCRIPT_VERSIONS : next.split(',') as XmlScriptVersion[];
+        i++;
+        break;
+      case '--synthetic-preset': options.syntheticPreset = next; i++; break;
+      case '--synthetic-scale': options.syntheticScales = next.split(',').map(parseFloat); i++; break;
+      case '--record': options.record = next; i++; break;
+    }
+  }
+  return options;
+};
+
+const percentile = (sorted: number[], p: number): number => {
+  if (sorted.length === 0) return 0;
+  const index = Math.min(sorted.length - 1, Math.ceil((p / 100) * sorted.length) - 1);
+  return sorted[Math.max(0, index)];
+};
+
+const toStats = (durations: number[], failures: number, peakRssBytes: number): Stats => {
+  const sorted = [...durations].sort((a, b) => a - b);
+  const totalMs = durations.reduce((sum, d) => sum + d, 0);
+  return {
+    installs: durations.length,
+    failures,
+    totalMs,
+    installsPerSecond: totalMs > 0 ? (durations.length * 1000) / totalMs : 0,
+    p50Ms: percentile(sorted, 50),
+    p99Ms: percentile(sorted, 99),
+    maxMs: sorted.length > 0 ? sorted[sorted.length - 1] : 0,
+    peakRssBytes,
+    allocAliveCount: allocAliveCount(),
+  };
+};
+
+// Samples RSS while installs run on the .NET side
+class RssSampler {
+  private peak = 0;
+  private timer: NodeJS.Timeout | null = null;
+
+  public start(): void {
+    this.peak = process.memoryUsage.rss();
+    this.timer = setInterval(() => this.sample(), 5);
+  }
+
+  public sample(): void {
+    this.peak = Math.max(this.peak, process.memoryUsage.rss());
+  }
+
+  public stop(): number {
+    if (this.timer) clearInterval(this.timer);
+    this.timer = null;
+    this.sample();
+    return this.peak;
+  }
+}
+
+const createUICallbacks = (dialogChoices?: SelectedOption[], gameVersion?: string, extenderVersion?: string) => {
+  let selectCallback: types.SelectCallback | null = null;
+  let contCallback: types.ContinueCallback | null = null;
+  let dialogInProgress = false;
+
+  return {
+    pluginsGetAll: (_activeOnly: boolean): string[] => [],
+    contextGetAppVersion: (): string => '1.0.0',
+    contextGetCurrentGameVersion: (): string => gameVersion ?? '1.0.0',
+    contextGetExtenderVersion: (_extender: string): string => extenderVersion ?? '1.0.0',
+    uiStartDialog: (_moduleName: string, _image: types.IHeaderImage, select: types.SelectCallback, cont: types.ContinueCallback, _cancel: types.CancelCallback): void => {
+      selectCallback = select;
+      contCallback = cont;
+    },
+    uiEndDialog: (): void => {
+      selectCallback = null;
+      contCallback = null;
+    },
+    uiUpdateState: (_installSteps: types.IInstallStep[], currentStep: number): void => {
+      if (dialogInProgress || !contCallback) return;
+      dialogInProgress = true;
+      const choice = dialogChoices?.find(c => c.stepId === currentStep);
+      if (choice && selectCallback) {
+        selectCallback(choice.stepId, choice.groupId, choice.pluginIds);
+      }
+      contCallback(true, currentStep);
+      dialogInProgress = false;
+    }
+  };
+};
+
+const createCallbackFileSystem = (files: string[], fileCache: Map<string, Uint8Array>): NativeFileSystem => {
+  const normalizedFiles = files.map(file => ({ file, normalized: file.replace(/\\/g, '/').toLowerCase() }));
+  const matches = (normalizedDir: string, normalizedFile: string): boolean =>
+    normalizedDir === '' || normalizedFile.startsWith(normalizedDir);
+
+  return new NativeFileSystem(
+    (filePath: string, offset: number, length: number): Uint8Array | null => {
+      const content = fileCache.get(filePath.replace(/\\/g, '/').toLowerCase());
+      if (!content) return null;
+      if (length === -1) length = content.length;
+      if (offset > 0 || length < content.length) {
+        return content.slice(offset, Math.min(offset + length, content.length));
+      }
+      return content;
+    },
+    (directoryPath: string, _pattern: string, _searchType: number): string[] | null => {
+      const normalizedDir = directoryPath.replace(/\\/g, '/').toLowerCase();
+      return normalizedFiles.filter(f => matches(normalizedDir, f.normalized)).map(f => f.file);
+    },
+    (directoryPath: string): string[] | null => {
+      const normalizedDir = directoryPath.replace(/\\/g, '/').toLowerCase();
+      const dirs = new Set<string>();
+      for (const { normalized } of normalizedFiles) {
+        if (!matches(normalizedDir, normalized)) continue;
+        const remaining = normalizedDir === '' ? normalized : normalized.slice(normalizedDir.length + 1);
+        const parts = remaining.split('/').filter(p => p.length > 0);
+        if (parts.length > 1) dirs.add(parts[0]);
+      }
+      return Array.from(dirs);
+    },
+    (filePath: string): types.FileSystemStat | null => {
+      const normalized = filePath.replace(/\\/g, '/').toLowerCase();
+      const content = fileCache.get(normalized);
+      if (content) return { kind: 'file', size: content.length };
+      return normalizedFiles.some(f => f.normalized.startsWith(normalized + '/'))
+        ? { kind: 'directory', size: 0 }
+        : null;
+    }
+  );
+};
+
+const extract = (fileCache: Map<string, Uint8Array>): string => {
+  const extractedPath = fs.mkdtempSync(path.join(os.tmpdir(), 'fomod-bench-'));
+  for (const [file, content] of fileCache) {
+    const target = path.join(extractedPath, file);
+    fs.mkdirSync(path.dirname(target), { recursive: true });
+    fs.writeFileSync(target, content);
+  }
+  return extractedPath;
+};
+
+const loadCase = async (testCase: TestCase): Promise<LoadedCase> => {
+  const archive = await preloadArchive(testCase.archiveFile, testCase.game);
+  const extractedPath = extract(archive.fileCache);
+  return {
+    testCase,
+    files: archive.files,
+    fileCache: archive.fileCache,
+    extractedPath,
+    close: async () => {
+      fs.rmSync(extractedPath, { recursive: true, force: true });
+      await archive.close();
+    }
+  };
+};
+
+const loadSyntheticCase = (version: XmlScriptVersion, presetName: string, scale: number): LoadedCase => {
+  const preset = SYNTHETIC_PRESETS[presetName];
+  if (!preset) {
+    throw new Error(`Unknown synthetic preset '${presetName}'`);
+  }
+  const fomod = generateSyntheticFomod(version, scaleSyntheticOptions(preset, scale));
+  // Only the script is read during install, the default FileSystem gets just that on disk
+  const extractedPath = extract(fomod.fileCache);
+  return {
+    testCase: {
+      name: `synthetic ${version} ${presetName} x${scale}`,
+      game: 'Synthetic',
+      mod: 'Synthetic',
+      archiveFile: '',
+      stopPatterns: [],
+      pluginPath: 'Data',
+      expectedInstructions: [],
+    },
+    files: fomod.files,
+    fileCache: fomod.fileCache,
+    extractedPath,
+    synthetic: {
+      version,
+      scale,
+      scriptBytes: fomod.moduleConfig.length,
+      archiveFiles: fomod.files.length,
+      options: fomod.options,
+    },
+    close: async () => {
+      fs.rmSync(extractedPath, { recursive: true, force: true });
+    }
+  };
+};
+
+const installOnce = async (loaded: LoadedCase, fileSystem: FileSystemMode, preset: PresetMode): Promise<boolean> => {
+  const { testCase } = loaded;
+  const callbacks = createUICallbacks(
+    preset === 'none' ? testCase.dialogChoices : undefined,
+    testCase.gameVersion,
+    testCase.extenderVersion
+  );
+  const installer = new NativeModInstaller(
+    callbacks.pluginsGetAll,
+    callbacks.contextGetAppVersion,
+    callbacks.contextGetCurrentGameVersion,
+    callbacks.contextGetExtenderVersion,
+    callbacks.uiStartDialog,
+    callbacks.uiEndDialog,
+    callbacks.uiUpdateState
+  );
+  const result = await installer.install(
+    loaded.files,
+    getStopPatterns(testCase),
+    testCase.pluginPath,
+    // The default FileSystem reads the extracted archive from disk
+    fileSystem === 'default' ? loaded.extractedPath : '',
+    preset === 'preset' || preset === 'headless' ? testCase.preset ?? null : null,
+    preset === 'headless' ? false : testCase.preselect ?? false,
+    testCase.validate ?? true,
+    preset === 'headless'
+  );
+  return result !== null && result.instructions !== undefined;
+};
+
+const runCase = async (loaded: LoadedCase, fileSystem: FileSystemMode, preset: PresetMode, options: Options): Promise<{ report: CaseReport; durations: number[] }> => {
+  if (fileSystem === 'callbacks') {
+    createCallbackFileSystem(loaded.files, loaded.fileCache).setCallbacks();
+  } else {
+    NativeFileSystem.setDefaultCallbacks();
+  }
+
+  if (options.record) {
+    const name = `${loaded.testCase.game}-${loaded.testCase.name}-${fileSystem}-${preset}`.replace(/[^\w.-]+/g, '_');
+    fs.mkdirSync(options.record, { recursive: true });
+    startRecording(path.join(options.record, `${name}.fmrl`));
+    try {
+      await installOnce(loaded, fileSystem, preset);
+    } finally {
+      stopRecording();
+    }
+  }
+
+  for (let i = 0; i < options.warmup; i++) {
+    await installOnce(loaded, fileSystem, preset);
+  }
+
+  const sampler = new RssSampler();
+  const durations: number[] = [];
+  let failures = 0;
+  sampler.start();
+  for (let i = 0; i < options.iterations; i++) {
+    const start = performance.now();
+    let succeeded = false;
+    try {
+      succeeded = await installOnce(loaded, fileSystem, preset);
+    } catch {
+      succeeded = false;
+    }
+    durations.push(performance.now() - start);
+    if (!succeeded) failures++;
+    sampler.sample();
+  }
+  const peakRss = sampler.stop();
+
+  NativeFileSystem.setDefaultCallbacks();
+  const report: CaseReport = {
+    name: `${loaded.testCase.game}: ${loaded.testCase.name}`,
+    fileSystem,
+    preset,
+    synthetic: loaded.synthetic,
+    ...toStats(durations, failures, peakRss),
+  };
+  return { report, durations };
+};
+
+const aggregate = (fileSystem: FileSystemMode, preset: PresetMode, cases: CaseReport[], durations: number[]): ModeReport => {
+  const failures = cases.reduce((sum, c) => sum + c.failures, 0);
+  const peakRss = cases.reduce((max, c) => Math.max(max, c.peakRssBytes), 0);
+  return { fileSystem, preset, ...toStats(durations, failures, peakRss), cases };
+};
+
+const formatMode = (report: ModeReport): string =>
+  [
+    `${report.fileSystem}/${report.preset}`.padEnd(18),
+    String(report.installs).padStart(8),
+    String(report.failures).padStart(8),
+    report.installsPerSecond.toFixed(1).padStart(10),
+    report.p50Ms.toFixed(2).padStart(9),
+    report.p99Ms.toFixed(2).padStart(9),
+    (report.peakRssBytes / (1024 * 1024)).toFixed(1).padStart(10),
+    String(report.allocAliveCount).padStart(6),
+  ].join(' ');
+
+const main = async (): Promise<void> => {
+  const options = parseOptions(process.argv.slice(2));
+
+  const loadedCases: LoadedCase[] = [];
+  if (options.synthetic !== null) {
+    for (const version of options.synthetic) {
+      for (const scale of options.syntheticScales) {
+        loadedCases.push(loadSyntheticCase(version, options.syntheticPreset, scale));
+      }
+    }
+  } else {
+    const testCases = getAllTestCases().filter(tc =>
+      options.filter === null || `${tc.game}: ${tc.name}`.includes(options.filter));
+    for (const testCase of testCases) {
+      loadedCases.push(await loadCase(testCase));
+    }
+  }
+
+  const modes: ModeReport[] = [];
+  try {
+    for (const fileSystem of options.fileSystemModes) {
+      for (const preset of options.presetModes) {
+        // Only cases that ship a preset can be measured in preset mode
+        const applicable = loadedCases.filter(c => preset !== 'preset' || c.testCase.preset !== undefined);
+        const cases: CaseReport[] = [];
+        const durations: number[] = [];
+        for (const loaded of applicable) {
+          const { report, durations: caseDurations } = await runCase(loaded, fileSystem, preset, options);
+          cases.push(report);
+          durations.push(...caseDurations);
+        }
+        modes.push(aggregate(fileSystem, preset, cases, durations));
+      }
+    }
+  } finally {
+    for (const loaded of loadedCases) {
+      await loaded.close();
+    }
+  }
+
+  const report = {
+    timestamp: new Date().toISOString(),
+    node: process.version,
+    platform: `${process.platform}-${process.arch}`,
+    iterations: options.iterations,
+    warmup: options.warmup,
+    modes,
+  };
+
+  if (options.json === true) {
+    console.log(JSON.stringify(report, null, 2));
+    return;
+  }
+  if (typeof options.json === 'string') {
+    fs.writeFileSync(options.json, JSON.stringify(report, null, 2));
+  }
+
+  console.log(`${loadedCases.length} cases, ${options.iterations} iterations, ${options.warmup} warmup`);
+  console.log('mode               installs failures  install/s   p50 ms   p99 ms   peak MiB alive');
+  modes.forEach(mode => console.log(formatMode(mode)));
+
+  if (options.synthetic !== null) {
+    console.log('\ncase                          mode               script KiB  entries   p50 ms   p99 ms   peak MiB');
+    for (const mode of modes) {
+      for (const c of mode.cases) {
+        console.log([
+          c.name.padEnd(29),
+          `${c.fileSystem}/${c.preset}`.padEnd(18),
+          (c.synthetic!.scriptBytes / 1024).toFixed(0).padStart(10),
+          String(c.synthetic!.archiveFiles).padStart(8),
+          c.p50Ms.toFixed(2).padStart(8),
+          c.p99Ms.toFixed(2).padStart(8),
+          (c.peakRssBytes / (1024 * 1024)).toFixed(1).padStart(10),
+        ].join(' '));
+      }
+    }
+  }
+};
+
+main().catch(error => {
+  console.error(error);
+  process.exit(1);
+});
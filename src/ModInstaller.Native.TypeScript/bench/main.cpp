@@ -0,0 +1,231 @@
+#define NODE_API_NO_EXTERNAL_BUFFERS_ALLOWED // Thanks Electron
+
+// Benchmark addon: the regular bindings from src-native plus microbenchmarks of the
+// marshalling helpers, built against bench/stub instead of ModInstaller.Native.
+
+#include "Platform.hpp"
+#include <napi.h>
+#include <chrono>
+#include "Bindings.Common.hpp"
+#include "Bindings.Logging.Implementation.hpp"
+#include "Bindings.ModInstaller.Implementation.hpp"
+#include "Bindings.InstallResult.Implementation.hpp"
+#include "Bindings.FileSystem.Implementation.hpp"
+#include "Bindings.ScriptCache.hpp"
+#include "Bindings.ImagePrefetch.hpp"
+#include "Bindings.Runtime.hpp"
+#include "Bindings.Recording.hpp"
+#include "Bindings.Watchdog.hpp"
+#include "Utils.Glob.hpp"
+
+using namespace Napi;
+using namespace Utils;
+
+namespace Bench
+{
+    template <typename TBody>
+    Object Measure(const Env env, const int64_t iterations, TBody body)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (int64_t i = 0; i < iterations; i++)
+        {
+            body();
+        }
+        const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+        auto result = Object::New(env);
+        result.Set("iterations", Number::New(env, static_cast<double>(iterations)));
+        result.Set("totalNs", Number::New(env, elapsed));
+        result.Set("nsPerOp", Number::New(env, iterations > 0 ? elapsed / iterations : 0));
+        return result;
+    }
+
+    std::u16string MakeString(const size_t length)
+    {
+        std::u16string str(length, u'a');
+        for (size_t i = 0; i < length; i++)
+        {
+            str[i] = static_cast<char16_t>(u'a' + (i % 26));
+        }
+        return str;
+    }
+
+    // copy(length, iterations)
+    Value CopyString(const CallbackInfo &info)
+    {
+        const auto env = info.Env();
+        const auto str = MakeString(info[0].As<Number>().Uint32Value());
+        return Measure(env, info[1].As<Number>().Int64Value(), [&str]()
+                       { common_dealloc(Copy(str)); });
+    }
+
+    // copyBytes(length, iterations)
+    Value CopyBytes(const CallbackInfo &info)
+    {
+        const auto env = info.Env();
+        const std::vector<uint8_t> data(info[0].As<Number>().Uint32Value(), 0x5A);
+        return Measure(env, info[1].As<Number>().Int64Value(), [&data]()
+                       { common_dealloc(Copy(data.data(), data.size())); });
+    }
+
+    // copyWithFree(length, iterations)
+    Value CopyStringWithFree(const CallbackInfo &info)
+    {
+        const auto env = info.Env();
+        const auto str = MakeString(info[0].As<Number>().Uint32Value());
+        return Measure(env, info[1].As<Number>().Int64Value(), [&str]()
+                       { const auto copy = CopyWithFree(str); });
+    }
+
+    // create(iterations)
+    Value CreateResult(const CallbackInfo &info)
+    {
+        const auto env = info.Env();
+        return Measure(env, info[0].As<Number>().Int64Value(), []()
+                       { common_dealloc(Create(return_value_json{nullptr, nullptr})); });
+    }
+
+    // convertToJsonResult(value, iterations)
+    Value ConvertToJson(const CallbackInfo &info)
+    {
+        const auto env = info.Env();
+        const auto value = info[0];
+        return Measure(env, info[1].As<Number>().Int64Value(), [&value]()
+                       { const del_json result{ConvertToJsonResult(value)};
+                         common_dealloc(result->value);
+                         common_dealloc(result->error); });
+    }
+
+    // convertToDataResult(buffer, iterations)
+    Value ConvertToData(const CallbackInfo &info)
+    {
+        const auto env = info.Env();
+        const auto value = info[0];
+        return Measure(env, info[1].As<Number>().Int64Value(), [&value]()
+                       { const auto result = ConvertToDataResult(value);
+                         common_dealloc(result->value);
+                         common_dealloc(result->error);
+                         common_dealloc(result); });
+    }
+
+    // loggerLog(length, iterations)
+    Value LoggerLog(const CallbackInfo &info)
+    {
+        const auto env = info.Env();
+        const std::string message(info[0].As<Number>().Uint32Value(), 'm');
+        return Measure(env, info[1].As<Number>().Int64Value(), [&message]()
+                       { Logger::Log(message); });
+    }
+
+    // glob(pattern, names, iterations, simd): each iteration matches every name, simd is
+    // 'scalar', 'sse2', 'avx2' or 'auto'; returns null when the CPU lacks the instruction set
+    Value GlobMatch(const CallbackInfo &info)
+    {
+        const auto env = info.Env();
+        const Glob glob(info[0].As<String>().Utf16Value());
+        const auto namesArray = info[1].As<Array>();
+        std::vector<std::u16string> names;
+        names.reserve(namesArray.Length());
+        for (uint32_t i = 0; i < namesArray.Length(); i++)
+        {
+            names.push_back(namesArray.Get(i).As<String>().Utf16Value());
+        }
+
+        const auto level = info[3].As<String>().Utf8Value();
+        const auto simd = level == "scalar" ? GlobSimd::Scalar : level == "sse2" ? GlobSimd::Sse2 : level == "avx2" ? GlobSimd::Avx2 : Glob::DetectedSimd();
+        if (simd > Glob::DetectedSimd())
+        {
+            return env.Null();
+        }
+
+        size_t matches = 0;
+        auto result = Measure(env, info[2].As<Number>().Int64Value(), [&glob, &names, &matches, simd]()
+                              { for (const auto &name : names)
+                                    matches += glob.Match(name.data(), name.size(), simd) ? 1 : 0; });
+        result.Set("matches", Number::New(env, static_cast<double>(matches)));
+        return result;
+    }
+
+    // configureStub({ delayUs, payloadItems, callbackCalls })
+    void ConfigureStub(const CallbackInfo &info)
+    {
+        const auto options = info[0].As<Object>();
+        const auto get = [&options](const char *name, const int32_t fallback)
+        {
+            return options.Has(name) ? options.Get(name).As<Number>().Int32Value() : fallback;
+        };
+        stub_configure(get("delayUs", 0), get("payloadItems", 1), get("callbackCalls", 0));
+    }
+
+    // stress(threads, callsPerThread): Promise<StressResult>
+    Value Stress(const CallbackInfo &info)
+    {
+        const auto functionName = __FUNCTION__;
+        LoggerScope logger(functionName);
+
+        try
+        {
+            const auto env = info.Env();
+            const auto threads = info[0].As<Number>().Int32Value();
+            const auto callsPerThread = info[1].As<Number>().Int32Value();
+
+            auto cbData = CreateResultCallbackData(env, functionName);
+            const auto deferred = cbData->deferred;
+            const auto tsfn = cbData->tsfn;
+
+            const auto result = stub_stress(threads, callsPerThread, cbData, HandleJsonResultCallback);
+            return ReturnAndHandleReject(env, result, deferred, tsfn);
+        }
+        catch (const Napi::Error &e)
+        {
+            logger.LogError(e);
+            throw;
+        }
+        catch (const std::exception &e)
+        {
+            logger.LogException(e);
+            throw;
+        }
+        catch (...)
+        {
+            logger.Log("Unknown exception");
+            throw;
+        }
+    }
+
+    Object Init(const Env env, Object exports)
+    {
+        auto bench = Object::New(env);
+        bench.Set("copy", Function::New(env, CopyString));
+        bench.Set("copyBytes", Function::New(env, CopyBytes));
+        bench.Set("copyWithFree", Function::New(env, CopyStringWithFree));
+        bench.Set("create", Function::New(env, CreateResult));
+        bench.Set("convertToJsonResult", Function::New(env, ConvertToJson));
+        bench.Set("convertToDataResult", Function::New(env, ConvertToData));
+        bench.Set("loggerLog", Function::New(env, LoggerLog));
+        bench.Set("configureStub", Function::New(env, ConfigureStub));
+        bench.Set("stress", Function::New(env, Stress));
+        bench.Set("glob", Function::New(env, GlobMatch));
+        exports.Set("bench", bench);
+
+        return exports;
+    }
+}
+
+Object InitAll(const Env env, const Object exports)
+{
+  Bindings::Common::Init(env, exports);
+  Bindings::Logging::Init(env, exports);
+  Bindings::ModInstaller::Init(env, exports);
+  Bindings::InstallResult::Init(env, exports);
+  Bindings::FileSystem::Init(env, exports);
+  Bindings::ScriptCache::Init(env, exports);
+  Bindings::ImagePrefetch::Init(env, exports);
+  Bindings::Runtime::Init(env, exports);
+  Bindings::Recording::Init(env, exports);
+  Bindings::Watchdog::Init(env, exports);
+  Bench::Init(env, exports);
+  return exports;
+}
+
+NODE_API_MODULE(NODE_GYP_MODULE_NAME, InitAll)
@@ -0,0 +1,154 @@
+/**
+ * Replays recorded installs without the host app
+ * Every recording (see startRecording / bench/install.ts --record) is installed again with its
+ * FileSystem, ModInstaller and dialog callbacks answered natively from the log, so the numbers
+ * only contain ModInstaller.Native and the bindings.
+ *
+ * Usage: npx ts-node --project tsconfig.test.json bench/replay.ts <recording|dir>... [options]
+ *   --iterations <n>   Measured replays per recording (default 20)
+ *   --warmup <n>       Unmeasured replays per recording (default 2)
+ *   --timing           Wait for the recorded callback durations, reproducing the host latency
+ *   --json [path]      Write the report as JSON to the path, or stdout
+ */
+
+import * as fs from 'fs';
+import * as path from 'path';
+import { performance } from 'perf_hooks';
+import { allocAliveCount, getReplayStats, replayInstall } from '../src';
+
+interface ReplayReport {
+  recording: string;
+  replays: number;
+  failures: number;
+  p50Ms: number;
+  p99Ms: number;
+  maxMs: number;
+  answered: number;
+  missed: number;
+  dialogActions: number;
+}
+
+const args = process.argv.slice(2);
+const option = (name: string, fallback: string): string => {
+  const index = args.indexOf(name);
+  return index >= 0 && index + 1 < args.length ? args[index + 1] : fallback;
+};
+
+const iterations = parseInt(option('--iterations', '20'), 10);
+const warmup = parseInt(option('--warmup', '2'), 10);
+const timing = args.includes('--timing');
+const jsonIndex = args.indexOf('--json');
+const json = jsonIndex < 0 ? false : (args[jsonIndex + 1] !== undefined && !args[jsonIndex + 1].startsWith('--') ? args[jsonIndex + 1] : true);
+
+const valueOptions = new Set(['--iterations', '--warmup', '--json']);
+const inputs = args.filter((arg, i) => !arg.startsWith('--') && !valueOptions.has(args[i - 1]));
+const recordings = inputs.flatMap((input) => fs.statSync(input).isDirectory()
+  ? fs.readdirSync(input).filter((file) => file.endsWith('.fmrl')).sort().map((file) => path.join(input, file))
+  : [input]);
+
+if (recordings.length === 0) {
+  console.error('No recordings given');
+  process.exit(1);
+}
+
+const percentile = (sorted: number[], p: number): number => {
+  if (sorted.length === 0) return 0;
+  const index = Math.min(sorted.length - 1, Math.ceil((p / 100) * sorted.length) - 1);
+  return sorted[Math.max(0, index)];
+};
+
+const replayOnce = async (recording: string): Promise<boolean> => {
+  try {
+    return (await replayInstall(recording, { timing })) !== null;
+  } catch {
+    return false;
+  }
+};
+
+const runRecording = async (recording: string): Promise<ReplayReport> => {
+  for (let i = 0; i < warmup; i++) {
+    await replayOnce(recording);
+  }
+
+  const durations: number[] = [];
+  let failures = 0;
+  let answered = 0;
+  let missed = 0;
+  let dialogActions = 0;
+  for (let i = 0; i < iterations; i++) {
+    const start = performance.now();
+    const succeeded = await replayOnce(recording);
+    durations.push(performance.now() - start);
+    if (!succeeded) failures++;
+
+    const stats = getReplayStats();
+    answered += stats.answered;
+    missed += stats.missed;
+    dialogActions += stats.dialogActions;
+  }
+
+  const sorted = [...durations].sort((a, b) => a - b);
+  return {
+    recording: path.basename(recording),
+    replays: durations.length,
+    failures,
+    p50Ms: percentile(sorted, 50),
+    p99Ms: percentile(sorted, 99),
+    maxMs: sorted.length > 0 ? sorted[sorted.length - 1] : 0,
+    answered: answered / Math.max(1, iterations),
+    missed: missed / Math.max(1, iterations),
+    dialogActions: dialogActions / Math.max(1, iterations),
+  };
+};
+
+const printTable = (reports: ReplayReport[]): void => {
+  const header = ['recording', 'replays', 'fail', 'p50 ms', 'p99 ms', 'max ms', 'answered', 'missed', 'actions'];
+  const rows = reports.map((r) => [
+    r.recording,
+    String(r.replays),
+    String(r.failures),
+    r.p50Ms.toFixed(2),
+    r.p99Ms.toFixed(2),
+    r.maxMs.toFixed(2),
+    r.answered.toFixed(0),
+    r.missed.toFixed(0),
+    r.dialogActions.toFixed(0),
+  ]);
+  const widths = header.map((h, i) => Math.max(h.length, ...rows.map((row) => row[i].length)));
+  const format = (row: string[]) => row.map((cell, i) => (i === 0 ? cell.padEnd(widths[i]) : cell.padStart(widths[i]))).join('  ');
+  console.log(format(header));
+  console.log(widths.map((w) => '-'.repeat(w)).join('  '));
+  rows.forEach((row) => console.log(format(row)));
+};
+
+const main = async (): Promise<void> => {
+  const reports: ReplayReport[] = [];
+  for (const recording of recordings) {
+    reports.push(await runRecording(recording));
+  }
+
+  const report = {
+    node: process.version,
+    platform: `${process.platform}-${process.arch}`,
+    iterations,
+    warmup,
+    timing,
+    allocAliveCount: allocAliveCount(),
+    recordings: reports,
+  };
+
+  if (json === true) {
+    console.log(JSON.stringify(report, null, 2));
+  } else {
+    if (typeof json === 'string') {
+      fs.writeFileSync(json, JSON.stringify(report, null, 2));
+    }
+    printTable(reports);
+    console.log(`\ntiming: ${timing ? 'recorded' : 'none'}, allocAliveCount: ${report.allocAliveCount}`);
+  }
+};
+
+main().catch((error) => {
+  console.error(error);
+  process.exit(1);
+});
@@ -0,0 +1,215 @@
+#!/usr/bin/env node
+
+/**
+ * Microbenchmarks for the native bindings
+ * Runs against build/Release/modinstaller_bench.node, which links the stub ModInstaller.Native
+ * from bench/stub instead of the .NET library.
+ *
+ * Usage: node bench/run.js [--json] [--addon <path>]
+ */
+
+const path = require("path");
+const { performance } = require("perf_hooks");
+
+const args = process.argv.slice(2);
+const asJson = args.includes("--json");
+const addonIndex = args.indexOf("--addon");
+const addonPath =
+  addonIndex >= 0
+    ? path.resolve(args[addonIndex + 1])
+    : path.join(__dirname, "..", "build", "Release", "modinstaller_bench.node");
+
+const addon = require(addonPath);
+const { bench } = addon;
+
+const SIZES = [16, 256, 4096, 65536];
+const results = [];
+
+/**
+ * Stores a result produced by the native measuring loop
+ */
+function record(name, size, measurement) {
+  results.push({ name, size, ...measurement });
+}
+
+/**
+ * Measures an async operation awaited sequentially from JS
+ */
+async function measureAsync(name, size, iterations, body) {
+  // Warm up the TSFN and the JIT before measuring
+  for (let i = 0; i < Math.min(iterations, 16); i++) {
+    await body();
+  }
+  const start = performance.now();
+  for (let i = 0; i < iterations; i++) {
+    await body();
+  }
+  const totalNs = (performance.now() - start) * 1e6;
+  record(name, size, { iterations, totalNs, nsPerOp: totalNs / iterations });
+}
+
+function iterationsFor(size) {
+  return Math.max(1000, Math.floor(4_000_000 / size));
+}
+
+function runMarshalling() {
+  for (const size of SIZES) {
+    const iterations = iterationsFor(size);
+    record("Copy(u16string)", size, bench.copy(size, iterations));
+    record("Copy(uint8_t*)", size, bench.copyBytes(size, iterations));
+    record("CopyWithFree(u16string)", size, bench.copyWithFree(size, iterations));
+    record("ConvertToJsonResult", size, bench.convertToJsonResult({ data: "x".repeat(size) }, iterations));
+    record("ConvertToDataResult", size, bench.convertToDataResult(Buffer.alloc(size, 0x5a), iterations));
+  }
+  record("Create<T>", 0, bench.create(1_000_000));
+}
+
+/**
+ * Builds file names shaped like a large archive listing
+ */
+function archiveNames(count) {
+  const folders = ["Textures", "Meshes", "Scripts", "Sound", "Interface"];
+  const extensions = [".dds", ".nif", ".pex", ".wav", ".esp", ".esm", ".bsa", ".txt"];
+  const names = [];
+  for (let i = 0; i < count; i++) {
+    const folder = folders[i % folders.length];
+    names.push(`${folder}_Armor_${i.toString(36)}_Body${i % 7 === 0 ? "_1K" : ""}${extensions[i % extensions.length]}`);
+  }
+  return names;
+}
+
+function runGlob() {
+  const names = archiveNames(100_000);
+  const patterns = ["*", "*.esp", "*_?k.dds", "*armor*body*.nif", "textures_*.DDS"];
+  for (const pattern of patterns) {
+    for (const simd of ["scalar", "sse2", "avx2"]) {
+      const measurement = bench.glob(pattern, names, 20, simd);
+      if (measurement === null) continue;
+      // Reported per name rather than per pass over the listing
+      const perName = measurement.iterations * names.length;
+      record(`Glob ${simd} ${pattern}`, names.length, { ...measurement, iterations: perName, nsPerOp: measurement.totalNs / perName });
+    }
+  }
+}
+
+function runLogger() {
+  const logger = new addon.Logger(() => {});
+  addon.Logger.setDefaultCallbacks();
+  for (const size of [64, 1024]) {
+    record("Logger::Log (no sink)", size, bench.loggerLog(size, 100_000));
+  }
+  logger.setCallbacks();
+  for (const size of [64, 1024]) {
+    // Every message from the main thread goes through the JS sink synchronously
+    record("Logger::Log (JS sink)", size, bench.loggerLog(size, 20_000));
+  }
+  addon.Logger.setDefaultCallbacks();
+}
+
+async function runBridges() {
+  const content = Buffer.from("<config/>");
+  const fileSystem = new addon.FileSystem(
+    () => content,
+    () => [],
+    () => [],
+  );
+
+  // Plain async round trip: worker thread -> TSFN -> promise resolution
+  for (const payloadItems of [1, 100]) {
+    bench.configureStub({ delayUs: 0, payloadItems, callbackCalls: 0 });
+    await measureAsync("async round trip", payloadItems, 2000, () =>
+      addon.ModInstaller.testSupportedAsync(["fomod/ModuleConfig.xml"], ["XmlScript"]),
+    );
+  }
+
+  // FileSystem bridge: each call blocks the worker until the JS callback returns
+  fileSystem.setCallbacks();
+  for (const callbackCalls of [1, 16, 128]) {
+    bench.configureStub({ delayUs: 0, payloadItems: 1, callbackCalls });
+    await measureAsync("FileSystem TSFN bridge", callbackCalls, 500, () =>
+      addon.ModInstaller.testSupportedAsync(["fomod/ModuleConfig.xml"], ["XmlScript"]),
+    );
+  }
+  addon.FileSystem.setDefaultCallbacks();
+
+  // ModInstaller bridge: handler callbacks issued from install
+  const installer = new addon.ModInstaller(
+    () => ["plugin.esp"],
+    () => "1.0.0",
+    () => "1.0.0",
+    () => "1.0.0",
+    () => {},
+    () => {},
+    () => {},
+  );
+  for (const callbackCalls of [1, 16, 128]) {
+    bench.configureStub({ delayUs: 0, payloadItems: 10, callbackCalls });
+    await measureAsync("ModInstaller TSFN bridge", callbackCalls, 500, () =>
+      installer.install(["fomod/ModuleConfig.xml"], [], "", "", {}, false, false),
+    );
+  }
+
+  // Per install construction against one instance rebound with reset()
+  const installerCallbacks = [() => ["plugin.esp"], () => "1.0.0", () => "1.0.0", () => "1.0.0", () => {}, () => {}, () => {}];
+  bench.configureStub({ delayUs: 0, payloadItems: 1, callbackCalls: 0 });
+  await measureAsync("new ModInstaller + install", 1, 2000, () =>
+    new addon.ModInstaller(...installerCallbacks).install(["fomod/ModuleConfig.xml"], [], "", "", {}, false, false),
+  );
+  await measureAsync("ModInstaller reset + install", 1, 2000, () => {
+    installer.reset(...installerCallbacks);
+    return installer.install(["fomod/ModuleConfig.xml"], [], "", "", {}, false, false);
+  });
+
+  // Install results: JSON text parsed by JSON.parse against the compact binary layout and the lazy wrapper over it
+  for (const payloadItems of [100, 10000]) {
+    bench.configureStub({ delayUs: 0, payloadItems, callbackCalls: 0 });
+    const iterations = Math.max(20, Math.floor(200_000 / payloadItems));
+    await measureAsync("install result (JSON)", payloadItems, iterations, () =>
+      installer.install(["fomod/ModuleConfig.xml"], [], "", "", {}, false, false),
+    );
+    await measureAsync("install result (compact)", payloadItems, iterations, () =>
+      installer.installCompact(["fomod/ModuleConfig.xml"], [], "", "", {}, false, false),
+    );
+    // Only the length is read, instructions stay native
+    await measureAsync("install result (lazy)", payloadItems, iterations, async () =>
+      (await installer.installLazy(["fomod/ModuleConfig.xml"], [], "", "", {}, false, false)).length,
+    );
+  }
+
+  bench.configureStub({ delayUs: 0, payloadItems: 1, callbackCalls: 0 });
+}
+
+function printTable() {
+  const rows = results.map((r) => [
+    r.name,
+    String(r.size),
+    String(r.iterations),
+    r.nsPerOp.toFixed(1),
+  ]);
+  const header = ["benchmark", "size", "iterations", "ns/op"];
+  const widths = header.map((h, i) => Math.max(h.length, ...rows.map((row) => row[i].length)));
+  const format = (row) => row.map((cell, i) => (i === 0 ? cell.padEnd(widths[i]) : cell.padStart(widths[i]))).join("  ");
+  console.log(format(header));
+  console.log(widths.map((w) => "-".repeat(w)).join("  "));
+  rows.forEach((row) => console.log(format(row)));
+}
+
+async function main() {
+  runMarshalling();
+  runLogger();
+  runGlob();
+  await runBridges();
+
+  const leaked = addon.allocAliveCount();
+  if (asJson) {
+    console.log(JSON.stringify({ results, allocAliveCount: leaked }, null, 2));
+  } else {
+    printTable();
+    console.log(`\nallocAliveCount: ${leaked}`);
+  }
+}
+
+main().catch((error) => {
+  console.error(error);
+  process.exit(1);
+});
@@ -0,0 +1,155 @@
+#!/usr/bin/env node
+
+/**
+ * Concurrency stress test for the TSFN bridges
+ * The stub ModInstaller.Native spawns N threads that each issue M callbacks of mixed types
+ * (readFileContent, readDirectoryFileList, readDirectoryList, log, pluginsGetAll,
+ * contextGetAppVersion) into the bindings, the way the .NET thread pool does during installs.
+ * Reports aggregate callbacks/s, callback latency percentiles and main thread event-loop lag.
+ *
+ * Usage: node bench/stress.js [--threads 1,2,4,8,16,32] [--calls 2000] [--callback-cost-us 0]
+ *                             [--json] [--addon <path>]
+ */
+
+const path = require("path");
+const { monitorEventLoopDelay } = require("perf_hooks");
+
+const args = process.argv.slice(2);
+const option = (name, fallback) => {
+  const index = args.indexOf(name);
+  return index >= 0 && index + 1 < args.length ? args[index + 1] : fallback;
+};
+
+const asJson = args.includes("--json");
+const threadCounts = option("--threads", "1,2,4,8,16,32").split(",").map((t) => parseInt(t, 10));
+const callsPerThread = parseInt(option("--calls", "2000"), 10);
+const callbackCostUs = parseInt(option("--callback-cost-us", "0"), 10);
+const addonPath = path.resolve(
+  option("--addon", path.join(__dirname, "..", "build", "Release", "modinstaller_bench.node")),
+);
+
+const addon = require(addonPath);
+const { bench } = addon;
+
+/**
+ * Simulates the JS side doing work inside a callback
+ */
+function spin() {
+  if (callbackCostUs <= 0) {
+    return;
+  }
+  const end = process.hrtime.bigint() + BigInt(callbackCostUs) * 1000n;
+  while (process.hrtime.bigint() < end) {
+    // busy wait
+  }
+}
+
+function registerCallbacks() {
+  const content = Buffer.from("<config/>");
+  const fileSystem = new addon.FileSystem(
+    () => (spin(), content),
+    () => (spin(), ["fomod/ModuleConfig.xml"]),
+    () => (spin(), ["fomod"]),
+  );
+  fileSystem.setCallbacks();
+
+  const logger = new addon.Logger(() => spin());
+  logger.setCallbacks();
+
+  // The stub issues handler callbacks against the most recently created ModInstaller
+  const installer = new addon.ModInstaller(
+    () => (spin(), ["plugin.esp"]),
+    () => (spin(), "1.0.0"),
+    () => "1.0.0",
+    () => "1.0.0",
+    () => {},
+    () => {},
+    () => {},
+  );
+
+  return { fileSystem, logger, installer };
+}
+
+function restoreDefaults() {
+  addon.FileSystem.setDefaultCallbacks();
+  addon.Logger.setDefaultCallbacks();
+}
+
+const nsToUs = (ns) => ns / 1000;
+const nsToMs = (ns) => ns / 1e6;
+
+async function runOnce(threads) {
+  const histogram = monitorEventLoopDelay({ resolution: 1 });
+  histogram.enable();
+  const result = await bench.stress(threads, callsPerThread);
+  histogram.disable();
+
+  return {
+    ...result,
+    eventLoopLag: {
+      p50Ms: nsToMs(histogram.percentile(50)),
+      p99Ms: nsToMs(histogram.percentile(99)),
+      maxMs: nsToMs(histogram.max),
+    },
+  };
+}
+
+function printTable(results) {
+  const header = ["threads", "callbacks", "cb/s", "p50 us", "p99 us", "p99.9 us", "max us", "lag p99 ms", "lag max ms"];
+  const rows = results.map((r) => [
+    String(r.threads),
+    String(r.callbacks),
+    r.callbacksPerSecond.toFixed(0),
+    nsToUs(r.latency.p50).toFixed(1),
+    nsToUs(r.latency.p99).toFixed(1),
+    nsToUs(r.latency.p999).toFixed(1),
+    nsToUs(r.latency.max).toFixed(1),
+    r.eventLoopLag.p99Ms.toFixed(2),
+    r.eventLoopLag.maxMs.toFixed(2),
+  ]);
+  const widths = header.map((h, i) => Math.max(h.length, ...rows.map((row) => row[i].length)));
+  const format = (row) => row.map((cell, i) => cell.padStart(widths[i])).join("  ");
+  console.log(format(header));
+  console.log(widths.map((w) => "-".repeat(w)).join("  "));
+  rows.forEach((row) => console.log(format(row)));
+}
+
+async function main() {
+  bench.configureStub({ delayUs: 0, payloadItems: 1, callbackCalls: 0 });
+  const callbacks = registerCallbacks();
+
+  const results = [];
+  try {
+    // Warm up the TSFN queues and the JIT
+    await bench.stress(2, 200);
+    for (const threads of threadCounts) {
+      results.push(await runOnce(threads));
+    }
+  } finally {
+    restoreDefaults();
+  }
+
+  const report = {
+    node: process.version,
+    platform: `${process.platform}-${process.arch}`,
+    callsPerThread,
+    callbackCostUs,
+    allocAliveCount: addon.allocAliveCount(),
+    results,
+  };
+
+  if (asJson) {
+    console.log(JSON.stringify(report, null, 2));
+  } else {
+    printTable(results);
+    console.log(`\ncalls/thread: ${callsPerThread}, callback cost: ${callbackCostUs}us, allocAliveCount: ${report.allocAliveCount}`);
+  }
+
+  // Keep the JS callbacks alive until every run has finished
+  void callbacks;
+}
+
+main().catch((error) => {
+  console.error(error);
+  process.exit(1);
+});
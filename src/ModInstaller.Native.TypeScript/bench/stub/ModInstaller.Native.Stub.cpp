@@ -0,0 +1,621 @@
+// Stub implementation of the ModInstaller.Native C ABI, used by the binding benchmarks.
+// Every export answers with synthetic data after a configurable delay; async exports answer
+// from a detached worker thread, the way the .NET thread pool does in the real library.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include "ModInstaller.Native.h"
+
+using namespace ModInstaller::Native;
+
+namespace
+{
+    struct StubConfig
+    {
+        std::atomic<int32_t> delayUs{0};
+        std::atomic<int32_t> payloadItems{1};
+        std::atomic<int32_t> callbackCalls{0};
+    };
+
+    struct FileSystemCallbacks
+    {
+        param_ptr *owner = nullptr;
+        return_value_data *(*readFileContent)(param_ptr *, param_string *, param_int, param_int) = nullptr;
+        return_value_json *(*readDirectoryFileList)(param_ptr *, param_string *, param_string *, param_int) = nullptr;
+        return_value_json *(*readDirectoryList)(param_ptr *, param_string *) = nullptr;
+        return_value_json *(*stat)(param_ptr *, param_string *) = nullptr;
+    };
+
+    struct LoggingCallbacks
+    {
+        param_ptr *owner = nullptr;
+        int32_t (*log)(param_ptr *, param_int, param_string *) = nullptr;
+    };
+
+    struct Handler
+    {
+        param_ptr *owner;
+        return_value_json *(*pluginsGetAll)(param_ptr *, param_bool);
+        return_value_string *(*contextGetAppVersion)(param_ptr *);
+    };
+
+    enum class StressCallback
+    {
+        ReadFileContent,
+        ReadDirectoryFileList,
+        ReadDirectoryList,
+        Log,
+        PluginsGetAll,
+        ContextGetAppVersion,
+        Count
+    };
+
+    const char *const StressCallbackNames[] = {
+        "readFileContent",
+        "readDirectoryFileList",
+        "readDirectoryList",
+        "log",
+        "pluginsGetAll",
+        "contextGetAppVersion",
+    };
+
+    StubConfig Config;
+    std::atomic<int32_t> AliveCount{0};
+    // The most recently created handler, used by stub_stress for the ModInstaller callbacks
+    std::atomic<Handler *> LastHandler{nullptr};
+    // Written once during setup, before any worker thread reads them
+    FileSystemCallbacks FileSystem;
+    LoggingCallbacks Logging;
+
+    void Delay()
+    {
+        const auto delayUs = Config.delayUs.load(std::memory_order_relaxed);
+        if (delayUs > 0)
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds(delayUs));
+        }
+    }
+
+    char16_t *CopyString(const std::string &str)
+    {
+        auto dst = static_cast<char16_t *>(common_alloc((str.size() + 1) * sizeof(char16_t)));
+        for (size_t i = 0; i < str.size(); i++)
+        {
+            dst[i] = static_cast<char16_t>(static_cast<unsigned char>(str[i]));
+        }
+        dst[str.size()] = u'\0';
+        return dst;
+    }
+
+    template <typename T>
+    T *Create(const T val)
+    {
+        auto dst = static_cast<T *>(common_alloc(sizeof(T)));
+        std::memcpy(dst, &val, sizeof(T));
+        return dst;
+    }
+
+    template <typename T>
+    void FreeResult(T *result)
+    {
+        if (result == nullptr)
+        {
+            return;
+        }
+        common_dealloc(result->error);
+        common_dealloc(result->value);
+        common_dealloc(result);
+    }
+
+    size_t CountOccurrences(const char16_t *haystack, const std::u16string &needle)
+    {
+        if (haystack == nullptr)
+        {
+            return 0;
+        }
+        const std::u16string str(haystack);
+        size_t count = 0;
+        for (auto pos = str.find(needle); pos != std::u16string::npos; pos = str.find(needle, pos + needle.size()))
+        {
+            count++;
+        }
+        return count;
+    }
+
+    std::string SupportedResultJson()
+    {
+        std::string json = "{\"supported\":true,\"requiredFiles\":[";
+        const auto items = Config.payloadItems.load(std::memory_order_relaxed);
+        for (int32_t i = 0; i < items; i++)
+        {
+            json += (i == 0 ? "\"" : ",\"") + std::string("fomod/images/image") + std::to_string(i) + ".png\"";
+        }
+        return json + "]}";
+    }
+
+    std::string InstallResultJson()
+    {
+        std::string json = "{\"message\":\"Installation successful\",\"instructions\":[";
+        const auto items = Config.payloadItems.load(std::memory_order_relaxed);
+        for (int32_t i = 0; i < items; i++)
+        {
+            const auto file = "Data/Textures/file" + std::to_string(i) + ".dds";
+            json += (i == 0 ? "" : ",") + std::string("{\"type\":\"copy\",\"source\":\"") + file + "\",\"destination\":\"" + file + "\",\"priority\":0}";
+        }
+        return json + "]}";
+    }
+
+    // The same result as InstallResultJson in the layout of Utils.CompactResult.hpp
+    return_value_data *InstallResultCompact()
+    {
+        std::vector<uint8_t> data;
+        const auto write = [&data](const uint32_t value)
+        {
+            for (int shift = 0; shift < 32; shift += 8)
+            {
+                data.push_back(static_cast<uint8_t>(value >> shift));
+            }
+        };
+        const auto writeString = [&data, &write](const int32_t prefix, const std::string &value)
+        {
+            write(static_cast<uint32_t>(prefix));
+            write(static_cast<uint32_t>(value.size()));
+            data.insert(data.end(), value.begin(), value.end());
+        };
+
+        const auto items = static_cast<uint32_t>(Config.payloadItems.load(std::memory_order_relaxed));
+        write(0x52494d46);
+        write(2);
+        write(items + 3);
+        writeString(-1, "Installation successful");
+        // The directories come first, as the encoder adds a path's prefix before the path
+        writeString(-1, "Data/");
+        writeString(1, "Textures/");
+        for (uint32_t i = 0; i < items; i++)
+        {
+            writeString(2, "file" + std::to_string(i) + ".dds");
+        }
+        write(0);
+        write(items);
+        // copy, no flags, source and destination are the same string, priority 0
+        data.insert(data.end(), static_cast<size_t>(items) * 2, 0);
+        for (int column = 0; column < 2; column++)
+        {
+            for (uint32_t i = 0; i < items; i++)
+            {
+                write(i + 3);
+            }
+        }
+        data.insert(data.end(), static_cast<size_t>(items) * 4, 0);
+        write(0);
+
+        auto value = static_cast<uint8_t *>(common_alloc(data.size()));
+        std::memcpy(value, data.data(), data.size());
+        return Create(return_value_data{nullptr, value, static_cast<int32_t>(data.size())});
+    }
+
+    void IssueFileSystemCallbacks()
+    {
+        const auto calls = Config.callbackCalls.load(std::memory_order_relaxed);
+        if (FileSystem.readFileContent == nullptr)
+        {
+            return;
+        }
+        std::u16string path = u"fomod/ModuleConfig.xml";
+        for (int32_t i = 0; i < calls; i++)
+        {
+            FreeResult(FileSystem.readFileContent(FileSystem.owner, path.data(), 0, -1));
+        }
+    }
+
+    void IssueHandlerCallbacks(Handler *handler)
+    {
+        const auto calls = Config.callbackCalls.load(std::memory_order_relaxed);
+        for (int32_t i = 0; i < calls; i++)
+        {
+            if (i % 2 == 0)
+            {
+                FreeResult(handler->pluginsGetAll(handler->owner, 1));
+            }
+            else
+            {
+                FreeResult(handler->contextGetAppVersion(handler->owner));
+            }
+        }
+    }
+
+    bool IssueStressCallback(const StressCallback type, Handler *handler)
+    {
+        std::u16string path = u"fomod/ModuleConfig.xml";
+        std::u16string directory = u"fomod";
+        std::u16string pattern = u"*";
+        std::u16string message = u"stress";
+        switch (type)
+        {
+        case StressCallback::ReadFileContent:
+            if (FileSystem.readFileContent == nullptr)
+                return false;
+            FreeResult(FileSystem.readFileContent(FileSystem.owner, path.data(), 0, -1));
+            return true;
+        case StressCallback::ReadDirectoryFileList:
+            if (FileSystem.readDirectoryFileList == nullptr)
+                return false;
+            FreeResult(FileSystem.readDirectoryFileList(FileSystem.owner, directory.data(), pattern.data(), 0));
+            return true;
+        case StressCallback::ReadDirectoryList:
+            if (FileSystem.readDirectoryList == nullptr)
+                return false;
+            FreeResult(FileSystem.readDirectoryList(FileSystem.owner, directory.data()));
+            return true;
+        case StressCallback::Log:
+            if (Logging.log == nullptr)
+                return false;
+            Logging.log(Logging.owner, 2, message.data());
+            return true;
+        case StressCallback::PluginsGetAll:
+            if (handler == nullptr)
+                return false;
+            FreeResult(handler->pluginsGetAll(handler->owner, 1));
+            return true;
+        case StressCallback::ContextGetAppVersion:
+            if (handler == nullptr)
+                return false;
+            FreeResult(handler->contextGetAppVersion(handler->owner));
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    std::string LatencyJson(std::vector<int64_t> &latencies)
+    {
+        if (latencies.empty())
+        {
+            return "{\"count\":0,\"p50\":0,\"p90\":0,\"p99\":0,\"p999\":0,\"max\":0}";
+        }
+        std::sort(latencies.begin(), latencies.end());
+        const auto at = [&latencies](const double p)
+        {
+            const auto index = static_cast<size_t>(p * static_cast<double>(latencies.size() - 1));
+            return std::to_string(latencies[index]);
+        };
+        return "{\"count\":" + std::to_string(latencies.size()) +
+               ",\"p50\":" + at(0.5) +
+               ",\"p90\":" + at(0.9) +
+               ",\"p99\":" + at(0.99) +
+               ",\"p999\":" + at(0.999) +
+               ",\"max\":" + std::to_string(latencies.back()) + "}";
+    }
+
+    // Issues calls_per_thread callbacks from each of thread_count threads, cycling through
+    // every callback type that is currently registered. Latencies are in nanoseconds.
+    std::string RunStress(const int32_t threadCount, const int32_t callsPerThread)
+    {
+        constexpr auto typeCount = static_cast<size_t>(StressCallback::Count);
+        const auto handler = LastHandler.load();
+
+        std::vector<std::vector<std::vector<int64_t>>> latencies(threadCount, std::vector<std::vector<int64_t>>(typeCount));
+        std::atomic<int32_t> ready{0};
+        std::atomic<bool> start{false};
+        std::vector<std::thread> threads;
+        threads.reserve(threadCount);
+
+        for (int32_t t = 0; t < threadCount; t++)
+        {
+            threads.emplace_back([t, callsPerThread, handler, &latencies, &ready, &start]()
+                                 {
+                                     ready.fetch_add(1);
+                                     while (!start.load())
+                                     {
+                                         std::this_thread::yield();
+                                     }
+                                     auto &own = latencies[t];
+                                     for (int32_t i = 0; i < callsPerThread; i++)
+                                     {
+                                         // Offset by thread so the threads hit different TSFNs at the same time
+                                         const auto type = static_cast<StressCallback>((i + t) % typeCount);
+                                         const auto begin = std::chrono::steady_clock::now();
+                                         if (IssueStressCallback(type, handler))
+                                         {
+                                             own[static_cast<size_t>(type)].push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count());
+                                         }
+                                     } });
+        }
+
+        while (ready.load() < threadCount)
+        {
+            std::this_thread::yield();
+        }
+        const auto begin = std::chrono::steady_clock::now();
+        start.store(true);
+        for (auto &thread : threads)
+        {
+            thread.join();
+        }
+        const auto elapsedNs = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count();
+
+        std::vector<int64_t> all;
+        std::string perType;
+        for (size_t type = 0; type < typeCount; type++)
+        {
+            std::vector<int64_t> merged;
+            for (auto &own : latencies)
+            {
+                merged.insert(merged.end(), own[type].begin(), own[type].end());
+            }
+            all.insert(all.end(), merged.begin(), merged.end());
+            if (!merged.empty())
+            {
+                perType += (perType.empty() ? "\"" : ",\"") + std::string(StressCallbackNames[type]) + "\":" + LatencyJson(merged);
+            }
+        }
+
+        const auto callbacks = all.size();
+        const auto perSecond = elapsedNs > 0 ? static_cast<double>(callbacks) * 1e9 / static_cast<double>(elapsedNs) : 0.0;
+        return "{\"threads\":" + std::to_string(threadCount) +
+               ",\"callbacks\":" + std::to_string(callbacks) +
+               ",\"elapsedNs\":" + std::to_string(elapsedNs) +
+               ",\"callbacksPerSecond\":" + std::to_string(perSecond) +
+               ",\"latency\":" + LatencyJson(all) +
+               ",\"byType\":{" + perType + "}}";
+    }
+
+    template <typename TResult, typename TWork>
+    return_value_async *RunAsync(param_ptr *p_callback_handler, void (*p_callback)(param_ptr *, TResult *), TWork work)
+    {
+        std::thread([p_callback_handler, p_callback, work]()
+                    { p_callback(p_callback_handler, work()); })
+            .detach();
+        return Create(return_value_async{nullptr});
+    }
+}
+
+namespace ModInstaller::Native
+{
+    extern "C"
+    {
+        void *common_alloc(size_t size)
+        {
+            AliveCount.fetch_add(1, std::memory_order_relaxed);
+            return std::malloc(size);
+        }
+
+        void common_dealloc(param_ptr *ptr)
+        {
+            if (ptr == nullptr)
+            {
+                return;
+            }
+            AliveCount.fetch_sub(1, std::memory_order_relaxed);
+            std::free(ptr);
+        }
+
+        int32_t common_alloc_alive_count()
+        {
+            return AliveCount.load(std::memory_order_relaxed);
+        }
+
+        int32_t set_default_logging_callbacks()
+        {
+            Logging = LoggingCallbacks{};
+            return 0;
+        }
+
+        int32_t set_logging_callbacks(param_ptr *p_owner, int32_t (*p_log)(param_ptr *, param_int, param_string *))
+        {
+            Logging = LoggingCallbacks{p_owner, p_log};
+            return 0;
+        }
+
+        int32_t dispose_default_logger()
+        {
+            return 0;
+        }
+
+        void log_message(param_int level, param_string *message)
+        {
+            // The default logger of the real library writes to a file; the stub drops the message
+            if (Logging.log != nullptr)
+            {
+                Logging.log(Logging.owner, level, message);
+            }
+        }
+
+        int32_t set_default_file_system_callbacks()
+        {
+            FileSystem = FileSystemCallbacks{};
+            return 0;
+        }
+
+        int32_t set_file_system_callbacks(param_ptr *p_owner,
+                                          return_value_data *(*p_read_file_content)(param_ptr *, param_string *, param_int, param_int),
+                                          return_value_json *(*p_read_directory_file_list)(param_ptr *, param_string *, param_string *, param_int),
+                                          return_value_json *(*p_read_directory_list)(param_ptr *, param_string *),
+                                          return_value_json *(*p_stat)(param_ptr *, param_string *),
+                                          return_value_json *(*)(param_ptr *, param_string *),
+                                          return_value_data *(*)(param_ptr *, param_int, param_int, param_int),
+                                          return_value_void *(*)(param_ptr *, param_int))
+        {
+            FileSystem = FileSystemCallbacks{p_owner, p_read_file_content, p_read_directory_file_list, p_read_directory_list, p_stat};
+            return 0;
+        }
+
+        return_value_ptr *create_handler(param_ptr *p_owner,
+                                         return_value_json *(*p_plugins_get_all)(param_ptr *, param_bool),
+                                         return_value_string *(*p_context_get_app_version)(param_ptr *),
+                                         return_value_string *(*)(param_ptr *),
+                                         return_value_string *(*)(param_ptr *, param_string *),
+                                         return_value_void *(*)(param_ptr *, param_string *, param_json *, param_ptr *,
+                                                                void (*)(param_ptr *, param_int, param_int, param_json *, return_value_void *),
+                                                                void (*)(param_ptr *, param_bool, param_int, return_value_void *),
+                                                                void (*)(param_ptr *, return_value_void *)),
+                                         return_value_void *(*)(param_ptr *),
+                                         return_value_void *(*)(param_ptr *, param_json *, param_int))
+        {
+            const auto handler = new Handler{p_owner, p_plugins_get_all, p_context_get_app_version};
+            LastHandler.store(handler);
+            return Create(return_value_ptr{nullptr, handler});
+        }
+
+        return_value_void *dispose_handler(param_ptr *p_handle)
+        {
+            auto expected = static_cast<Handler *>(p_handle);
+            LastHandler.compare_exchange_strong(expected, nullptr);
+            delete static_cast<Handler *>(p_handle);
+            return Create(return_value_void{nullptr});
+        }
+
+        return_value_json *test_supported(param_json *, param_json *)
+        {
+            Delay();
+            return Create(return_value_json{nullptr, CopyString(SupportedResultJson())});
+        }
+
+        return_value_async *test_supported_async(param_json *, param_json *,
+                                                 param_ptr *p_callback_handler,
+                                                 void (*p_callback)(param_ptr *, return_value_json *))
+        {
+            return RunAsync(p_callback_handler, p_callback, []()
+                            {
+                                Delay();
+                                IssueFileSystemCallbacks();
+                                return Create(return_value_json{nullptr, CopyString(SupportedResultJson())}); });
+        }
+
+        return_value_async *test_supported_many(param_json *p_requests,
+                                                param_ptr *p_callback_handler,
+                                                void (*p_callback)(param_ptr *, return_value_json *))
+        {
+            // the input is only valid for the duration of the call
+            const auto count = CountOccurrences(p_requests, u"\"files\"");
+            return RunAsync(p_callback_handler, p_callback, [count]()
+                            {
+                                Delay();
+                                std::string json = "[";
+                                for (size_t i = 0; i < count; i++)
+                                {
+                                    json += (i == 0 ? "" : ",") + SupportedResultJson();
+                                }
+                                return Create(return_value_json{nullptr, CopyString(json + "]")}); });
+        }
+
+        return_value_async *install(param_ptr *p_handle,
+                                    param_json *, param_json *, param_string *, param_string *, param_json *,
+                                    param_bool, param_bool, param_bool,
+                                    param_ptr *p_callback_handler,
+                                    void (*p_callback)(param_ptr *, return_value_json *))
+        {
+            if (p_handle == nullptr)
+            {
+                return Create(return_value_async{CopyString("Handler is null or wrong!")});
+            }
+            const auto handler = static_cast<Handler *>(p_handle);
+            return RunAsync(p_callback_handler, p_callback, [handler]()
+                            {
+                                Delay();
+                                IssueHandlerCallbacks(handler);
+                                IssueFileSystemCallbacks();
+                                return Create(return_value_json{nullptr, CopyString(InstallResultJson())}); });
+        }
+
+        return_value_async *install_compact(param_ptr *p_handle,
+                                            param_json *, param_json *, param_string *, param_string *, param_json *,
+                                            param_bool, param_bool, param_bool,
+                                            param_ptr *p_callback_handler,
+                                            void (*p_callback)(param_ptr *, return_value_data *))
+        {
+            if (p_handle == nullptr)
+            {
+                return Create(return_value_async{CopyString("Handler is null or wrong!")});
+            }
+            const auto handler = static_cast<Handler *>(p_handle);
+            return RunAsync(p_callback_handler, p_callback, [handler]()
+                            {
+                                Delay();
+                                IssueHandlerCallbacks(handler);
+                                IssueFileSystemCallbacks();
+                                return InstallResultCompact(); });
+        }
+
+        return_value_async *precompile_script(param_string *, param_bool,
+                                              param_ptr *p_callback_handler,
+                                              void (*p_callback)(param_ptr *, return_value_bool *))
+        {
+            return RunAsync(p_callback_handler, p_callback, []()
+                            {
+                                Delay();
+                                return Create(return_value_bool{nullptr, 1}); });
+        }
+
+        return_value_void *clear_script_cache()
+        {
+            return Create(return_value_void{nullptr});
+        }
+
+        return_value_void *set_script_cache_directory(param_string *)
+        {
+            return Create(return_value_void{nullptr});
+        }
+
+        return_value_json *script_cache_stats()
+        {
+            return Create(return_value_json{nullptr, CopyString("{\"count\":0,\"bytes\":0,\"capacity\":0,\"hits\":0,\"misses\":0,\"evictions\":0,\"diskHits\":0,\"diskWrites\":0}")});
+        }
+
+        return_value_void *set_image_prefetch_capacity(param_int)
+        {
+            return Create(return_value_void{nullptr});
+        }
+
+        return_value_data *get_image(param_ptr *, param_string *)
+        {
+            // Nothing is ever prefetched
+            return Create(return_value_data{nullptr, nullptr, 0});
+        }
+
+        return_value_json *image_prefetch_stats(param_ptr *)
+        {
+            return Create(return_value_json{nullptr, CopyString("{\"count\":0,\"bytes\":0,\"capacity\":0,\"hits\":0,\"misses\":0,\"evictions\":0,\"reads\":0,\"failures\":0,\"pending\":0}")});
+        }
+
+        return_value_async *warmup(param_json *,
+                                   param_ptr *p_callback_handler,
+                                   void (*p_callback)(param_ptr *, return_value_json *))
+        {
+            return RunAsync(p_callback_handler, p_callback, []()
+                            {
+                                Delay();
+                                return Create(return_value_json{nullptr, CopyString("{\"schemas\":0,\"scriptTypes\":0,\"logger\":0,\"serializers\":0,\"total\":0}")}); });
+        }
+
+        return_value_json *configure_runtime(param_json *)
+        {
+            return Create(return_value_json{nullptr, CopyString("{\"minThreads\":1,\"maxThreads\":32767,\"threadCount\":0,\"gcServer\":false,\"gcConserveMemory\":0}")});
+        }
+
+        void stub_configure(param_int delay_us, param_int payload_items, param_int callback_calls)
+        {
+            Config.delayUs.store(delay_us, std::memory_order_relaxed);
+            Config.payloadItems.store(payload_items, std::memory_order_relaxed);
+            Config.callbackCalls.store(callback_calls, std::memory_order_relaxed);
+        }
+
+        return_value_async *stub_stress(param_int thread_count, param_int calls_per_thread,
+                                        param_ptr *p_callback_handler,
+                                        void (*p_callback)(param_ptr *, return_value_json *))
+        {
+            if (thread_count <= 0 || calls_per_thread < 0)
+            {
+                return Create(return_value_async{CopyString("thread_count must be positive and calls_per_thread not negative")});
+            }
+            return RunAsync(p_callback_handler, p_callback, [thread_count, calls_per_thread]()
+                            { return Create(return_value_json{nullptr, CopyString(RunStress(thread_count, calls_per_thread))}); });
+        }
+    }
+}
@@ -0,0 +1,133 @@
+#ifndef VE_MODINSTALLER_NATIVE_STUB_H_
+#define VE_MODINSTALLER_NATIVE_STUB_H_
+
+// Stand-in for the header generated by the NativeAOT build of ModInstaller.Native.
+// It declares the same C ABI so the bindings in src-native compile unchanged against
+// ModInstaller.Native.Stub.cpp instead of the real library. Keep it in sync with the
+// exports in src/ModInstaller.Native/Bindings.*.cs.
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ModInstaller::Native
+{
+    extern "C"
+    {
+        typedef void param_ptr;
+        typedef char16_t param_string;
+        typedef char16_t param_json;
+        typedef int32_t param_int;
+        typedef uint32_t param_uint;
+        typedef uint8_t param_bool;
+
+        typedef struct return_value_void { char16_t *error; } return_value_void;
+        typedef struct return_value_async { char16_t *error; } return_value_async;
+        typedef struct return_value_string { char16_t *error; char16_t *value; } return_value_string;
+        typedef struct return_value_json { char16_t *error; char16_t *value; } return_value_json;
+        typedef struct return_value_data { char16_t *error; uint8_t *value; int32_t length; } return_value_data;
+        typedef struct return_value_bool { char16_t *error; uint8_t value; } return_value_bool;
+        typedef struct return_value_int32 { char16_t *error; int32_t value; } return_value_int32;
+        typedef struct return_value_uint32 { char16_t *error; uint32_t value; } return_value_uint32;
+        typedef struct return_value_ptr { char16_t *error; void *value; } return_value_ptr;
+
+        // Common
+        void *common_alloc(size_t size);
+        void common_dealloc(param_ptr *ptr);
+        int32_t common_alloc_alive_count();
+
+        // Logging
+        int32_t set_default_logging_callbacks();
+        int32_t set_logging_callbacks(param_ptr *p_owner,
+                                      int32_t (*p_log)(param_ptr *, param_int, param_string *));
+        int32_t dispose_default_logger();
+        void log_message(param_int level, param_string *message);
+
+        // FileSystem
+        int32_t set_default_file_system_callbacks();
+        int32_t set_file_system_callbacks(param_ptr *p_owner,
+                                          return_value_data *(*p_read_file_content)(param_ptr *, param_string *, param_int, param_int),
+                                          return_value_json *(*p_read_directory_file_list)(param_ptr *, param_string *, param_string *, param_int),
+                                          return_value_json *(*p_read_directory_list)(param_ptr *, param_string *),
+                                          return_value_json *(*p_stat)(param_ptr *, param_string *),
+                                          return_value_json *(*p_open_file)(param_ptr *, param_string *),
+                                          return_value_data *(*p_read_file)(param_ptr *, param_int, param_int, param_int),
+                                          return_value_void *(*p_close_file)(param_ptr *, param_int));
+
+        // ModInstaller
+        return_value_ptr *create_handler(param_ptr *p_owner,
+                                         return_value_json *(*p_plugins_get_all)(param_ptr *, param_bool),
+                                         return_value_string *(*p_context_get_app_version)(param_ptr *),
+                                         return_value_string *(*p_context_get_current_game_version)(param_ptr *),
+                                         return_value_string *(*p_context_get_extender_version)(param_ptr *, param_string *),
+                                         return_value_void *(*p_ui_start_dialog)(param_ptr *, param_string *, param_json *, param_ptr *,
+                                                                                 void (*)(param_ptr *, param_int, param_int, param_json *, return_value_void *),
+                                                                                 void (*)(param_ptr *, param_bool, param_int, return_value_void *),
+                                                                                 void (*)(param_ptr *, return_value_void *)),
+                                         return_value_void *(*p_ui_end_dialog)(param_ptr *),
+                                         return_value_void *(*p_ui_update_state)(param_ptr *, param_json *, param_int));
+        return_value_void *dispose_handler(param_ptr *p_handle);
+        return_value_json *test_supported(param_json *p_mod_archive_file_list, param_json *p_allowed_types);
+        return_value_async *test_supported_async(param_json *p_mod_archive_file_list, param_json *p_allowed_types,
+                                                 param_ptr *p_callback_handler,
+                                                 void (*p_callback)(param_ptr *, return_value_json *));
+        return_value_async *test_supported_many(param_json *p_requests,
+                                                param_ptr *p_callback_handler,
+                                                void (*p_callback)(param_ptr *, return_value_json *));
+        return_value_async *install(param_ptr *p_handle,
+                                    param_json *p_mod_archive_file_list,
+                                    param_json *p_stop_patterns,
+                                    param_string *p_plugin_path,
+                                    param_string *p_script_path,
+                                    param_json *p_preset,
+                                    param_bool preselect,
+                                    param_bool validate,
+                                    param_bool headless,
+                                    param_ptr *p_callback_handler,
+                                    void (*p_callback)(param_ptr *, return_value_json *));
+        return_value_async *install_compact(param_ptr *p_handle,
+                                            param_json *p_mod_archive_file_list,
+                                            param_json *p_stop_patterns,
+                                            param_string *p_plugin_path,
+                                            param_string *p_script_path,
+                                            param_json *p_preset,
+                                            param_bool preselect,
+                                            param_bool validate,
+                                            param_bool headless,
+                                            param_ptr *p_callback_handler,
+                                            void (*p_callback)(param_ptr *, return_value_data *));
+
+        // ScriptCache
+        return_value_async *precompile_script(param_string *p_script_path, param_bool validate,
+                                              param_ptr *p_callback_handler,
+                                              void (*p_callback)(param_ptr *, return_value_bool *));
+        return_value_void *clear_script_cache();
+        return_value_void *set_script_cache_directory(param_string *p_directory);
+        return_value_json *script_cache_stats();
+
+        // ImagePrefetch
+        return_value_void *set_image_prefetch_capacity(param_int capacity);
+        return_value_data *get_image(param_ptr *p_handle, param_string *p_path);
+        return_value_json *image_prefetch_stats(param_ptr *p_handle);
+
+        // Runtime
+        return_value_async *warmup(param_json *p_options,
+                                   param_ptr *p_callback_handler,
+                                   void (*p_callback)(param_ptr *, return_value_json *));
+        return_value_json *configure_runtime(param_json *p_options);
+
+        // Stub only: shapes the simulated work of every export.
+        //   delay_us        - time spent "in .NET" before an export answers
+        //   payload_items   - number of entries in returned lists (required files, instructions)
+        //   callback_calls  - callbacks issued into the bindings before an async export completes
+        void stub_configure(param_int delay_us, param_int payload_items, param_int callback_calls);
+
+        // Stub only: spawns thread_count threads that each issue calls_per_thread callbacks of mixed
+        // types (file system, logging and the most recently created handler) and reports the
+        // aggregate rate and latency percentiles as JSON.
+        return_value_async *stub_stress(param_int thread_count, param_int calls_per_thread,
+                                        param_ptr *p_callback_handler,
+                                        void (*p_callback)(param_ptr *, return_value_json *));
+    }
+}
+
+#endif
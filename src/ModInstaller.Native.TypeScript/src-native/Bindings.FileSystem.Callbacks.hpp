@@ -1,13 +1,15 @@
 #ifndef VE_FILESYSTEM_CB_GUARD_HPP_
 #define VE_FILESYSTEM_CB_GUARD_HPP_
 
-#include <mutex>
-#include <condition_variable>
+#include <algorithm>
 #include <thread>
 #include "ModInstaller.Native.h"
 #include "Logger.hpp"
 #include "Utils.Converters.hpp"
 #include "Utils.Callbacks.hpp"
+#include "Utils.Watchdog.hpp"
+#include "Utils.DirectorySnapshot.hpp"
+#include "Utils.FileHandles.hpp"
 #include "Bindings.FileSystem.hpp"
 
 using namespace Napi;
@@ -42,33 +44,31 @@ namespace Bindings::FileSystem
                 // So we need to use the ThreadSafeFunction to marshal the call to the main JS thread
                 // and wait for the result synchronously
 
-                std::mutex mtx;
-                std::condition_variable cv;
-                bool completed = false;
-                return_value_data *result = nullptr;
+                const auto call = Watchdog::PendingCall<return_value_data *>::New(Watchdog::Category::FileSystem, functionName);
 
-                const auto callback = [functionName, manager, p_file_path, v_offset, v_length, &result, &mtx, &cv, &completed](Napi::Env env, Napi::Function jsCallback)
+                const auto callback = [functionName, manager, p_file_path, v_offset, v_length, call](Napi::Env env, Napi::Function jsCallback)
                 {
                     LoggerScope callbackLogger(NAMEOFWITHCALLBACK(functionName, callback));
                     try
                     {
+                        auto started = call->Start();
+                        if (!started)
+                        {
+                            return;
+                        }
+
                         const auto filePath = String::New(env, p_file_path);
                         const auto offset = Number::New(env, v_offset);
                         const auto length = Number::New(env, v_length);
+                        started.unlock();
                         const auto jsResult = jsCallback({filePath, offset, length});
 
-                        std::lock_guard<std::mutex> lock(mtx);
-                        result = ConvertToDataResult(jsResult);
-                        completed = true;
-                        cv.notify_one();
+                        call->Complete(ConvertToDataResult(jsResult));
                     }
                     catch (const Napi::Error &e)
                     {
                         callbackLogger.LogError(e);
-                        std::lock_guard<std::mutex> lock(mtx);
-                        result = Create(return_value_data{Copy(GetErrorMessage(e)), nullptr, 0});
-                        completed = true;
-                        cv.notify_one();
+                        call->Complete(Create(return_value_data{Copy(GetErrorMessage(e)), nullptr, 0}));
                     }
                 };
 
@@ -79,10 +79,7 @@ namespace Bindings::FileSystem
                     return Create(return_value_data{Copy(u"Failed to queue async call"), nullptr, 0});
                 }
 
-                std::unique_lock<std::mutex> lock(mtx);
-                cv.wait(lock, [&completed]
-                        { return completed; });
-
+                const auto result = call->Wait();
                 logger.Log("Blocking call completed");
                 return result;
             }
@@ -105,6 +102,13 @@ namespace Bindings::FileSystem
         }
     }
 
+    static DirectorySnapshots::Loader SnapshotLoader(param_ptr *p_owner);
+
+    static return_value_json *SnapshotResult(const SnapshotAnswer &answer)
+    {
+        return Create(return_value_json{nullptr, answer.json.empty() ? nullptr : Copy(answer.json)});
+    }
+
     static return_value_json *readDirectoryFileList(param_ptr *p_owner,
                                                     param_string *p_directory_path,
                                                     param_string *p_pattern,
@@ -116,6 +120,12 @@ namespace Bindings::FileSystem
         {
             auto manager = const_cast<Bindings::FileSystem::FileSystem *>(static_cast<const Bindings::FileSystem::FileSystem *>(p_owner));
 
+            const auto snapshot = manager->Snapshots.ReadDirectoryFileList(p_directory_path, p_pattern, search_type, SnapshotLoader(p_owner));
+            if (snapshot.answered)
+            {
+                return SnapshotResult(snapshot);
+            }
+
             if (std::this_thread::get_id() == manager->MainThreadId)
             {
                 const auto env = manager->FReadDirectoryFileList.Env();
@@ -131,33 +141,31 @@ namespace Bindings::FileSystem
                 // So we need to use the ThreadSafeFunction to marshal the call to the main JS thread
                 // and wait for the result synchronously
 
-                std::mutex mtx;
-                std::condition_variable cv;
-                bool completed = false;
-                return_value_json *result = nullptr;
+                const auto call = Watchdog::PendingCall<return_value_json *>::New(Watchdog::Category::FileSystem, functionName);
 
-                const auto callback = [functionName, manager, p_directory_path, p_pattern, search_type, &result, &mtx, &cv, &completed](Napi::Env env, Napi::Function jsCallback)
+                const auto callback = [functionName, manager, p_directory_path, p_pattern, search_type, call](Napi::Env env, Napi::Function jsCallback)
                 {
                     LoggerScope callbackLogger(NAMEOFWITHCALLBACK(functionName, callback));
                     try
                     {
+                        auto started = call->Start();
+                        if (!started)
+                        {
+                            return;
+                        }
+
                         const auto directoryPath = String::New(env, p_directory_path);
                         const auto pattern = p_pattern == nullptr ? env.Null() : String::New(env, p_pattern);
                         const auto searchType = Number::New(env, search_type);
+                        started.unlock();
                         const auto jsResult = jsCallback({directoryPath, pattern, searchType});
 
-                        std::lock_guard<std::mutex> lock(mtx);
-                        result = ConvertToJsonResult(jsResult);
-                        completed = true;
-                        cv.notify_one();
+                        call->Complete(ConvertToJsonResult(jsResult));
                     }
                     catch (const Napi::Error &e)
                     {
                         callbackLogger.LogError(e);
-                        std::lock_guard<std::mutex> lock(mtx);
-                        result = Create(return_value_json{Copy(GetErrorMessage(e)), nullptr});
-                        completed = true;
-                        cv.notify_one();
+                        call->Complete(Create(return_value_json{Copy(GetErrorMessage(e)), nullptr}));
                     }
                 };
 
@@ -168,10 +176,7 @@ namespace Bindings::FileSystem
                     return Create(return_value_json{Copy(u"Failed to queue async call"), nullptr});
                 }
 
-                std::unique_lock<std::mutex> lock(mtx);
-                cv.wait(lock, [&completed]
-                        { return completed; });
-
+                const auto result = call->Wait();
                 logger.Log("Blocking call completed");
                 return result;
             }
@@ -216,31 +221,29 @@ namespace Bindings::FileSystem
                 // So we need to use the ThreadSafeFunction to marshal the call to the main JS thread
                 // and wait for the result synchronously
 
-                std::mutex mtx;
-                std::condition_variable cv;
-                bool completed = false;
-                return_value_json *result = nullptr;
+                const auto call = Watchdog::PendingCall<return_value_json *>::New(Watchdog::Category::FileSystem, functionName);
 
-                const auto callback = [functionName, manager, p_directory_path, &result, &mtx, &cv, &completed](Napi::Env env, Napi::Function jsCallback)
+                const auto callback = [functionName, manager, p_directory_path, call](Napi::Env env, Napi::Function jsCallback)
                 {
                     LoggerScope callbackLogger(NAMEOFWITHCALLBACK(functionName, callback));
                     try
                     {
+                        auto started = call->Start();
+                        if (!started)
+                        {
+                            return;
+                        }
+
                         const auto directoryPath = p_directory_path == nullptr ? env.Null() : String::New(env, p_directory_path);
+                        started.unlock();
                         const auto jsResult = jsCallback({directoryPath});
 
-                        std::lock_guard<std::mutex> lock(mtx);
-                        result = ConvertToJsonResult(jsResult);
-                        completed = true;
-                        cv.notify_one();
+                        call->Complete(ConvertToJsonResult(jsResult));
                     }
                     catch (const Napi::Error &e)
                     {
                         callbackLogger.LogError(e);
-                        std::lock_guard<std::mutex> lock(mtx);
-                        result = Create(return_value_json{Copy(GetErrorMessage(e)), nullptr});
-                        completed = true;
-                        cv.notify_one();
+                        call->Complete(Create(return_value_json{Copy(GetErrorMessage(e)), nullptr}));
                     }
                 };
 
@@ -251,10 +254,91 @@ namespace Bindings::FileSystem
                     return Create(return_value_json{Copy(u"Failed to queue async call"), nullptr});
                 }
 
-                std::unique_lock<std::mutex> lock(mtx);
-                cv.wait(lock, [&completed]
-                        { return completed; });
+                const auto result = call->Wait();
+                logger.Log("Blocking call completed");
+                return result;
+            }
+        }
+        catch (const Napi::Error &e)
+        {
+            logger.LogError(e);
+            return Create(return_value_json{Copy(GetErrorMessage(e)), nullptr});
+        }
+        catch (const std::exception &e)
+        {
+            logger.LogException(e);
+            std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t> conv;
+            return Create(return_value_json{Copy(conv.from_bytes(e.what())), nullptr});
+        }
+        catch (...)
+        {
+            logger.Log("Unknown exception");
+            return Create(return_value_json{Copy(u"Unknown exception"), nullptr});
+        }
+    }
+
+    static return_value_json *stat(param_ptr *p_owner,
+                                   param_string *p_path) noexcept
+    {
+        const auto functionName = __FUNCTION__;
+        LoggerScope logger(functionName);
+        try
+        {
+            auto manager = const_cast<Bindings::FileSystem::FileSystem *>(static_cast<const Bindings::FileSystem::FileSystem *>(p_owner));
 
+            const auto snapshot = manager->Snapshots.Stat(p_path);
+            if (snapshot.answered)
+            {
+                return SnapshotResult(snapshot);
+            }
+
+            if (std::this_thread::get_id() == manager->MainThreadId)
+            {
+                const auto env = manager->FStat.Env();
+                const auto path = String::New(env, p_path);
+                const auto jsResult = manager->FStat({path});
+                return ConvertToJsonResult(jsResult);
+            }
+            else
+            {
+                // The C# async function called from a non-main JS thread
+                // So we need to use the ThreadSafeFunction to marshal the call to the main JS thread
+                // and wait for the result synchronously
+
+                const auto call = Watchdog::PendingCall<return_value_json *>::New(Watchdog::Category::FileSystem, functionName);
+
+                const auto callback = [functionName, p_path, call](Napi::Env env, Napi::Function jsCallback)
+                {
+                    LoggerScope callbackLogger(NAMEOFWITHCALLBACK(functionName, callback));
+                    try
+                    {
+                        auto started = call->Start();
+                        if (!started)
+                        {
+                            return;
+                        }
+
+                        const auto path = String::New(env, p_path);
+                        started.unlock();
+                        const auto jsResult = jsCallback({path});
+
+                        call->Complete(ConvertToJsonResult(jsResult));
+                    }
+                    catch (const Napi::Error &e)
+                    {
+                        callbackLogger.LogError(e);
+                        call->Complete(Create(return_value_json{Copy(GetErrorMessage(e)), nullptr}));
+                    }
+                };
+
+                const auto status = manager->TSFNStat.BlockingCall(callback);
+                if (status != napi_ok)
+                {
+                    logger.Log("BlockingCall failed with status: " + std::to_string(status));
+                    return Create(return_value_json{Copy(u"Failed to queue async call"), nullptr});
+                }
+
+                const auto result = call->Wait();
                 logger.Log("Blocking call completed");
                 return result;
             }
@@ -276,5 +360,155 @@ namespace Bindings::FileSystem
             return Create(return_value_json{Copy(u"Unknown exception"), nullptr});
         }
     }
+
+    // Handle protocol on top of the path based Read and Stat callbacks
+    // Without Stat the file is probed with a zero length read and its size stays unknown
+    template <return_value_data *(*Read)(param_ptr *, param_string *, param_int, param_int),
+              return_value_json *(*Stat)(param_ptr *, param_string *)>
+    static return_value_json *openFile(param_ptr *p_owner,
+                                       param_string *p_file_path) noexcept
+    {
+        LoggerScope logger(__FUNCTION__);
+        try
+        {
+            int64_t size = -1;
+            if constexpr (Stat == nullptr)
+            {
+                const std::unique_ptr<return_value_data, common_deallocor<return_value_data>> result{Read(p_owner, p_file_path, 0, 0)};
+                if (result == nullptr)
+                {
+                    return Create(return_value_json{Copy(u"No result"), nullptr});
+                }
+
+                const std::unique_ptr<uint8_t[], common_deallocor<uint8_t>> value{result->value};
+                if (result->error != nullptr)
+                {
+                    return Create(return_value_json{result->error, nullptr});
+                }
+                if (value == nullptr)
+                {
+                    return Create(return_value_json{nullptr, nullptr});
+                }
+            }
+            else
+            {
+                const del_json result{Stat(p_owner, p_file_path)};
+                if (result == nullptr)
+                {
+                    return Create(return_value_json{Copy(u"No result"), nullptr});
+                }
+
+                const std::unique_ptr<char16_t[], common_deallocor<char16_t>> value{result->value};
+                if (result->error != nullptr)
+                {
+                    return Create(return_value_json{result->error, nullptr});
+                }
+                if (!FileHandles::ParseFileStat(value.get(), size))
+                {
+                    return Create(return_value_json{nullptr, nullptr});
+                }
+            }
+
+            const auto handle = FileHandles::Instance().Open(p_file_path, size);
+            const auto handleText = std::to_string(handle);
+            const auto sizeText = std::to_string(size);
+            const auto json = u"{\"handle\":" + std::u16string(handleText.begin(), handleText.end()) +
+                              u",\"size\":" + std::u16string(sizeText.begin(), sizeText.end()) + u"}";
+            return Create(return_value_json{nullptr, Copy(json)});
+        }
+        catch (const std::exception &e)
+        {
+            logger.LogException(e);
+            std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t> conv;
+            return Create(return_value_json{Copy(conv.from_bytes(e.what())), nullptr});
+        }
+        catch (...)
+        {
+            logger.Log("Unknown exception");
+            return Create(return_value_json{Copy(u"Unknown exception"), nullptr});
+        }
+    }
+
+    template <return_value_data *(*Read)(param_ptr *, param_string *, param_int, param_int)>
+    static return_value_data *readFile(param_ptr *p_owner,
+                                       param_int v_handle,
+                                       param_int v_offset,
+                                       param_int v_length) noexcept
+    {
+        LoggerScope logger(__FUNCTION__);
+        try
+        {
+            FileHandle file;
+            if (!FileHandles::Instance().Find(v_handle, file))
+            {
+                return Create(return_value_data{Copy(u"Unknown file handle"), nullptr, 0});
+            }
+
+            // Never ask the host for bytes past the end, some hosts throw instead of returning less
+            auto length = v_length;
+            if (file.size >= 0 && (length < 0 || v_offset + static_cast<int64_t>(length) > file.size))
+            {
+                length = static_cast<param_int>(std::max<int64_t>(0, file.size - v_offset));
+            }
+
+            return Read(p_owner, const_cast<param_string *>(file.path.c_str()), v_offset, length);
+        }
+        catch (const std::exception &e)
+        {
+            logger.LogException(e);
+            std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t> conv;
+            return Create(return_value_data{Copy(conv.from_bytes(e.what())), nullptr, 0});
+        }
+        catch (...)
+        {
+            logger.Log("Unknown exception");
+            return Create(return_value_data{Copy(u"Unknown exception"), nullptr, 0});
+        }
+    }
+
+    static return_value_void *closeFile(param_ptr *p_owner,
+                                        param_int v_handle) noexcept
+    {
+        LoggerScope logger(__FUNCTION__);
+        try
+        {
+            FileHandles::Instance().Close(v_handle);
+            return Create(return_value_void{nullptr});
+        }
+        catch (const std::exception &e)
+        {
+            logger.LogException(e);
+            std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t> conv;
+            return Create(return_value_void{Copy(conv.from_bytes(e.what()))});
+        }
+        catch (...)
+        {
+            logger.Log("Unknown exception");
+            return Create(return_value_void{Copy(u"Unknown exception")});
+        }
+    }
+
+    // Lists the snapshot root recursively with a single call into JS
+    static DirectorySnapshots::Loader SnapshotLoader(param_ptr *p_owner)
+    {
+        return [p_owner](const std::u16string &root, bool &exists, std::vector<std::u16string> &files)
+        {
+            const del_json result{readDirectoryFileList(p_owner, const_cast<param_string *>(root.c_str()), const_cast<param_string *>(u"*"), 1)};
+            if (result == nullptr)
+            {
+                return false;
+            }
+
+            const std::unique_ptr<char16_t[], common_deallocor<char16_t>> error{result->error};
+            const std::unique_ptr<char16_t[], common_deallocor<char16_t>> value{result->value};
+            if (error != nullptr)
+            {
+                return false;
+            }
+
+            exists = DirectorySnapshot::ParseJsonStringArray(value.get(), files);
+            return exists || value == nullptr;
+        };
+    }
 }
 #endif
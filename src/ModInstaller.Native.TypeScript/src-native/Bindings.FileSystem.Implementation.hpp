@@ -4,6 +4,7 @@
 #include <thread>
 #include "ModInstaller.Native.h"
 #include "Logger.hpp"
+#include "Utils.Recording.hpp"
 #include "Bindings.FileSystem.hpp"
 #include "Bindings.FileSystem.Callbacks.hpp"
 
@@ -20,6 +21,7 @@ namespace Bindings::FileSystem
                                       {
                                           InstanceMethod<&FileSystem::SetCallbacks>("setCallbacks", static_cast<napi_property_attributes>(napi_writable | napi_configurable)),
                                           StaticMethod<&FileSystem::SetDefaultCallbacks>("setDefaultCallbacks", static_cast<napi_property_attributes>(napi_writable | napi_configurable)),
+                                          StaticMethod<&FileSystem::SetDirectorySnapshots>("setDirectorySnapshots", static_cast<napi_property_attributes>(napi_writable | napi_configurable)),
                                       });
 
         auto *const constructor = new FunctionReference();
@@ -57,6 +59,14 @@ namespace Bindings::FileSystem
         this->TSFNReadDirectoryFileList = Napi::ThreadSafeFunction::New(env, this->FReadDirectoryFileList.Value(), "ReadDirectoryFileList", 0, 1);
         this->TSFNReadDirectoryList = Napi::ThreadSafeFunction::New(env, this->FReadDirectoryList.Value(), "ReadDirectoryList", 0, 1);
 
+        // The stat callback is optional, without it ModInstaller.Native probes with the other callbacks
+        if (info.Length() > 3 && info[3].IsFunction())
+        {
+            this->FStat = Persistent(info[3].As<Function>());
+            this->TSFNStat = Napi::ThreadSafeFunction::New(env, this->FStat.Value(), "Stat", 0, 1);
+            this->HasStat = true;
+        }
+
         this->MainThreadId = std::this_thread::get_id();
     }
 
@@ -68,11 +78,19 @@ namespace Bindings::FileSystem
         this->TSFNReadFileContent.Release();
         this->TSFNReadDirectoryFileList.Release();
         this->TSFNReadDirectoryList.Release();
+        if (this->HasStat)
+        {
+            this->TSFNStat.Release();
+        }
 
         // Release function references
         this->FReadFileContent.Unref();
         this->FReadDirectoryList.Unref();
         this->FReadDirectoryFileList.Unref();
+        if (this->HasStat)
+        {
+            this->FStat.Unref();
+        }
     }
 
     void FileSystem::SetDefaultCallbacks(const CallbackInfo &info)
@@ -108,6 +126,33 @@ namespace Bindings::FileSystem
         }
     }
 
+    void FileSystem::SetDirectorySnapshots(const CallbackInfo &info)
+    {
+        LoggerScope logger(__FUNCTION__);
+
+        try
+        {
+            const auto enabled = info[0].As<Boolean>().Value();
+
+            DirectorySnapshots::SetEnabled(enabled);
+        }
+        catch (const Napi::Error &e)
+        {
+            logger.LogError(e);
+            throw;
+        }
+        catch (const std::exception &e)
+        {
+            logger.LogException(e);
+            throw;
+        }
+        catch (...)
+        {
+            logger.Log("Unknown exception");
+            throw;
+        }
+    }
+
     void FileSystem::SetCallbacks(const CallbackInfo &info)
     {
         LoggerScope logger(__FUNCTION__);
@@ -116,10 +161,18 @@ namespace Bindings::FileSystem
         {
             const auto env = info.Env();
 
+            // The handles sit on top of the recorded callbacks, so recordings only hold path based reads
+            constexpr auto readContent = Utils::Recording::RecordReadFileContent<readFileContent>;
+            const auto open = this->HasStat ? openFile<readContent, Utils::Recording::RecordStat<stat>> : openFile<readContent, nullptr>;
+
             const auto result = set_file_system_callbacks(this,
-                                                          readFileContent,
-                                                          readDirectoryFileList,
-                                                          readDirectoryList);
+                                                          readContent,
+                                                          Utils::Recording::RecordReadDirectoryFileList<readDirectoryFileList>,
+                                                          Utils::Recording::RecordReadDirectoryList<readDirectoryList>,
+                                                          this->HasStat ? Utils::Recording::RecordStat<stat> : nullptr,
+                                                          open,
+                                                          readFile<readContent>,
+                                                          closeFile);
 
             if (result != 0)
             {
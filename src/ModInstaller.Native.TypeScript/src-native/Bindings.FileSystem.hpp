@@ -3,6 +3,7 @@
 
 #include <napi.h>
 #include "ModInstaller.Native.h"
+#include "Utils.DirectorySnapshot.hpp"
 
 using namespace Napi;
 using namespace ModInstaller::Native;
@@ -15,13 +16,18 @@ namespace Bindings::FileSystem
         Napi::ThreadSafeFunction TSFNReadFileContent;
         Napi::ThreadSafeFunction TSFNReadDirectoryFileList;
         Napi::ThreadSafeFunction TSFNReadDirectoryList;
+        Napi::ThreadSafeFunction TSFNStat;
 
         FunctionReference FReadFileContent;
         FunctionReference FReadDirectoryFileList;
         FunctionReference FReadDirectoryList;
+        FunctionReference FStat;
+        bool HasStat = false;
 
         std::thread::id MainThreadId;
 
+        Utils::DirectorySnapshots Snapshots;
+
         static Object Init(const Napi::Env env, const Object exports);
 
         FileSystem(const CallbackInfo &info);
@@ -29,6 +35,7 @@ namespace Bindings::FileSystem
 
         void SetCallbacks(const CallbackInfo &info);
         static void SetDefaultCallbacks(const CallbackInfo &info);
+        static void SetDirectorySnapshots(const CallbackInfo &info);
     };
 }
 #endif
@@ -0,0 +1,52 @@
+#ifndef VE_IMAGEPREFETCH_GUARD_HPP_
+#define VE_IMAGEPREFETCH_GUARD_HPP_
+
+#include <napi.h>
+#include "ModInstaller.Native.h"
+#include "Logger.hpp"
+#include "Utils.Return.hpp"
+
+using namespace Napi;
+using namespace Utils;
+using namespace ModInstaller::Native;
+
+// The images themselves are read through the ModInstaller that prefetched them
+namespace Bindings::ImagePrefetch
+{
+    void SetImagePrefetchCapacity(const CallbackInfo &info)
+    {
+        LoggerScope logger(__FUNCTION__);
+
+        try
+        {
+            const auto env = info.Env();
+            const auto capacity = info[0].As<Number>().Int32Value();
+
+            const auto result = set_image_prefetch_capacity(capacity);
+            ThrowOrReturn(env, result);
+        }
+        catch (const Napi::Error &e)
+        {
+            logger.LogError(e);
+            throw;
+        }
+        catch (const std::exception &e)
+        {
+            logger.LogException(e);
+            throw;
+        }
+        catch (...)
+        {
+            logger.Log("Unknown exception");
+            throw;
+        }
+    }
+
+    Object Init(const Env env, Object exports)
+    {
+        exports.Set("setImagePrefetchCapacity", Function::New(env, SetImagePrefetchCapacity));
+
+        return exports;
+    }
+}
+#endif
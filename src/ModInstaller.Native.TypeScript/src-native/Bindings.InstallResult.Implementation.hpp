@@ -0,0 +1,263 @@
+#ifndef VE_INSTALLRESULT_IMPL_GUARD_HPP_
+#define VE_INSTALLRESULT_IMPL_GUARD_HPP_
+
+#include <string>
+#include "ModInstaller.Native.h"
+#include "Logger.hpp"
+#include "Utils.JS.hpp"
+#include "Bindings.InstallResult.hpp"
+
+using namespace Napi;
+using namespace Utils;
+using namespace ModInstaller::Native;
+
+namespace Bindings::InstallResult
+{
+    struct NativeInstallResultData
+    {
+        del_bytes data;
+        size_t length;
+    };
+
+    // Instance data is taken by the other classes, the constructors are kept for the lifetime of the add-on
+    FunctionReference *NativeInstallResult::Constructor = nullptr;
+    FunctionReference *NativeInstallResultIterator::Constructor = nullptr;
+
+    Object NativeInstallResult::Init(const Napi::Env env, Object exports)
+    {
+        const auto func = DefineClass(env, "NativeInstallResult",
+                                      {
+                                          InstanceAccessor<&NativeInstallResult::GetLength>("length"),
+                                          InstanceAccessor<&NativeInstallResult::GetResultMessage>("message"),
+                                          InstanceAccessor<&NativeInstallResult::GetDecisions>("decisions"),
+                                          InstanceMethod<&NativeInstallResult::Get>("get", static_cast<napi_property_attributes>(napi_writable | napi_configurable)),
+                                          InstanceMethod<&NativeInstallResult::Filter>("filter", static_cast<napi_property_attributes>(napi_writable | napi_configurable)),
+                                          InstanceMethod<&NativeInstallResult::Iterator>(Napi::Symbol::WellKnown(env, "iterator"), static_cast<napi_property_attributes>(napi_writable | napi_configurable)),
+                                      });
+
+        Constructor = new FunctionReference();
+        *Constructor = Persistent(func);
+        exports.Set("NativeInstallResult", func);
+
+        NativeInstallResultIterator::Init(env);
+
+        return exports;
+    }
+
+    Napi::Value NativeInstallResult::Create(const Napi::Env env, del_bytes &data, const size_t length)
+    {
+        auto *const payload = new NativeInstallResultData{std::move(data), length};
+        return Constructor->New({External<NativeInstallResultData>::New(env, payload)});
+    }
+
+    NativeInstallResult::NativeInstallResult(const CallbackInfo &info) : ObjectWrap<NativeInstallResult>(info)
+    {
+        LoggerScope logger(__FUNCTION__);
+
+        const auto env = info.Env();
+        if (info.Length() != 1 || !info[0].IsExternal())
+        {
+            NAPI_THROW_VOID(TypeError::New(env, "NativeInstallResult is created by installLazy"));
+        }
+
+        const std::unique_ptr<NativeInstallResultData> payload{info[0].As<External<NativeInstallResultData>>().Data()};
+        this->_data = std::move(payload->data);
+        this->_length = payload->length;
+
+        const auto error = this->_index.Parse(this->_data.get(), this->_length);
+        if (error != nullptr)
+        {
+            NAPI_THROW_VOID(Error::New(env, error));
+        }
+
+        // Lets the GC account for the buffer it keeps alive
+        MemoryManagement::AdjustExternalMemory(env, static_cast<int64_t>(this->_length));
+    }
+
+    NativeInstallResult::~NativeInstallResult()
+    {
+        if (this->_data != nullptr)
+        {
+            MemoryManagement::AdjustExternalMemory(Env(), -static_cast<int64_t>(this->_length));
+        }
+    }
+
+    uint32_t NativeInstallResult::Count() const
+    {
+        return this->_index.Count();
+    }
+
+    Napi::Value NativeInstallResult::StringValue(const Napi::Env env, const int32_t index) const
+    {
+        std::string value;
+        this->_index.String(static_cast<uint32_t>(index), value);
+        return Napi::String::New(env, value);
+    }
+
+    Object NativeInstallResult::Materialize(const Napi::Env env, const uint32_t i) const
+    {
+        const auto instruction = this->_index.At(i);
+
+        // Same properties, in the same order, as the JSON result
+        auto object = Object::New(env);
+        if (instruction.type != CompactResult::OtherType)
+        {
+            object.Set("type", CompactResult::TypeNames[instruction.type]);
+        }
+        else if (instruction.typeName != -1)
+        {
+            object.Set("type", StringValue(env, instruction.typeName));
+        }
+        const auto set = [this, env, &object](const char *name, const int32_t index)
+        {
+            if (index != -1)
+            {
+                object.Set(name, StringValue(env, index));
+            }
+        };
+        set("source", instruction.source);
+        set("destination", instruction.destination);
+        if (instruction.hasIni)
+        {
+            set("section", instruction.section);
+            set("key", instruction.key);
+            set("value", instruction.value);
+        }
+        if (instruction.hasData)
+        {
+            object.Set("data", Buffer<uint8_t>::Copy(env, instruction.data, instruction.dataLength));
+        }
+        object.Set("priority", Number::New(env, instruction.priority));
+        return object;
+    }
+
+    Napi::Value NativeInstallResult::GetLength(const CallbackInfo &info)
+    {
+        return Number::New(info.Env(), this->Count());
+    }
+
+    Napi::Value NativeInstallResult::GetResultMessage(const CallbackInfo &info)
+    {
+        const auto env = info.Env();
+        const auto message = this->_index.Message();
+        return message == -1 ? env.Undefined() : StringValue(env, message);
+    }
+
+    Napi::Value NativeInstallResult::GetDecisions(const CallbackInfo &info)
+    {
+        const auto env = info.Env();
+        uint32_t length;
+        const auto decisions = this->_index.Decisions(length);
+        return length == 0 ? env.Undefined() : JSONParse(Napi::String::New(env, decisions, length));
+    }
+
+    Napi::Value NativeInstallResult::Get(const CallbackInfo &info)
+    {
+        const auto env = info.Env();
+        const auto index = info[0].As<Number>().Int64Value();
+        if (index < 0 || index >= static_cast<int64_t>(this->Count()))
+        {
+            return env.Undefined();
+        }
+        return Materialize(env, static_cast<uint32_t>(index));
+    }
+
+    Napi::Value NativeInstallResult::Filter(const CallbackInfo &info)
+    {
+        LoggerScope logger(__FUNCTION__);
+
+        const auto env = info.Env();
+        const auto type = info[0].As<Napi::String>().Utf8Value();
+
+        auto known = CompactResult::OtherType;
+        for (uint8_t i = 0; i < CompactResult::TypeCount; i++)
+        {
+            if (type == CompactResult::TypeNames[i])
+            {
+                known = i;
+            }
+        }
+
+        // Only the type column is read for the instructions that don't match
+        auto result = Napi::Array::New(env);
+        uint32_t found = 0;
+        std::string name;
+        for (uint32_t i = 0; i < this->Count(); i++)
+        {
+            if (this->_index.Type(i) != known)
+            {
+                continue;
+            }
+            if (known == CompactResult::OtherType)
+            {
+                const auto typeName = this->_index.At(i).typeName;
+                if (typeName == -1)
+                {
+                    continue;
+                }
+                this->_index.String(static_cast<uint32_t>(typeName), name);
+                if (name != type)
+                {
+                    continue;
+                }
+            }
+            result.Set(found++, Materialize(env, i));
+        }
+        return result;
+    }
+
+    Napi::Value NativeInstallResult::Iterator(const CallbackInfo &info)
+    {
+        return NativeInstallResultIterator::Create(info.This().As<Object>());
+    }
+
+    void NativeInstallResultIterator::Init(const Napi::Env env)
+    {
+        const auto func = DefineClass(env, "NativeInstallResultIterator",
+                                      {
+                                          InstanceMethod<&NativeInstallResultIterator::Next>("next", static_cast<napi_property_attributes>(napi_writable | napi_configurable)),
+                                          InstanceMethod<&NativeInstallResultIterator::Self>(Napi::Symbol::WellKnown(env, "iterator"), static_cast<napi_property_attributes>(napi_writable | napi_configurable)),
+                                      });
+
+        Constructor = new FunctionReference();
+        *Constructor = Persistent(func);
+    }
+
+    Napi::Value NativeInstallResultIterator::Create(const Object result)
+    {
+        return Constructor->New({result});
+    }
+
+    NativeInstallResultIterator::NativeInstallResultIterator(const CallbackInfo &info) : ObjectWrap<NativeInstallResultIterator>(info)
+    {
+        const auto result = info[0].As<Object>();
+        this->_owner = NativeInstallResult::Unwrap(result);
+        this->_result = Persistent(result);
+    }
+
+    Napi::Value NativeInstallResultIterator::Next(const CallbackInfo &info)
+    {
+        const auto env = info.Env();
+        auto step = Object::New(env);
+        if (this->_owner == nullptr || this->_next >= this->_owner->Count())
+        {
+            step.Set("value", env.Undefined());
+            step.Set("done", true);
+            return step;
+        }
+        step.Set("value", this->_owner->Materialize(env, this->_next++));
+        step.Set("done", false);
+        return step;
+    }
+
+    Napi::Value NativeInstallResultIterator::Self(const CallbackInfo &info)
+    {
+        return info.This();
+    }
+
+    Object Init(const Napi::Env env, Object exports)
+    {
+        return NativeInstallResult::Init(env, exports);
+    }
+}
+#endif
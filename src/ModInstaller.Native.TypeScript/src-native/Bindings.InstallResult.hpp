@@ -0,0 +1,65 @@
+#ifndef VE_INSTALLRESULT_GUARD_HPP_
+#define VE_INSTALLRESULT_GUARD_HPP_
+
+#include <napi.h>
+#include "ModInstaller.Native.h"
+#include "Utils.Generic.hpp"
+#include "Utils.CompactResult.hpp"
+
+using namespace Napi;
+using namespace ModInstaller::Native;
+
+namespace Bindings::InstallResult
+{
+    // An install result in the compact layout, kept in native memory until the object is collected.
+    // Instructions become JS objects only when they are read.
+    class NativeInstallResult : public Napi::ObjectWrap<NativeInstallResult>
+    {
+    public:
+        static Object Init(const Napi::Env env, const Object exports);
+        static Napi::Value Create(const Napi::Env env, Utils::del_bytes &data, const size_t length);
+
+        NativeInstallResult(const CallbackInfo &info);
+        ~NativeInstallResult();
+
+        Napi::Value GetLength(const CallbackInfo &info);
+        Napi::Value GetResultMessage(const CallbackInfo &info);
+        Napi::Value GetDecisions(const CallbackInfo &info);
+        Napi::Value Get(const CallbackInfo &info);
+        Napi::Value Filter(const CallbackInfo &info);
+        Napi::Value Iterator(const CallbackInfo &info);
+
+        uint32_t Count() const;
+        Object Materialize(const Napi::Env env, const uint32_t i) const;
+
+    private:
+        static FunctionReference *Constructor;
+
+        Utils::del_bytes _data;
+        size_t _length = 0;
+        Utils::CompactResult::Index _index;
+
+        Napi::Value StringValue(const Napi::Env env, const int32_t index) const;
+    };
+
+    class NativeInstallResultIterator : public Napi::ObjectWrap<NativeInstallResultIterator>
+    {
+    public:
+        static void Init(const Napi::Env env);
+        static Napi::Value Create(const Object result);
+
+        NativeInstallResultIterator(const CallbackInfo &info);
+
+        Napi::Value Next(const CallbackInfo &info);
+        Napi::Value Self(const CallbackInfo &info);
+
+    private:
+        static FunctionReference *Constructor;
+
+        // Keeps the result and its buffer alive while iterating
+        ObjectReference _result;
+        NativeInstallResult *_owner = nullptr;
+        uint32_t _next = 0;
+    };
+}
+#endif
@@ -2,11 +2,10 @@
 #define VE_LOGGING_CB_GUARD_HPP_
 
 #include <iostream>
-#include <mutex>
-#include <condition_variable>
 #include <thread>
 #include "ModInstaller.Native.h"
 #include "Utils.Callbacks.hpp"
+#include "Utils.Watchdog.hpp"
 #include "Bindings.Logging.hpp"
 
 using namespace Napi;
@@ -37,32 +36,30 @@ namespace Bindings::Logging
                 // So we need to use the ThreadSafeFunction to marshal the call to the main JS thread
                 // and wait for the result synchronously
 
-                std::mutex mtx;
-                std::condition_variable cv;
-                bool completed = false;
-                int32_t result = 0;
+                const auto call = Watchdog::PendingCall<int32_t>::New(Watchdog::Category::Logging, __FUNCTION__);
 
-                const auto callback = [manager, level, message, &result, &mtx, &cv, &completed](Napi::Env env, Napi::Function jsCallback)
+                const auto callback = [manager, level, message, call](Napi::Env env, Napi::Function jsCallback)
                 {
                     try
                     {
+                        auto started = call->Start();
+                        if (!started)
+                        {
+                            return;
+                        }
+
                         const auto levelValue = Napi::Number::New(env, level);
                         const auto messageValue = Napi::String::New(env, message);
+                        started.unlock();
                         jsCallback({levelValue, messageValue});
 
-                        std::lock_guard<std::mutex> lock(mtx);
-                        result = 0;
-                        completed = true;
-                        cv.notify_one();
+                        call->Complete(0);
                     }
                     catch (const Napi::Error &e)
                     {
                         std::cerr << "Error in log callback: " << e.what() << std::endl;
 
-                        std::lock_guard<std::mutex> lock(mtx);
-                        result = -1;
-                        completed = true;
-                        cv.notify_one();
+                        call->Complete(-1);
                     }
                 };
 
@@ -73,11 +70,7 @@ namespace Bindings::Logging
                     return -2;
                 }
 
-                std::unique_lock<std::mutex> lock(mtx);
-                cv.wait(lock, [&completed]
-                        { return completed; });
-
-                return result;
+                return call->Wait();
             }
         }
         catch (const Napi::Error &e)
@@ -1,13 +1,14 @@
 #ifndef VE_MODINSTALLER_CB_GUARD_HPP_
 #define VE_MODINSTALLER_CB_GUARD_HPP_
 
-#include <mutex>
-#include <condition_variable>
 #include <thread>
+#include <vector>
 #include "ModInstaller.Native.h"
 #include "Logger.hpp"
 #include "Utils.Callbacks.hpp"
+#include "Utils.Watchdog.hpp"
 #include "Utils.Converters.hpp"
+#include "Utils.Recording.hpp"
 #include "Bindings.ModInstaller.hpp"
 
 using namespace Napi;
@@ -23,7 +24,7 @@ namespace Bindings::ModInstaller
         LoggerScope logger(functionName, active_only);
         try
         {
-            auto manager = const_cast<Bindings::ModInstaller::ModInstaller *>(static_cast<const Bindings::ModInstaller::ModInstaller *>(p_owner));
+            auto manager = const_cast<Handler *>(static_cast<const Handler *>(p_owner));
 
             if (std::this_thread::get_id() == manager->MainThreadId)
             {
@@ -40,32 +41,30 @@ namespace Bindings::ModInstaller
                 // So we need to use the ThreadSafeFunction to marshal the call to the main JS thread
                 // and wait for the result synchronously
 
-                std::mutex mtx;
-                std::condition_variable cv;
-                bool completed = false;
-                return_value_json *result = nullptr;
+                const auto call = Watchdog::PendingCall<return_value_json *>::New(Watchdog::Category::Context, functionName);
 
-                const auto callback = [functionName, manager, active_only, &result, &mtx, &cv, &completed](Napi::Env env, Napi::Function jsCallback)
+                const auto callback = [functionName, manager, active_only, call](Napi::Env env, Napi::Function)
                 {
                     LoggerScope callbackLogger(NAMEOFWITHCALLBACK(functionName, callback));
                     try
                     {
+                        auto started = call->Start();
+                        if (!started)
+                        {
+                            return;
+                        }
+
                         const auto activeOnly = Boolean::New(env, active_only != 0);
 
-                        const auto jsResult = jsCallback({activeOnly});
+                        started.unlock();
+                        const auto jsResult = manager->FPluginsGetAll({activeOnly});
 
-                        std::lock_guard<std::mutex> lock(mtx);
-                        result = ConvertToJsonResult(jsResult);
-                        completed = true;
-                        cv.notify_one();
+                        call->Complete(ConvertToJsonResult(jsResult));
                     }
                     catch (const Napi::Error &e)
                     {
                         callbackLogger.LogError(e);
-                        std::lock_guard<std::mutex> lock(mtx);
-                        result = Create(return_value_json{Copy(GetErrorMessage(e)), nullptr});
-                        completed = true;
-                        cv.notify_one();
+                        call->Complete(Create(return_value_json{Copy(GetErrorMessage(e)), nullptr}));
                     }
                 };
 
@@ -76,10 +75,7 @@ namespace Bindings::ModInstaller
                     return Create(return_value_json{Copy(u"Failed to queue async call"), nullptr});
                 }
 
-                std::unique_lock<std::mutex> lock(mtx);
-                cv.wait(lock, [&completed]
-                        { return completed; });
-
+                const auto result = call->Wait();
                 logger.Log("Blocking call completed");
                 return result;
             }
@@ -108,7 +104,7 @@ namespace Bindings::ModInstaller
         LoggerScope logger(functionName);
         try
         {
-            auto manager = const_cast<Bindings::ModInstaller::ModInstaller *>(static_cast<const Bindings::ModInstaller::ModInstaller *>(p_owner));
+            auto manager = const_cast<Handler *>(static_cast<const Handler *>(p_owner));
 
             if (std::this_thread::get_id() == manager->MainThreadId)
             {
@@ -122,30 +118,27 @@ namespace Bindings::ModInstaller
                 // So we need to use the ThreadSafeFunction to marshal the call to the main JS thread
                 // and wait for the result synchronously
 
-                std::mutex mtx;
-                std::condition_variable cv;
-                bool completed = false;
-                return_value_string *result = nullptr;
+                const auto call = Watchdog::PendingCall<return_value_string *>::New(Watchdog::Category::Context, functionName);
 
-                const auto callback = [functionName, manager, &result, &mtx, &cv, &completed](Napi::Env env, Napi::Function jsCallback)
+                const auto callback = [functionName, manager, call](Napi::Env env, Napi::Function)
                 {
                     LoggerScope callbackLogger(NAMEOFWITHCALLBACK(functionName, callback));
                     try
                     {
-                        const auto jsResult = jsCallback({});
-
-                        std::lock_guard<std::mutex> lock(mtx);
-                        result = ConvertToStringResult(jsResult);
-                        completed = true;
-                        cv.notify_one();
+                        auto started = call->Start();
+                        if (!started)
+                        {
+                            return;
+                        }
+                        started.unlock();
+                        const auto jsResult = manager->FContextGetAppVersion({});
+
+                        call->Complete(ConvertToStringResult(jsResult));
                     }
                     catch (const Napi::Error &e)
                     {
                         callbackLogger.LogError(e);
-                        std::lock_guard<std::mutex> lock(mtx);
-                        result = Create(return_value_string{Copy(GetErrorMessage(e)), nullptr});
-                        completed = true;
-                        cv.notify_one();
+                        call->Complete(Create(return_value_string{Copy(GetErrorMessage(e)), nullptr}));
                     }
                 };
 
@@ -156,10 +149,7 @@ namespace Bindings::ModInstaller
                     return Create(return_value_string{Copy(u"Failed to queue async call"), nullptr});
                 }
 
-                std::unique_lock<std::mutex> lock(mtx);
-                cv.wait(lock, [&completed]
-                        { return completed; });
-
+                const auto result = call->Wait();
                 logger.Log("Blocking call completed");
                 return result;
             }
@@ -188,7 +178,7 @@ namespace Bindings::ModInstaller
         LoggerScope logger(functionName);
         try
         {
-            auto manager = const_cast<Bindings::ModInstaller::ModInstaller *>(static_cast<const Bindings::ModInstaller::ModInstaller *>(p_owner));
+            auto manager = const_cast<Handler *>(static_cast<const Handler *>(p_owner));
 
             if (std::this_thread::get_id() == manager->MainThreadId)
             {
@@ -202,30 +192,27 @@ namespace Bindings::ModInstaller
                 // So we need to use the ThreadSafeFunction to marshal the call to the main JS thread
                 // and wait for the result synchronously
 
-                std::mutex mtx;
-                std::condition_variable cv;
-                bool completed = false;
-                return_value_string *result = nullptr;
+                const auto call = Watchdog::PendingCall<return_value_string *>::New(Watchdog::Category::Context, functionName);
 
-                const auto callback = [functionName, manager, &result, &mtx, &cv, &completed](Napi::Env env, Napi::Function jsCallback)
+                const auto callback = [functionName, manager, call](Napi::Env env, Napi::Function)
                 {
                     LoggerScope callbackLogger(NAMEOFWITHCALLBACK(functionName, callback));
                     try
                     {
-                        const auto jsResult = jsCallback({});
-
-                        std::lock_guard<std::mutex> lock(mtx);
-                        result = ConvertToStringResult(jsResult);
-                        completed = true;
-                        cv.notify_one();
+                        auto started = call->Start();
+                        if (!started)
+                        {
+                            return;
+                        }
+                        started.unlock();
+                        const auto jsResult = manager->FContextGetCurrentGameVersion({});
+
+                        call->Complete(ConvertToStringResult(jsResult));
                     }
                     catch (const Napi::Error &e)
                     {
                         callbackLogger.LogError(e);
-                        std::lock_guard<std::mutex> lock(mtx);
-                        result = Create(return_value_string{Copy(GetErrorMessage(e)), nullptr});
-                        completed = true;
-                        cv.notify_one();
+                        call->Complete(Create(return_value_string{Copy(GetErrorMessage(e)), nullptr}));
                     }
                 };
 
@@ -236,10 +223,7 @@ namespace Bindings::ModInstaller
                     return Create(return_value_string{Copy(u"Failed to queue async call"), nullptr});
                 }
 
-                std::unique_lock<std::mutex> lock(mtx);
-                cv.wait(lock, [&completed]
-                        { return completed; });
-
+                const auto result = call->Wait();
                 logger.Log("Blocking call completed");
                 return result;
             }
@@ -269,7 +253,7 @@ namespace Bindings::ModInstaller
         LoggerScope logger(functionName);
         try
         {
-            auto manager = const_cast<Bindings::ModInstaller::ModInstaller *>(static_cast<const Bindings::ModInstaller::ModInstaller *>(p_owner));
+            auto manager = const_cast<Handler *>(static_cast<const Handler *>(p_owner));
 
             if (std::this_thread::get_id() == manager->MainThreadId)
             {
@@ -284,31 +268,29 @@ namespace Bindings::ModInstaller
                 // So we need to use the ThreadSafeFunction to marshal the call to the main JS thread
                 // and wait for the result synchronously
 
-                std::mutex mtx;
-                std::condition_variable cv;
-                bool completed = false;
-                return_value_string *result = nullptr;
+                const auto call = Watchdog::PendingCall<return_value_string *>::New(Watchdog::Category::Context, functionName);
 
-                const auto callback = [functionName, manager, p_extender, &result, &mtx, &cv, &completed](Napi::Env env, Napi::Function jsCallback)
+                const auto callback = [functionName, manager, p_extender, call](Napi::Env env, Napi::Function)
                 {
                     LoggerScope callbackLogger(NAMEOFWITHCALLBACK(functionName, callback));
                     try
                     {
+                        auto started = call->Start();
+                        if (!started)
+                        {
+                            return;
+                        }
+
                         const auto extender = p_extender == nullptr ? env.Null() : String::New(env, p_extender);
-                        const auto jsResult = jsCallback({extender});
+                        started.unlock();
+                        const auto jsResult = manager->FContextGetExtenderVersion({extender});
 
-                        std::lock_guard<std::mutex> lock(mtx);
-                        result = ConvertToStringResult(jsResult);
-                        completed = true;
-                        cv.notify_one();
+                        call->Complete(ConvertToStringResult(jsResult));
                     }
                     catch (const Napi::Error &e)
                     {
                         callbackLogger.LogError(e);
-                        std::lock_guard<std::mutex> lock(mtx);
-                        result = Create(return_value_string{Copy(GetErrorMessage(e)), nullptr});
-                        completed = true;
-                        cv.notify_one();
+                        call->Complete(Create(return_value_string{Copy(GetErrorMessage(e)), nullptr}));
                     }
                 };
 
@@ -319,10 +301,7 @@ namespace Bindings::ModInstaller
                     return Create(return_value_string{Copy(u"Failed to queue async call"), nullptr});
                 }
 
-                std::unique_lock<std::mutex> lock(mtx);
-                cv.wait(lock, [&completed]
-                        { return completed; });
-
+                const auto result = call->Wait();
                 logger.Log("Blocking call completed");
                 return result;
             }
@@ -357,7 +336,7 @@ namespace Bindings::ModInstaller
         LoggerScope logger(functionName);
         try
         {
-            auto manager = const_cast<Bindings::ModInstaller::ModInstaller *>(static_cast<const Bindings::ModInstaller::ModInstaller *>(p_owner));
+            auto manager = const_cast<Handler *>(static_cast<const Handler *>(p_owner));
 
             // Define callback lambdas that will be used by the JavaScript functions
             const auto selectCallback = [functionName, p_callback_handler, p_select_callback](const CallbackInfo &info)
@@ -370,6 +349,8 @@ namespace Bindings::ModInstaller
                     const auto selectedIds = JSONStringify(info[2].As<Object>());
                     const auto selectedIdsCopy = CopyWithFree(selectedIds.Utf16Value());
 
+                    Utils::Recording::RecordUISelect(groupId, optionId, selectedIdsCopy.get());
+
                     auto result = Create(return_value_void{nullptr});
                     p_select_callback(p_callback_handler, groupId, optionId, selectedIdsCopy.get(), result);
                 }
@@ -389,6 +370,8 @@ namespace Bindings::ModInstaller
                     const auto goForward = info[0].As<Boolean>().Value() ? (uint8_t)1 : (uint8_t)0;
                     const auto stepId = info[1].As<Number>().Int32Value();
 
+                    Utils::Recording::RecordUIContinue(goForward, stepId);
+
                     auto result = Create(return_value_void{nullptr});
                     p_const_callback(p_callback_handler, goForward, stepId, result);
                 }
@@ -405,6 +388,8 @@ namespace Bindings::ModInstaller
                 LoggerScope cancelLogger(NAMEOFWITHCALLBACK(functionName, cancelCallback));
                 try
                 {
+                    Utils::Recording::RecordUICancel();
+
                     auto result = Create(return_value_void{nullptr});
                     p_cancel_callback(p_callback_handler, result);
                 }
@@ -435,36 +420,34 @@ namespace Bindings::ModInstaller
                 // So we need to use the ThreadSafeFunction to marshal the call to the main JS thread
                 // and wait for the result synchronously
 
-                std::mutex mtx;
-                std::condition_variable cv;
-                bool completed = false;
-                return_value_void *result = nullptr;
+                const auto call = Watchdog::PendingCall<return_value_void *>::New(Watchdog::Category::UI, functionName);
 
-                const auto callback = [functionName, manager, p_module_name, p_image, selectCallback, constCallback, cancelCallback, &result, &mtx, &cv, &completed](Napi::Env env, Napi::Function jsCallback)
+                const auto callback = [functionName, manager, p_module_name, p_image, selectCallback, constCallback, cancelCallback, call](Napi::Env env, Napi::Function)
                 {
                     LoggerScope callbackLogger(NAMEOFWITHCALLBACK(functionName, callback));
                     try
                     {
+                        auto started = call->Start();
+                        if (!started)
+                        {
+                            return;
+                        }
+
                         const auto moduleName = p_module_name == nullptr ? env.Null() : String::New(env, p_module_name);
                         const auto image = p_image == nullptr ? env.Null() : JSONParse(Napi::String::New(env, p_image));
                         const auto selectFunction = Function::New(env, selectCallback, NAMEOF(selectCallback));
                         const auto constFunction = Function::New(env, constCallback, NAMEOF(constCallback));
                         const auto cancelFunction = Function::New(env, cancelCallback, NAMEOF(cancelCallback));
 
-                        jsCallback({moduleName, image, selectFunction, constFunction, cancelFunction});
+                        started.unlock();
+                        manager->FUIStartDialog({moduleName, image, selectFunction, constFunction, cancelFunction});
 
-                        std::lock_guard<std::mutex> lock(mtx);
-                        result = Create(return_value_void{nullptr});
-                        completed = true;
-                        cv.notify_one();
+                        call->Complete(Create(return_value_void{nullptr}));
                     }
                     catch (const Napi::Error &e)
                     {
                         callbackLogger.LogError(e);
-                        std::lock_guard<std::mutex> lock(mtx);
-                        result = Create(return_value_void{Copy(GetErrorMessage(e))});
-                        completed = true;
-                        cv.notify_one();
+                        call->Complete(Create(return_value_void{Copy(GetErrorMessage(e))}));
                     }
                 };
 
@@ -475,10 +458,7 @@ namespace Bindings::ModInstaller
                     return Create(return_value_void{Copy(u"Failed to queue async call")});
                 }
 
-                std::unique_lock<std::mutex> lock(mtx);
-                cv.wait(lock, [&completed]
-                        { return completed; });
-
+                const auto result = call->Wait();
                 logger.Log("Blocking call completed");
                 return result;
             }
@@ -507,7 +487,7 @@ namespace Bindings::ModInstaller
         LoggerScope logger(functionName);
         try
         {
-            auto manager = const_cast<Bindings::ModInstaller::ModInstaller *>(static_cast<const Bindings::ModInstaller::ModInstaller *>(p_owner));
+            auto manager = const_cast<Handler *>(static_cast<const Handler *>(p_owner));
 
             if (std::this_thread::get_id() == manager->MainThreadId)
             {
@@ -521,30 +501,27 @@ namespace Bindings::ModInstaller
                 // So we need to use the ThreadSafeFunction to marshal the call to the main JS thread
                 // and wait for the result synchronously
 
-                std::mutex mtx;
-                std::condition_variable cv;
-                bool completed = false;
-                return_value_void *result = nullptr;
+                const auto call = Watchdog::PendingCall<return_value_void *>::New(Watchdog::Category::UI, functionName);
 
-                const auto callback = [functionName, manager, &result, &mtx, &cv, &completed](Napi::Env env, Napi::Function jsCallback)
+                const auto callback = [functionName, manager, call](Napi::Env env, Napi::Function)
                 {
                     LoggerScope callbackLogger(NAMEOFWITHCALLBACK(functionName, callback));
                     try
                     {
-                        jsCallback({});
-
-                        std::lock_guard<std::mutex> lock(mtx);
-                        result = Create(return_value_void{nullptr});
-                        completed = true;
-                        cv.notify_one();
+                        auto started = call->Start();
+                        if (!started)
+                        {
+                            return;
+                        }
+                        started.unlock();
+                        manager->FUIEndDialog({});
+
+                        call->Complete(Create(return_value_void{nullptr}));
                     }
                     catch (const Napi::Error &e)
                     {
                         callbackLogger.LogError(e);
-                        std::lock_guard<std::mutex> lock(mtx);
-                        result = Create(return_value_void{Copy(GetErrorMessage(e))});
-                        completed = true;
-                        cv.notify_one();
+                        call->Complete(Create(return_value_void{Copy(GetErrorMessage(e))}));
                     }
                 };
 
@@ -555,10 +532,7 @@ namespace Bindings::ModInstaller
                     return Create(return_value_void{Copy(u"Failed to queue async call")});
                 }
 
-                std::unique_lock<std::mutex> lock(mtx);
-                cv.wait(lock, [&completed]
-                        { return completed; });
-
+                const auto result = call->Wait();
                 logger.Log("Blocking call completed");
                 return result;
             }
@@ -581,6 +555,48 @@ namespace Bindings::ModInstaller
         }
     }
 
+    // uiUpdateState receives the steps with the directories of option images in a shared table, see InstallerStepsState.
+    // The images are joined back onto their directories so the callback gets the steps as before
+    static Napi::Value ParseInstallSteps(const Napi::Env env, const param_json *p_install_steps)
+    {
+        const auto state = JSONParse(Napi::String::New(env, p_install_steps));
+        const auto prefixValues = state.Get("prefixes").As<Napi::Array>();
+        const auto imagePrefixes = state.Get("imagePrefixes").As<Napi::Array>();
+        const auto steps = state.Get("steps").As<Napi::Array>();
+
+        std::vector<std::u16string> prefixes(prefixValues.Length());
+        for (uint32_t i = 0; i < prefixValues.Length(); i++)
+        {
+            prefixes[i] = prefixValues.Get(i).As<Napi::String>().Utf16Value();
+        }
+
+        uint32_t option = 0;
+        for (uint32_t i = 0; i < steps.Length(); i++)
+        {
+            const auto groups = steps.Get(i).As<Object>().Get("optionalFileGroups").As<Object>().Get("group");
+            if (!groups.IsArray())
+            {
+                continue;
+            }
+            const auto groupArray = groups.As<Napi::Array>();
+            for (uint32_t j = 0; j < groupArray.Length(); j++)
+            {
+                const auto options = groupArray.Get(j).As<Object>().Get("options").As<Napi::Array>();
+                for (uint32_t k = 0; k < options.Length(); k++, option++)
+                {
+                    const auto prefix = imagePrefixes.Get(option).As<Number>().Int32Value();
+                    if (prefix < 0 || static_cast<size_t>(prefix) >= prefixes.size())
+                    {
+                        continue;
+                    }
+                    auto object = options.Get(k).As<Object>();
+                    object.Set("image", Napi::String::New(env, prefixes[prefix] + object.Get("image").As<Napi::String>().Utf16Value()));
+                }
+            }
+        }
+        return steps;
+    }
+
     static return_value_void *uiUpdateState(param_ptr *p_owner,
                                             param_json *p_install_steps,
                                             param_int current_step) noexcept
@@ -589,12 +605,12 @@ namespace Bindings::ModInstaller
         LoggerScope logger(functionName);
         try
         {
-            auto manager = const_cast<Bindings::ModInstaller::ModInstaller *>(static_cast<const Bindings::ModInstaller::ModInstaller *>(p_owner));
+            auto manager = const_cast<Handler *>(static_cast<const Handler *>(p_owner));
 
             if (std::this_thread::get_id() == manager->MainThreadId)
             {
                 const auto env = manager->FUIUpdateState.Env();
-                const auto installSteps = p_install_steps == nullptr ? env.Null() : JSONParse(Napi::String::New(env, p_install_steps));
+                const auto installSteps = p_install_steps == nullptr ? env.Null() : ParseInstallSteps(env, p_install_steps);
                 const auto stepNumber = Number::New(env, current_step);
                 manager->FUIUpdateState({installSteps, stepNumber});
                 return Create(return_value_void{nullptr});
@@ -605,33 +621,31 @@ namespace Bindings::ModInstaller
                 // So we need to use the ThreadSafeFunction to marshal the call to the main JS thread
                 // and wait for the result synchronously
 
-                std::mutex mtx;
-                std::condition_variable cv;
-                bool completed = false;
-                return_value_void *result = nullptr;
+                const auto call = Watchdog::PendingCall<return_value_void *>::New(Watchdog::Category::UI, functionName);
 
-                const auto callback = [functionName, manager, p_install_steps, current_step, &result, &mtx, &cv, &completed](Napi::Env env, Napi::Function jsCallback)
+                const auto callback = [functionName, manager, p_install_steps, current_step, call](Napi::Env env, Napi::Function)
                 {
                     LoggerScope callbackLogger(NAMEOFWITHCALLBACK(functionName, callback));
                     try
                     {
-                        const auto installSteps = p_install_steps == nullptr ? env.Null() : JSONParse(Napi::String::New(env, p_install_steps));
+                        auto started = call->Start();
+                        if (!started)
+                        {
+                            return;
+                        }
+
+                        const auto installSteps = p_install_steps == nullptr ? env.Null() : ParseInstallSteps(env, p_install_steps);
                         const auto stepNumber = Number::New(env, current_step);
 
-                        jsCallback({installSteps, stepNumber});
+                        started.unlock();
+                        manager->FUIUpdateState({installSteps, stepNumber});
 
-                        std::lock_guard<std::mutex> lock(mtx);
-                        result = Create(return_value_void{nullptr});
-                        completed = true;
-                        cv.notify_one();
+                        call->Complete(Create(return_value_void{nullptr}));
                     }
                     catch (const Napi::Error &e)
                     {
                         callbackLogger.LogError(e);
-                        std::lock_guard<std::mutex> lock(mtx);
-                        result = Create(return_value_void{Copy(GetErrorMessage(e))});
-                        completed = true;
-                        cv.notify_one();
+                        call->Complete(Create(return_value_void{Copy(GetErrorMessage(e))}));
                     }
                 };
 
@@ -642,10 +656,7 @@ namespace Bindings::ModInstaller
                     return Create(return_value_void{Copy(u"Failed to queue async call")});
                 }
 
-                std::unique_lock<std::mutex> lock(mtx);
-                cv.wait(lock, [&completed]
-                        { return completed; });
-
+                const auto result = call->Wait();
                 logger.Log("Blocking call completed");
                 return result;
             }
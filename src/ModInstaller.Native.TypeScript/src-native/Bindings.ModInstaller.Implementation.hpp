@@ -1,12 +1,20 @@
 #ifndef VE_MODINSTALLER_IMPL_GUARD_HPP_
 #define VE_MODINSTALLER_IMPL_GUARD_HPP_
 
+#include <algorithm>
+#include <mutex>
 #include <thread>
+#include <unordered_map>
+#include <vector>
 #include "ModInstaller.Native.h"
 #include "Logger.hpp"
 #include "Utils.Return.hpp"
+#include "Utils.Recording.hpp"
+#include "Utils.DirectorySnapshot.hpp"
+#include "Utils.CompactResult.hpp"
 #include "Bindings.ModInstaller.hpp"
 #include "Bindings.ModInstaller.Callbacks.hpp"
+#include "Bindings.InstallResult.Implementation.hpp"
 
 using namespace Napi;
 using namespace Utils;
@@ -14,6 +22,17 @@ using namespace ModInstaller::Native;
 
 namespace Bindings::ModInstaller
 {
+    // Stop pattern sets registered by id, kept as the JSON install() hands to ModInstaller.Native
+    // so the same text reaches its compiled set cache on every install
+    static std::mutex StopPatternSetsMutex;
+    static std::unordered_map<int32_t, std::u16string> StopPatternSets;
+    static int32_t NextStopPatternSetId = 1;
+
+    // Handlers released by collected ModInstallers, a host constructing one per install reuses them
+    static constexpr size_t MaxPooledHandlers = 4;
+    static std::mutex HandlerPoolMutex;
+    static std::vector<Handler *> HandlerPool;
+
     static void TSFNFunction(const Napi::CallbackInfo &info)
     {
         LoggerScope logger(__FUNCTION__);
@@ -102,13 +121,162 @@ namespace Bindings::ModInstaller
         }
     }
 
+    // Releases the directory snapshots taken during the install and lets the handler be reset, before resolving it
+    static void EndInstall(param_ptr *p_owner)
+    {
+        const auto data = static_cast<const ResultCallbackData *>(p_owner);
+        if (data->ended)
+        {
+            data->ended();
+        }
+    }
+
+    static void HandleInstallResultCallback(param_ptr *p_owner, return_value_json *returnData)
+    {
+        EndInstall(p_owner);
+        HandleJsonResultCallback(p_owner, returnData);
+    }
+
+    // Builds the same object JSON.parse gives for the JSON result, sharing one JS string per table entry.
+    // Strings are created when an instruction first uses them, directories only referenced as prefixes never are
+    class CompactInstallResultBuilder
+    {
+    private:
+        const Napi::Env _env;
+        const CompactResult::Index *_index = nullptr;
+        std::vector<Napi::Value> _strings;
+        std::string _buffer;
+        std::vector<Napi::Value> _types;
+        const Napi::String _type, _source, _destination, _section, _key, _value, _data, _priority;
+
+        Napi::Value StringValue(const int32_t index)
+        {
+            auto &value = _strings[index];
+            if (value.IsEmpty())
+            {
+                _index->String(static_cast<uint32_t>(index), _buffer);
+                value = Napi::String::New(_env, _buffer);
+            }
+            return value;
+        }
+
+        void SetString(Object &object, const Napi::String &name, const int32_t index)
+        {
+            if (index != -1)
+            {
+                object.Set(name, StringValue(index));
+            }
+        }
+
+    public:
+        Object Result;
+        Napi::Array Instructions;
+
+        explicit CompactInstallResultBuilder(const Napi::Env env)
+            : _env(env),
+              _type(Napi::String::New(env, "type")),
+              _source(Napi::String::New(env, "source")),
+              _destination(Napi::String::New(env, "destination")),
+              _section(Napi::String::New(env, "section")),
+              _key(Napi::String::New(env, "key")),
+              _value(Napi::String::New(env, "value")),
+              _data(Napi::String::New(env, "data")),
+              _priority(Napi::String::New(env, "priority")),
+              Result(Object::New(env))
+        {
+            for (const auto name : CompactResult::TypeNames)
+            {
+                _types.push_back(Napi::String::New(env, name));
+            }
+        }
+
+        void Begin(const CompactResult::Index &index)
+        {
+            _index = &index;
+            _strings.resize(index.StringCount());
+            if (index.Message() != -1)
+            {
+                Result.Set("message", StringValue(index.Message()));
+            }
+            Instructions = Napi::Array::New(_env, index.Count());
+            Result.Set("instructions", Instructions);
+        }
+
+        void Instruction(const uint32_t index, const CompactResult::Instruction &instruction)
+        {
+            auto object = Object::New(_env);
+            if (instruction.type == CompactResult::OtherType)
+            {
+                SetString(object, _type, instruction.typeName);
+            }
+            else
+            {
+                object.Set(_type, _types[instruction.type]);
+            }
+            SetString(object, _source, instruction.source);
+            SetString(object, _destination, instruction.destination);
+            if (instruction.hasIni)
+            {
+                SetString(object, _section, instruction.section);
+                SetString(object, _key, instruction.key);
+                SetString(object, _value, instruction.value);
+            }
+            if (instruction.hasData)
+            {
+                object.Set(_data, Buffer<uint8_t>::Copy(_env, instruction.data, instruction.dataLength));
+            }
+            object.Set(_priority, Number::New(_env, instruction.priority));
+            Instructions.Set(index, object);
+        }
+
+        void Decisions(const char *data, const uint32_t length)
+        {
+            if (length > 0)
+            {
+                Result.Set("decisions", JSONParse(Napi::String::New(_env, data, length)));
+            }
+        }
+    };
+
+    static Napi::Value DecodeInstallResult(const Napi::Env env, del_bytes &data, const size_t length)
+    {
+        CompactInstallResultBuilder builder(env);
+        const auto error = CompactResult::Decode(data.get(), length, builder);
+        if (error != nullptr)
+        {
+            NAPI_THROW(Error::New(env, error));
+        }
+        return builder.Result;
+    }
+
+    static void HandleCompactInstallResultCallback(param_ptr *p_owner, return_value_data *returnData)
+    {
+        EndInstall(p_owner);
+        HandleDataResultCallback<DecodeInstallResult>(p_owner, returnData);
+    }
+
+    static void HandleLazyInstallResultCallback(param_ptr *p_owner, return_value_data *returnData)
+    {
+        EndInstall(p_owner);
+        HandleDataResultCallback<InstallResult::NativeInstallResult::Create>(p_owner, returnData);
+    }
+
     Object ModInstaller::Init(const Napi::Env env, Object exports)
     {
         // This method is used to hook the accessor and method callbacks
         const auto func = DefineClass(env, "ModInstaller",
                                       {
                                           InstanceMethod<&ModInstaller::Install>("install", static_cast<napi_property_attributes>(napi_writable | napi_configurable)),
+                                          InstanceMethod<&ModInstaller::InstallCompact>("installCompact", static_cast<napi_property_attributes>(napi_writable | napi_configurable)),
+                                          InstanceMethod<&ModInstaller::InstallLazy>("installLazy", static_cast<napi_property_attributes>(napi_writable | napi_configurable)),
+                                          InstanceMethod<&ModInstaller::Reset>("reset", static_cast<napi_property_attributes>(napi_writable | napi_configurable)),
+                                          InstanceMethod<&ModInstaller::GetImage>("getImage", static_cast<napi_property_attributes>(napi_writable | napi_configurable)),
+                                          InstanceMethod<&ModInstaller::ImagePrefetchStats>("imagePrefetchStats", static_cast<napi_property_attributes>(napi_writable | napi_configurable)),
                                           StaticMethod<&ModInstaller::TestSupported>("testSupported", static_cast<napi_property_attributes>(napi_writable | napi_configurable)),
+                                          StaticMethod<&ModInstaller::TestSupportedAsync>("testSupportedAsync", static_cast<napi_property_attributes>(napi_writable | napi_configurable)),
+                                          StaticMethod<&ModInstaller::TestSupportedMany>("testSupportedMany", static_cast<napi_property_attributes>(napi_writable | napi_configurable)),
+                                          StaticMethod<&ModInstaller::RegisterStopPatterns>("registerStopPatterns", static_cast<napi_property_attributes>(napi_writable | napi_configurable)),
+                                          StaticMethod<&ModInstaller::UnregisterStopPatterns>("unregisterStopPatterns", static_cast<napi_property_attributes>(napi_writable | napi_configurable)),
                                       });
 
         auto *const constructor = new FunctionReference();
@@ -129,15 +297,56 @@ namespace Bindings::ModInstaller
         // possible to supply a custom deleter.
         const_cast<Napi::Env &>(env).SetInstanceData<FunctionReference>(constructor);
 
+        napi_add_env_cleanup_hook(env, Handler::DrainPool, static_cast<napi_env>(env));
+
         return exports;
     }
 
-    ModInstaller::ModInstaller(const CallbackInfo &info) : ObjectWrap<ModInstaller>(info)
+    Handler::Handler(const Napi::Env env) : _env(env)
     {
-        LoggerScope logger(__FUNCTION__);
+        const auto result = create_handler(this,
+                                           Utils::Recording::RecordPluginsGetAll<pluginsGetAll>,
+                                           Utils::Recording::RecordContextGet<Utils::Recording::Kind::ContextGetAppVersion, contextGetAppVersion>,
+                                           Utils::Recording::RecordContextGet<Utils::Recording::Kind::ContextGetCurrentGameVersion, contextGetCurrentGameVersion>,
+                                           Utils::Recording::RecordContextGetExtenderVersion<contextGetExtenderVersion>,
+                                           Utils::Recording::RecordUIStartDialog<uiStartDialog>,
+                                           Utils::Recording::RecordUIEndDialog<uiEndDialog>,
+                                           Utils::Recording::RecordUIUpdateState<uiUpdateState>);
+        this->Instance = ThrowOrReturnPtr(env, result);
+
+        // Initialize thread-safe function wrappers for synchronous callbacks
+        // Every call passes a callback that calls the bound function, the function given here is never called
+        const auto unbound = Napi::Function::New(env, TSFNFunction);
+        this->TSFN = Napi::ThreadSafeFunction::New(env, unbound, "TSFN", 0, 1);
+        this->TSFNPluginsGetAll = Napi::ThreadSafeFunction::New(env, unbound, "PluginsGetAll", 0, 1);
+        this->TSFNContextGetAppVersion = Napi::ThreadSafeFunction::New(env, unbound, "ContextGetAppVersion", 0, 1);
+        this->TSFNContextGetCurrentGameVersion = Napi::ThreadSafeFunction::New(env, unbound, "ContextGetCurrentGameVersion", 0, 1);
+        this->TSFNContextGetExtenderVersion = Napi::ThreadSafeFunction::New(env, unbound, "ContextGetExtenderVersion", 0, 1);
+        this->TSFNUIStartDialog = Napi::ThreadSafeFunction::New(env, unbound, "UIStartDialog", 0, 1);
+        this->TSFNUIEndDialog = Napi::ThreadSafeFunction::New(env, unbound, "UIEndDialog", 0, 1);
+        this->TSFNUIUpdateState = Napi::ThreadSafeFunction::New(env, unbound, "UIUpdateState", 0, 1);
+
+        this->MainThreadId = std::this_thread::get_id();
+    }
+
+    Handler::~Handler()
+    {
+        // Release thread-safe functions
+        this->TSFN.Release();
+        this->TSFNPluginsGetAll.Release();
+        this->TSFNContextGetAppVersion.Release();
+        this->TSFNContextGetCurrentGameVersion.Release();
+        this->TSFNContextGetExtenderVersion.Release();
+        this->TSFNUIStartDialog.Release();
+        this->TSFNUIEndDialog.Release();
+        this->TSFNUIUpdateState.Release();
 
-        const auto env = Env();
-        this->TSFN = Napi::ThreadSafeFunction::New(env, Napi::Function::New(env, TSFNFunction), "TSFN", 0, 1);
+        // The function references are deleted with the handler, pooled ones were already reset
+        del_void del{dispose_handler(this->Instance)};
+    }
+
+    void Handler::Bind(const CallbackInfo &info)
+    {
         this->FPluginsGetAll = Persistent(info[0].As<Function>());
         this->FContextGetAppVersion = Persistent(info[1].As<Function>());
         this->FContextGetCurrentGameVersion = Persistent(info[2].As<Function>());
@@ -145,93 +354,326 @@ namespace Bindings::ModInstaller
         this->FUIStartDialog = Persistent(info[4].As<Function>());
         this->FUIEndDialog = Persistent(info[5].As<Function>());
         this->FUIUpdateState = Persistent(info[6].As<Function>());
+    }
 
-        // Initialize thread-safe function wrappers for synchronous callbacks
-        this->TSFNPluginsGetAll = Napi::ThreadSafeFunction::New(env, this->FPluginsGetAll.Value(), "PluginsGetAll", 0, 1);
-        this->TSFNContextGetAppVersion = Napi::ThreadSafeFunction::New(env, this->FContextGetAppVersion.Value(), "ContextGetAppVersion", 0, 1);
-        this->TSFNContextGetCurrentGameVersion = Napi::ThreadSafeFunction::New(env, this->FContextGetCurrentGameVersion.Value(), "ContextGetCurrentGameVersion", 0, 1);
-        this->TSFNContextGetExtenderVersion = Napi::ThreadSafeFunction::New(env, this->FContextGetExtenderVersion.Value(), "ContextGetExtenderVersion", 0, 1);
-        this->TSFNUIStartDialog = Napi::ThreadSafeFunction::New(env, this->FUIStartDialog.Value(), "UIStartDialog", 0, 1);
-        this->TSFNUIEndDialog = Napi::ThreadSafeFunction::New(env, this->FUIEndDialog.Value(), "UIEndDialog", 0, 1);
-        this->TSFNUIUpdateState = Napi::ThreadSafeFunction::New(env, this->FUIUpdateState.Value(), "UIUpdateState", 0, 1);
+    // Pooled thread-safe functions must not keep the event loop alive
+    void Handler::SetReferenced(const Napi::Env env, const bool referenced)
+    {
+        for (auto *tsfn : {&this->TSFN, &this->TSFNPluginsGetAll, &this->TSFNContextGetAppVersion, &this->TSFNContextGetCurrentGameVersion,
+                           &this->TSFNContextGetExtenderVersion, &this->TSFNUIStartDialog, &this->TSFNUIEndDialog, &this->TSFNUIUpdateState})
+        {
+            if (referenced)
+            {
+                tsfn->Ref(env);
+            }
+            else
+            {
+                tsfn->Unref(env);
+            }
+        }
+    }
 
-        const auto result = create_handler(this,
-                                           pluginsGetAll,
-                                           contextGetAppVersion,
-                                           contextGetCurrentGameVersion,
-                                           contextGetExtenderVersion,
-                                           uiStartDialog,
-                                           uiEndDialog,
-                                           uiUpdateState);
-        this->_pInstance = ThrowOrReturnPtr(env, result);
+    Handler *Handler::Acquire(const Napi::Env env, const CallbackInfo &info)
+    {
+        Handler *handler = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(HandlerPoolMutex);
+            const auto it = std::find_if(HandlerPool.begin(), HandlerPool.end(), [&env](const Handler *pooled)
+                                         { return pooled->_env == static_cast<napi_env>(env); });
+            if (it != HandlerPool.end())
+            {
+                handler = *it;
+                HandlerPool.erase(it);
+            }
+        }
 
-        this->MainThreadId = std::this_thread::get_id();
+        if (handler == nullptr)
+        {
+            handler = new Handler(env);
+        }
+        else
+        {
+            handler->SetReferenced(env, true);
+        }
+        handler->Bind(info);
+        return handler;
+    }
+
+    void Handler::Release(Handler *handler)
+    {
+        {
+            // A running install still calls into the handler and its callbacks, the last one to end releases it
+            std::lock_guard<std::mutex> lock(handler->_lifetimeMutex);
+            if (handler->PendingInstalls.load() != 0)
+            {
+                handler->_orphaned = true;
+                return;
+            }
+        }
+        Recycle(handler);
+    }
+
+    void Handler::EndInstall()
+    {
+        {
+            std::lock_guard<std::mutex> lock(this->_lifetimeMutex);
+            if (--this->PendingInstalls != 0 || !this->_orphaned)
+            {
+                return;
+            }
+        }
+
+        // ModInstaller.Native is still in the call that delivered the result, and the references
+        // can only be reset on the JS thread, so the handler is released from there
+        this->TSFN.NonBlockingCall([handler = this](Napi::Env, Napi::Function)
+                                   { Recycle(handler); });
+    }
+
+    void Handler::Recycle(Handler *handler)
+    {
+        // The callbacks belong to the ModInstaller, they can be collected with it
+        handler->FPluginsGetAll.Reset();
+        handler->FContextGetAppVersion.Reset();
+        handler->FContextGetCurrentGameVersion.Reset();
+        handler->FContextGetExtenderVersion.Reset();
+        handler->FUIStartDialog.Reset();
+        handler->FUIEndDialog.Reset();
+        handler->FUIUpdateState.Reset();
+        handler->_orphaned = false;
+        handler->SetReferenced(Napi::Env(handler->_env), false);
+
+        {
+            std::lock_guard<std::mutex> lock(HandlerPoolMutex);
+            if (HandlerPool.size() < MaxPooledHandlers)
+            {
+                HandlerPool.push_back(handler);
+                return;
+            }
+        }
+        delete handler;
+    }
+
+    void Handler::DrainPool(void *env)
+    {
+        std::vector<Handler *> drained;
+        {
+            std::lock_guard<std::mutex> lock(HandlerPoolMutex);
+            const auto it = std::partition(HandlerPool.begin(), HandlerPool.end(), [env](const Handler *pooled)
+                                           { return pooled->_env != static_cast<napi_env>(env); });
+            drained.assign(it, HandlerPool.end());
+            HandlerPool.erase(it, HandlerPool.end());
+        }
+        for (auto *handler : drained)
+        {
+            delete handler;
+        }
+    }
+
+    ModInstaller::ModInstaller(const CallbackInfo &info) : ObjectWrap<ModInstaller>(info)
+    {
+        LoggerScope logger(__FUNCTION__);
+
+        this->_handler = Handler::Acquire(Env(), info);
     }
 
     ModInstaller::~ModInstaller()
     {
         LoggerScope logger(__FUNCTION__);
 
-        // Release thread-safe functions
-        this->TSFN.Release();
-        this->TSFNPluginsGetAll.Release();
-        this->TSFNContextGetAppVersion.Release();
-        this->TSFNContextGetCurrentGameVersion.Release();
-        this->TSFNContextGetExtenderVersion.Release();
-        this->TSFNUIStartDialog.Release();
-        this->TSFNUIEndDialog.Release();
-        this->TSFNUIUpdateState.Release();
+        Handler::Release(this->_handler);
+    }
+
+    // Binds the instance to the callbacks of the next install, so a host can keep one ModInstaller for all of them
+    void ModInstaller::Reset(const CallbackInfo &info)
+    {
+        LoggerScope logger(__FUNCTION__);
 
-        // Release function references
-        this->FPluginsGetAll.Unref();
-        this->FContextGetAppVersion.Unref();
-        this->FContextGetCurrentGameVersion.Unref();
-        this->FContextGetExtenderVersion.Unref();
-        this->FUIStartDialog.Unref();
-        this->FUIEndDialog.Unref();
-        this->FUIUpdateState.Unref();
-        dispose_handler(this->_pInstance);
+        try
+        {
+            if (this->_handler->PendingInstalls.load() != 0)
+            {
+                NAPI_THROW_VOID(Error::New(info.Env(), "Can't reset a ModInstaller while an install is running"));
+            }
+            this->_handler->Bind(info);
+        }
+        catch (const Napi::Error &e)
+        {
+            logger.LogError(e);
+            throw;
+        }
+        catch (const std::exception &e)
+        {
+            logger.LogException(e);
+            throw;
+        }
+        catch (...)
+        {
+            logger.Log("Unknown exception");
+            throw;
+        }
+    }
+
+    // Images prefetched for the dialog of this instance's install, null when not (yet) read
+    Value ModInstaller::GetImage(const CallbackInfo &info)
+    {
+        LoggerScope logger(__FUNCTION__);
+
+        try
+        {
+            const auto env = info.Env();
+            const auto path = info[0].As<String>();
+
+            const auto pathCopy = CopyWithFree(path.Utf16Value());
+
+            const auto result = get_image(this->_handler->Instance, pathCopy.get());
+            return ThrowOrReturnBuffer(env, result);
+        }
+        catch (const Napi::Error &e)
+        {
+            logger.LogError(e);
+            throw;
+        }
+        catch (const std::exception &e)
+        {
+            logger.LogException(e);
+            throw;
+        }
+        catch (...)
+        {
+            logger.Log("Unknown exception");
+            throw;
+        }
+    }
+
+    Value ModInstaller::ImagePrefetchStats(const CallbackInfo &info)
+    {
+        LoggerScope logger(__FUNCTION__);
+
+        try
+        {
+            const auto env = info.Env();
+
+            const auto result = image_prefetch_stats(this->_handler->Instance);
+            return ThrowOrReturnJson(env, result);
+        }
+        catch (const Napi::Error &e)
+        {
+            logger.LogError(e);
+            throw;
+        }
+        catch (const std::exception &e)
+        {
+            logger.LogException(e);
+            throw;
+        }
+        catch (...)
+        {
+            logger.Log("Unknown exception");
+            throw;
+        }
     }
 
     Value ModInstaller::Install(const CallbackInfo &info)
     {
-        const auto functionName = __FUNCTION__;
+        return StartInstall(info, __FUNCTION__, InstallResultMode::Json);
+    }
+
+    // Same arguments and result as Install, the result crosses over in the layout of Utils.CompactResult.hpp instead of JSON
+    Value ModInstaller::InstallCompact(const CallbackInfo &info)
+    {
+        return StartInstall(info, __FUNCTION__, InstallResultMode::Compact);
+    }
+
+    // Same arguments as Install, resolves with a NativeInstallResult over the compact result
+    Value ModInstaller::InstallLazy(const CallbackInfo &info)
+    {
+        return StartInstall(info, __FUNCTION__, InstallResultMode::Lazy);
+    }
+
+    Value ModInstaller::StartInstall(const CallbackInfo &info, const char *functionName, const InstallResultMode mode)
+    {
         LoggerScope logger(functionName);
 
         try
         {
             const auto env = info.Env();
             const auto files = JSONStringify(info[0].As<Object>());
-            const auto stopPatterns = JSONStringify(info[1].As<Object>());
+            // Either the patterns or the id of a registered set
+            std::u16string stopPatterns;
+            if (info[1].IsNumber())
+            {
+                std::lock_guard<std::mutex> lock(StopPatternSetsMutex);
+                const auto it = StopPatternSets.find(info[1].As<Number>().Int32Value());
+                if (it == StopPatternSets.end())
+                {
+                    NAPI_THROW(Error::New(env, "Unknown stop pattern set"));
+                }
+                stopPatterns = it->second;
+            }
+            else
+            {
+                stopPatterns = JSONStringify(info[1].As<Object>()).Utf16Value();
+            }
             const auto pluginPathRaw = info[2];
             const auto scriptPath = info[3].As<String>();
             const auto presetRaw = info[4];
             const auto preselect = info[5].As<Boolean>();
             const auto validate = info[6].As<Boolean>();
+            // Optional, never opens the dialog and reports the choices in the result
+            const auto headless = info.Length() > 7 && info[7].IsBoolean() && info[7].As<Boolean>().Value();
 
             const auto filesCopy = CopyWithFree(files.Utf16Value());
-            const auto stopPatternsCopy = CopyWithFree(stopPatterns.Utf16Value());
+            const auto stopPatternsCopy = CopyWithFree(stopPatterns);
             const auto pluginPathCopy = pluginPathRaw.IsNull() ? NullStringCopy() : CopyWithFree(pluginPathRaw.As<String>().Utf16Value());
             const auto scriptPathCopy = CopyWithFree(scriptPath.Utf16Value());
             const auto presetCopy = presetRaw.IsUndefined() || presetRaw.IsNull() ? NullStringCopy() : CopyWithFree(JSONStringify(presetRaw.As<Object>()));
             const auto preselectCopy = preselect.Value() ? (uint8_t)1 : (uint8_t)0;
             const auto validateCopy = validate.Value() ? (uint8_t)1 : (uint8_t)0;
+            const auto headlessCopy = headless ? (uint8_t)1 : (uint8_t)0;
+
+            Utils::Recording::RecordInstall(filesCopy.get(), stopPatternsCopy.get(), pluginPathCopy.get(), scriptPathCopy.get(), presetCopy.get(), preselectCopy, validateCopy, headlessCopy);
 
             auto cbData = CreateResultCallbackData(env, functionName);
             const auto deferred = cbData->deferred;
             const auto tsfn = cbData->tsfn;
-
-            const auto result = install(
-                this->_pInstance,
-                filesCopy.get(),
-                stopPatternsCopy.get(),
-                pluginPathCopy.get(),
-                scriptPathCopy.get(),
-                presetCopy.get(),
-                preselectCopy,
-                validateCopy,
-                cbData,
-                HandleJsonResultCallback);
+            const auto snapshotInstall = DirectorySnapshots::BeginInstall();
+            cbData->ended = [handler = this->_handler, snapshotInstall]
+            {
+                DirectorySnapshots::EndInstall(snapshotInstall);
+                handler->EndInstall();
+            };
+            this->_handler->PendingInstalls++;
+
+            const auto result = mode != InstallResultMode::Json
+                                    ? install_compact(
+                                          this->_handler->Instance,
+                                          filesCopy.get(),
+                                          stopPatternsCopy.get(),
+                                          pluginPathCopy.get(),
+                                          scriptPathCopy.get(),
+                                          presetCopy.get(),
+                                          preselectCopy,
+                                          validateCopy,
+                                          headlessCopy,
+                                          cbData,
+                                          mode == InstallResultMode::Lazy ? HandleLazyInstallResultCallback : HandleCompactInstallResultCallback)
+                                    : install(
+                                          this->_handler->Instance,
+                                          filesCopy.get(),
+                                          stopPatternsCopy.get(),
+                                          pluginPathCopy.get(),
+                                          scriptPathCopy.get(),
+                                          presetCopy.get(),
+                                          preselectCopy,
+                                          validateCopy,
+                                          headlessCopy,
+                                          cbData,
+                                          HandleInstallResultCallback);
+            if (result == nullptr || result->error != nullptr)
+            {
+                DirectorySnapshots::EndInstall(snapshotInstall);
+                this->_handler->PendingInstalls--;
+            }
             return ReturnAndHandleReject(env, result, deferred, tsfn);
         }
         catch (const Napi::Error &e)
@@ -251,6 +693,65 @@ namespace Bindings::ModInstaller
         }
     }
 
+    Value ModInstaller::RegisterStopPatterns(const CallbackInfo &info)
+    {
+        LoggerScope logger(__FUNCTION__);
+
+        try
+        {
+            const auto env = info.Env();
+            const auto stopPatterns = JSONStringify(info[0].As<Object>()).Utf16Value();
+
+            std::lock_guard<std::mutex> lock(StopPatternSetsMutex);
+            const auto id = NextStopPatternSetId++;
+            StopPatternSets.emplace(id, stopPatterns);
+            return Number::New(env, id);
+        }
+        catch (const Napi::Error &e)
+        {
+            logger.LogError(e);
+            throw;
+        }
+        catch (const std::exception &e)
+        {
+            logger.LogException(e);
+            throw;
+        }
+        catch (...)
+        {
+            logger.Log("Unknown exception");
+            throw;
+        }
+    }
+
+    void ModInstaller::UnregisterStopPatterns(const CallbackInfo &info)
+    {
+        LoggerScope logger(__FUNCTION__);
+
+        try
+        {
+            const auto id = info[0].As<Number>().Int32Value();
+
+            std::lock_guard<std::mutex> lock(StopPatternSetsMutex);
+            StopPatternSets.erase(id);
+        }
+        catch (const Napi::Error &e)
+        {
+            logger.LogError(e);
+            throw;
+        }
+        catch (const std::exception &e)
+        {
+            logger.LogException(e);
+            throw;
+        }
+        catch (...)
+        {
+            logger.Log("Unknown exception");
+            throw;
+        }
+    }
+
     Value ModInstaller::TestSupported(const CallbackInfo &info)
     {
         LoggerScope logger(__FUNCTION__);
@@ -284,6 +785,87 @@ namespace Bindings::ModInstaller
         }
     }
 
+    Value ModInstaller::TestSupportedAsync(const CallbackInfo &info)
+    {
+        const auto functionName = __FUNCTION__;
+        LoggerScope logger(functionName);
+
+        try
+        {
+            const auto env = info.Env();
+            const auto modArchiveFileList = JSONStringify(info[0].As<Object>());
+            const auto allowedTypes = JSONStringify(info[1].As<Object>());
+
+            const auto modArchiveFileListCopy = CopyWithFree(modArchiveFileList.Utf16Value());
+            const auto allowedTypesCopy = CopyWithFree(allowedTypes.Utf16Value());
+
+            auto cbData = CreateResultCallbackData(env, functionName);
+            const auto deferred = cbData->deferred;
+            const auto tsfn = cbData->tsfn;
+
+            const auto result = test_supported_async(
+                modArchiveFileListCopy.get(),
+                allowedTypesCopy.get(),
+                cbData,
+                HandleJsonResultCallback);
+            return ReturnAndHandleReject(env, result, deferred, tsfn);
+        }
+        catch (const Napi::Error &e)
+        {
+            logger.LogError(e);
+            throw;
+        }
+        catch (const std::exception &e)
+        {
+            logger.LogException(e);
+            throw;
+        }
+        catch (...)
+        {
+            logger.Log("Unknown exception");
+            throw;
+        }
+    }
+
+    Value ModInstaller::TestSupportedMany(const CallbackInfo &info)
+    {
+        const auto functionName = __FUNCTION__;
+        LoggerScope logger(functionName);
+
+        try
+        {
+            const auto env = info.Env();
+            const auto requests = JSONStringify(info[0].As<Object>());
+
+            const auto requestsCopy = CopyWithFree(requests.Utf16Value());
+
+            auto cbData = CreateResultCallbackData(env, functionName);
+            const auto deferred = cbData->deferred;
+            const auto tsfn = cbData->tsfn;
+
+            const auto result = test_supported_many(
+                requestsCopy.get(),
+                cbData,
+                HandleJsonResultCallback);
+            return ReturnAndHandleReject(env, result, deferred, tsfn);
+        }
+        catch (const Napi::Error &e)
+        {
+            logger.LogError(e);
+            throw;
+        }
+        catch (const std::exception &e)
+        {
+            logger.LogException(e);
+            throw;
+        }
+        catch (...)
+        {
+            logger.Log("Unknown exception");
+            throw;
+        }
+    }
+
     Napi::Object Init(const Napi::Env env, const Napi::Object exports)
     {
         ModInstaller::Init(env, exports);
@@ -1,6 +1,9 @@
 #ifndef VE_MODINSTALLER_GUARD_HPP_
 #define VE_MODINSTALLER_GUARD_HPP_
 
+#include <atomic>
+#include <mutex>
+#include <thread>
 #include <napi.h>
 #include "ModInstaller.Native.h"
 #include "Logger.hpp"
@@ -10,7 +13,20 @@ using namespace ModInstaller::Native;
 
 namespace Bindings::ModInstaller
 {
-    class ModInstaller : public Napi::ObjectWrap<ModInstaller>
+    enum class InstallResultMode
+    {
+        Json,
+        Compact,
+        Lazy
+    };
+
+    // What a ModInstaller needs on the native side: its callbacks, the thread-safe functions that reach them
+    // from install threads and the ModInstaller.Native handler, which gets the Handler as its owner.
+    // The thread-safe functions don't call the functions they were created with, so a Handler can be bound
+    // to other callbacks. Released handlers are pooled per environment for the next ModInstaller.
+    // A ModInstaller collected while its install runs leaves the handler orphaned, the install still calls
+    // into it, and the end of the last install hands it back to the pool.
+    class Handler
     {
     public:
         Napi::ThreadSafeFunction TSFN;
@@ -32,16 +48,63 @@ namespace Bindings::ModInstaller
 
         std::thread::id MainThreadId;
 
+        // Installs started and not yet resolved
+        std::atomic<uint32_t> PendingInstalls{0};
+
+        void *Instance = nullptr;
+
+        // Takes a pooled handler of the environment or creates one, then binds it to the callbacks
+        static Handler *Acquire(const Napi::Env env, const CallbackInfo &info);
+        // Pools the handler, or destroys it when the pool is full. With an install still running the
+        // handler is orphaned instead, and released once the last install ends
+        static void Release(Handler *handler);
+        // Called when an install result arrives, on any thread
+        void EndInstall();
+
+        void Bind(const CallbackInfo &info);
+
+        // Environment cleanup hook, destroys the handlers pooled for the environment
+        static void DrainPool(void *env);
+
+    private:
+        const napi_env _env;
+
+        // Guards PendingInstalls against Release marking the handler orphaned
+        std::mutex _lifetimeMutex;
+        bool _orphaned = false;
+
+        explicit Handler(const Napi::Env env);
+        ~Handler();
+
+        void SetReferenced(const Napi::Env env, const bool referenced);
+        // Pools or destroys a handler without installs, on the JS thread
+        static void Recycle(Handler *handler);
+    };
+
+    class ModInstaller : public Napi::ObjectWrap<ModInstaller>
+    {
+    public:
         static Object Init(const Napi::Env env, const Object exports);
 
         ModInstaller(const CallbackInfo &info);
         ~ModInstaller();
 
         Napi::Value Install(const CallbackInfo &info);
+        Napi::Value InstallCompact(const CallbackInfo &info);
+        Napi::Value InstallLazy(const CallbackInfo &info);
+        void Reset(const CallbackInfo &info);
+        Napi::Value GetImage(const CallbackInfo &info);
+        Napi::Value ImagePrefetchStats(const CallbackInfo &info);
         static Napi::Value TestSupported(const CallbackInfo &info);
+        static Napi::Value TestSupportedAsync(const CallbackInfo &info);
+        static Napi::Value TestSupportedMany(const CallbackInfo &info);
+        static Napi::Value RegisterStopPatterns(const CallbackInfo &info);
+        static void UnregisterStopPatterns(const CallbackInfo &info);
 
     private:
-        void *_pInstance;
+        Handler *_handler;
+
+        Napi::Value StartInstall(const CallbackInfo &info, const char *functionName, InstallResultMode mode);
     };
 }
 #endif
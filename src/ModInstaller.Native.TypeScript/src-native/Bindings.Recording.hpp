@@ -0,0 +1,736 @@
+#ifndef VE_RECORDING_GUARD_HPP_
+#define VE_RECORDING_GUARD_HPP_
+
+#include <napi.h>
+#include <algorithm>
+#include <deque>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <thread>
+#include "ModInstaller.Native.h"
+#include "Logger.hpp"
+#include "Utils.Callbacks.hpp"
+#include "Utils.Recording.hpp"
+#include "Utils.Return.hpp"
+#include "Bindings.FileSystem.Callbacks.hpp"
+
+using namespace Napi;
+using namespace Utils;
+using namespace ModInstaller::Native;
+
+namespace Bindings::Recording
+{
+    using Utils::Recording::FieldsOf;
+    using Utils::Recording::FieldType;
+    using Utils::Recording::Kind;
+    using Utils::Recording::RecordReader;
+    using Utils::Recording::RecordWriter;
+
+    struct ReplayAnswer
+    {
+        std::string results;
+        uint64_t durationUs;
+    };
+
+    struct ReplayAction
+    {
+        Kind kind;
+        std::string fields;
+        // Whether the host issued the action while the dialog call was still in progress
+        bool inCall;
+    };
+
+    // A uiStartDialog or uiUpdateState call together with the dialog actions that followed it
+    struct ReplayAnchor
+    {
+        std::string results;
+        uint64_t durationUs;
+        std::vector<ReplayAction> actions;
+    };
+
+    // Serves the answers of a recording in place of the JS FileSystem and ModInstaller callbacks.
+    // Answers are matched by kind and arguments; repeated calls consume them in recorded order
+    // and the last one is kept once the queue runs dry. Dialog calls are matched by position.
+    class ReplaySession
+    {
+    public:
+        std::map<std::string, std::deque<ReplayAnswer>> Answers;
+        std::vector<ReplayAnchor> Anchors;
+        std::string InstallArgs;
+        // Installs recorded against the default FileSystem carry no file system traffic
+        bool HasFileSystem = false;
+        bool HasStat = false;
+        bool Timing = false;
+
+        void *Handler = nullptr;
+        ResultCallbackData *CallbackData = nullptr;
+        std::atomic<bool> Running{false};
+        std::atomic<uint64_t> Answered{0};
+        std::atomic<uint64_t> Missed{0};
+        std::atomic<uint64_t> Actions{0};
+
+        param_ptr *DialogHandler = nullptr;
+        void (*DialogSelect)(param_ptr *, param_int, param_int, param_json *, return_value_void *) = nullptr;
+        void (*DialogContinue)(param_ptr *, param_bool, param_int, return_value_void *) = nullptr;
+        void (*DialogCancel)(param_ptr *, return_value_void *) = nullptr;
+
+        std::mutex Mutex;
+        size_t NextAnchor = 0;
+        std::vector<std::thread> Threads;
+
+        ~ReplaySession()
+        {
+            for (auto &thread : this->Threads)
+            {
+                if (thread.joinable())
+                {
+                    thread.join();
+                }
+            }
+            if (this->Handler != nullptr)
+            {
+                del_void del{dispose_handler(this->Handler)};
+            }
+        }
+
+        static std::string Key(const Kind kind, const std::string &args)
+        {
+            return static_cast<char>(kind) + args;
+        }
+
+        // Returns false when the recording holds no answer for the call
+        bool Take(const Kind kind, const RecordWriter &args, std::string &results)
+        {
+            uint64_t durationUs = 0;
+            {
+                std::lock_guard<std::mutex> lock(this->Mutex);
+                const auto it = this->Answers.find(Key(kind, args.Buffer()));
+                if (it == this->Answers.end())
+                {
+                    this->Missed++;
+                    return false;
+                }
+                auto &queue = it->second;
+                results = queue.front().results;
+                durationUs = queue.front().durationUs;
+                if (queue.size() > 1)
+                {
+                    queue.pop_front();
+                }
+            }
+            this->Answered++;
+            this->Wait(durationUs);
+            return true;
+        }
+
+        void Wait(const uint64_t durationUs) const
+        {
+            if (this->Timing && durationUs > 0)
+            {
+                std::this_thread::sleep_for(std::chrono::microseconds(durationUs));
+            }
+        }
+    };
+
+    inline std::mutex SessionMutex;
+    inline std::unique_ptr<ReplaySession> CurrentSession;
+
+    static std::u16string ToUtf16(const std::string &utf8)
+    {
+        std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t> conv;
+        return conv.from_bytes(utf8);
+    }
+
+    static char16_t *ReadError(RecordReader &reader)
+    {
+        std::string error;
+        return reader.Blob(error) ? Copy(ToUtf16(error)) : nullptr;
+    }
+
+    static char16_t *ReadText(RecordReader &reader)
+    {
+        std::string value;
+        return reader.Blob(value) ? Copy(ToUtf16(value)) : nullptr;
+    }
+
+    static char16_t *MissingAnswer(const char *function)
+    {
+        Logger::Log(function, "No recorded answer");
+        return Copy(ToUtf16(std::string("No recorded answer for ") + function));
+    }
+
+    static ReplaySession *Session(param_ptr *p_owner)
+    {
+        return const_cast<ReplaySession *>(static_cast<const ReplaySession *>(p_owner));
+    }
+
+    static return_value_data *replayReadFileContent(param_ptr *p_owner, param_string *p_file_path, param_int offset, param_int length) noexcept
+    {
+        try
+        {
+            RecordWriter args;
+            args.Text(p_file_path);
+            args.Int(offset);
+            args.Int(length);
+
+            std::string results;
+            if (!Session(p_owner)->Take(Kind::ReadFileContent, args, results))
+            {
+                return Create(return_value_data{MissingAnswer(__FUNCTION__), nullptr, 0});
+            }
+
+            RecordReader reader(results, 0);
+            const auto error = ReadError(reader);
+            std::string data;
+            if (!reader.Blob(data))
+            {
+                return Create(return_value_data{error, nullptr, 0});
+            }
+            return Create(return_value_data{error, Copy(reinterpret_cast<const uint8_t *>(data.data()), data.size()), static_cast<int>(data.size())});
+        }
+        catch (const std::exception &e)
+        {
+            std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t> conv;
+            return Create(return_value_data{Copy(conv.from_bytes(e.what())), nullptr, 0});
+        }
+    }
+
+    template <Kind K>
+    static return_value_json *replayJson(param_ptr *p_owner, const RecordWriter &args, const char *function) noexcept
+    {
+        try
+        {
+            std::string results;
+            if (!Session(p_owner)->Take(K, args, results))
+            {
+                return Create(return_value_json{MissingAnswer(function), nullptr});
+            }
+
+            RecordReader reader(results, 0);
+            const auto error = ReadError(reader);
+            return Create(return_value_json{error, ReadText(reader)});
+        }
+        catch (const std::exception &e)
+        {
+            std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t> conv;
+            return Create(return_value_json{Copy(conv.from_bytes(e.what())), nullptr});
+        }
+    }
+
+    template <Kind K>
+    static return_value_string *replayString(param_ptr *p_owner, const RecordWriter &args, const char *function) noexcept
+    {
+        try
+        {
+            std::string results;
+            if (!Session(p_owner)->Take(K, args, results))
+            {
+                return Create(return_value_string{MissingAnswer(function), nullptr});
+            }
+
+            RecordReader reader(results, 0);
+            const auto error = ReadError(reader);
+            return Create(return_value_string{error, ReadText(reader)});
+        }
+        catch (const std::exception &e)
+        {
+            std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t> conv;
+            return Create(return_value_string{Copy(conv.from_bytes(e.what())), nullptr});
+        }
+    }
+
+    static return_value_json *replayReadDirectoryFileList(param_ptr *p_owner, param_string *p_directory_path, param_string *p_pattern, param_int search_type) noexcept
+    {
+        RecordWriter args;
+        args.Text(p_directory_path);
+        args.Text(p_pattern);
+        args.Int(search_type);
+        return replayJson<Kind::ReadDirectoryFileList>(p_owner, args, __FUNCTION__);
+    }
+
+    static return_value_json *replayReadDirectoryList(param_ptr *p_owner, param_string *p_directory_path) noexcept
+    {
+        RecordWriter args;
+        args.Text(p_directory_path);
+        return replayJson<Kind::ReadDirectoryList>(p_owner, args, __FUNCTION__);
+    }
+
+    static return_value_json *replayStat(param_ptr *p_owner, param_string *p_path) noexcept
+    {
+        RecordWriter args;
+        args.Text(p_path);
+        return replayJson<Kind::Stat>(p_owner, args, __FUNCTION__);
+    }
+
+    static return_value_json *replayPluginsGetAll(param_ptr *p_owner, param_bool active_only) noexcept
+    {
+        RecordWriter args;
+        args.Int(active_only);
+        return replayJson<Kind::PluginsGetAll>(p_owner, args, __FUNCTION__);
+    }
+
+    static return_value_string *replayContextGetAppVersion(param_ptr *p_owner) noexcept
+    {
+        return replayString<Kind::ContextGetAppVersion>(p_owner, RecordWriter(), __FUNCTION__);
+    }
+
+    static return_value_string *replayContextGetCurrentGameVersion(param_ptr *p_owner) noexcept
+    {
+        return replayString<Kind::ContextGetCurrentGameVersion>(p_owner, RecordWriter(), __FUNCTION__);
+    }
+
+    static return_value_string *replayContextGetExtenderVersion(param_ptr *p_owner, param_string *p_extender) noexcept
+    {
+        RecordWriter args;
+        args.Text(p_extender);
+        return replayString<Kind::ContextGetExtenderVersion>(p_owner, args, __FUNCTION__);
+    }
+
+    static void RunActions(ReplaySession *session, const std::vector<ReplayAction> actions) noexcept
+    {
+        for (const auto &action : actions)
+        {
+            try
+            {
+                RecordReader reader(action.fields, 0);
+                if (action.kind == Kind::UISelect)
+                {
+                    const auto groupId = static_cast<int32_t>(reader.Int());
+                    const auto optionId = static_cast<int32_t>(reader.Int());
+                    std::string selectedIds;
+                    const auto selectedIdsCopy = reader.Blob(selectedIds) ? CopyWithFree(ToUtf16(selectedIds)) : NullStringCopy();
+                    session->DialogSelect(session->DialogHandler, groupId, optionId, selectedIdsCopy.get(), Create(return_value_void{nullptr}));
+                }
+                else if (action.kind == Kind::UIContinue)
+                {
+                    const auto goForward = static_cast<uint8_t>(reader.Int());
+                    const auto stepId = static_cast<int32_t>(reader.Int());
+                    session->DialogContinue(session->DialogHandler, goForward, stepId, Create(return_value_void{nullptr}));
+                }
+                else if (action.kind == Kind::UICancel)
+                {
+                    session->DialogCancel(session->DialogHandler, Create(return_value_void{nullptr}));
+                }
+                session->Actions++;
+            }
+            catch (const std::exception &e)
+            {
+                Logger::Log(__FUNCTION__, e.what());
+            }
+        }
+    }
+
+    // Plays back the dialog actions the host issued in response to the next dialog call
+    static return_value_void *replayDialogCall(ReplaySession *session, const char *function) noexcept
+    {
+        try
+        {
+            ReplayAnchor anchor;
+            {
+                std::lock_guard<std::mutex> lock(session->Mutex);
+                if (session->NextAnchor >= session->Anchors.size())
+                {
+                    session->Missed++;
+                    return Create(return_value_void{MissingAnswer(function)});
+                }
+                anchor = session->Anchors[session->NextAnchor++];
+            }
+            session->Answered++;
+            session->Wait(anchor.durationUs);
+
+            std::vector<ReplayAction> inCall;
+            std::vector<ReplayAction> afterCall;
+            for (const auto &action : anchor.actions)
+            {
+                (action.inCall ? inCall : afterCall).push_back(action);
+            }
+
+            // The host answers from another thread while .NET waits on the call, mirror that
+            if (!inCall.empty())
+            {
+                std::thread(RunActions, session, inCall).join();
+            }
+            if (!afterCall.empty())
+            {
+                std::lock_guard<std::mutex> lock(session->Mutex);
+                session->Threads.emplace_back(RunActions, session, afterCall);
+            }
+
+            RecordReader reader(anchor.results, 0);
+            return Create(return_value_void{ReadError(reader)});
+        }
+        catch (const std::exception &e)
+        {
+            std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t> conv;
+            return Create(return_value_void{Copy(conv.from_bytes(e.what()))});
+        }
+    }
+
+    static return_value_void *replayUIStartDialog(param_ptr *p_owner, param_string *p_module_name, param_json *p_image, param_ptr *p_callback_handler,
+                                                  void (*p_select_callback)(param_ptr *, param_int, param_int, param_json *, return_value_void *),
+                                                  void (*p_cont_callback)(param_ptr *, param_bool, param_int, return_value_void *),
+                                                  void (*p_cancel_callback)(param_ptr *, return_value_void *)) noexcept
+    {
+        const auto session = Session(p_owner);
+        {
+            std::lock_guard<std::mutex> lock(session->Mutex);
+            session->DialogHandler = p_callback_handler;
+            session->DialogSelect = p_select_callback;
+            session->DialogContinue = p_cont_callback;
+            session->DialogCancel = p_cancel_callback;
+        }
+        return replayDialogCall(session, __FUNCTION__);
+    }
+
+    static return_value_void *replayUIEndDialog(param_ptr *p_owner) noexcept
+    {
+        try
+        {
+            std::string results;
+            if (!Session(p_owner)->Take(Kind::UIEndDialog, RecordWriter(), results))
+            {
+                return Create(return_value_void{nullptr});
+            }
+            RecordReader reader(results, 0);
+            return Create(return_value_void{ReadError(reader)});
+        }
+        catch (const std::exception &e)
+        {
+            std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t> conv;
+            return Create(return_value_void{Copy(conv.from_bytes(e.what()))});
+        }
+    }
+
+    static return_value_void *replayUIUpdateState(param_ptr *p_owner, param_json *p_install_steps, param_int current_step) noexcept
+    {
+        return replayDialogCall(Session(p_owner), __FUNCTION__);
+    }
+
+    static void HandleReplayResultCallback(param_ptr *p_owner, return_value_json *returnData)
+    {
+        const auto session = Session(p_owner);
+        const auto cbData = session->CallbackData;
+        set_default_file_system_callbacks();
+        session->Running = false;
+        HandleJsonResultCallback(cbData, returnData);
+    }
+
+    static std::unique_ptr<ReplaySession> LoadSession(const std::string &path)
+    {
+        struct Record
+        {
+            Kind kind;
+            int64_t startUs;
+            uint64_t durationUs;
+            std::string args;
+            std::string results;
+        };
+
+        std::ifstream stream(path, std::ios::binary);
+        if (!stream)
+        {
+            throw std::runtime_error("Failed to open recording " + path);
+        }
+        const std::string data((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+
+        RecordReader reader(data, 0);
+        uint32_t magic = 0;
+        for (int i = 0; i < 4; i++)
+        {
+            magic |= static_cast<uint32_t>(reader.Byte()) << (8 * i);
+        }
+        const auto versionLow = reader.Byte();
+        const auto version = static_cast<uint16_t>(versionLow | (reader.Byte() << 8));
+        reader.Byte();
+        reader.Byte();
+        if (magic != Utils::Recording::Magic || version != Utils::Recording::FormatVersion)
+        {
+            throw std::runtime_error("Not a supported recording: " + path);
+        }
+
+        std::vector<Record> records;
+        int64_t startUs = 0;
+        while (!reader.AtEnd())
+        {
+            const auto kind = static_cast<Kind>(reader.Byte());
+            if (kind < Kind::Install || kind >= Kind::Max)
+            {
+                throw std::runtime_error("Recording has an unknown record kind");
+            }
+            reader.Byte();
+            startUs += reader.Int();
+            const auto durationUs = reader.Varint();
+
+            const auto &fields = FieldsOf(kind);
+            const auto argsOffset = reader.Offset();
+            for (const auto field : fields.args)
+                reader.Skip(field);
+            const auto resultsOffset = reader.Offset();
+            for (const auto field : fields.results)
+                reader.Skip(field);
+
+            records.push_back(Record{kind, startUs, durationUs,
+                                     data.substr(argsOffset, resultsOffset - argsOffset),
+                                     data.substr(resultsOffset, reader.Offset() - resultsOffset)});
+        }
+
+        // Records are written as calls complete; bring them back into call order
+        std::stable_sort(records.begin(), records.end(), [](const Record &a, const Record &b)
+                         { return a.startUs < b.startUs; });
+
+        auto session = std::make_unique<ReplaySession>();
+        auto hasInstall = false;
+        int64_t anchorEndUs = 0;
+        for (auto &record : records)
+        {
+            switch (record.kind)
+            {
+            case Kind::Install:
+                if (hasInstall)
+                {
+                    Logger::Log(__FUNCTION__, "Recording holds more than one install, replaying the first");
+                    return session;
+                }
+                session->InstallArgs = record.args;
+                hasInstall = true;
+                break;
+            case Kind::UIStartDialog:
+            case Kind::UIUpdateState:
+                session->Anchors.push_back(ReplayAnchor{record.results, record.durationUs, {}});
+                anchorEndUs = record.startUs + static_cast<int64_t>(record.durationUs);
+                break;
+            case Kind::UISelect:
+            case Kind::UIContinue:
+            case Kind::UICancel:
+                if (!session->Anchors.empty())
+                {
+                    session->Anchors.back().actions.push_back(ReplayAction{record.kind, record.args, record.startUs <= anchorEndUs});
+                }
+                break;
+            default:
+                session->HasFileSystem |= record.kind == Kind::ReadFileContent || record.kind == Kind::ReadDirectoryFileList || record.kind == Kind::ReadDirectoryList || record.kind == Kind::Stat;
+                session->HasStat |= record.kind == Kind::Stat;
+                session->Answers[ReplaySession::Key(record.kind, record.args)].push_back(ReplayAnswer{record.results, record.durationUs});
+                break;
+            }
+        }
+
+        if (!hasInstall)
+        {
+            throw std::runtime_error("Recording holds no install: " + path);
+        }
+        return session;
+    }
+
+    Value StartRecording(const CallbackInfo &info)
+    {
+        LoggerScope logger(__FUNCTION__);
+
+        try
+        {
+            const auto env = info.Env();
+            const auto path = info[0].As<String>().Utf8Value();
+
+            if (!Utils::Recording::Recorder::Start(path))
+            {
+                NAPI_THROW(Error::New(env, "Failed to start recording to " + path));
+            }
+            return env.Undefined();
+        }
+        catch (const Napi::Error &e)
+        {
+            logger.LogError(e);
+            throw;
+        }
+        catch (const std::exception &e)
+        {
+            logger.LogException(e);
+            throw;
+        }
+        catch (...)
+        {
+            logger.Log("Unknown exception");
+            throw;
+        }
+    }
+
+    Value StopRecording(const CallbackInfo &info)
+    {
+        LoggerScope logger(__FUNCTION__);
+
+        try
+        {
+            const auto env = info.Env();
+            const auto [records, bytes] = Utils::Recording::Recorder::Stop();
+
+            auto stats = Object::New(env);
+            stats.Set("records", Number::New(env, static_cast<double>(records)));
+            stats.Set("bytes", Number::New(env, static_cast<double>(bytes)));
+            return stats;
+        }
+        catch (const Napi::Error &e)
+        {
+            logger.LogError(e);
+            throw;
+        }
+        catch (const std::exception &e)
+        {
+            logger.LogException(e);
+            throw;
+        }
+        catch (...)
+        {
+            logger.Log("Unknown exception");
+            throw;
+        }
+    }
+
+    Value ReplayInstall(const CallbackInfo &info)
+    {
+        const auto functionName = __FUNCTION__;
+        LoggerScope logger(functionName);
+
+        try
+        {
+            const auto env = info.Env();
+            const auto path = info[0].As<String>().Utf8Value();
+            const auto timing = info.Length() > 1 && info[1].IsObject() && info[1].As<Object>().Get("timing").ToBoolean().Value();
+
+            std::lock_guard<std::mutex> lock(SessionMutex);
+            if (CurrentSession != nullptr && CurrentSession->Running)
+            {
+                NAPI_THROW(Error::New(env, "A replay is already running"));
+            }
+            CurrentSession.reset();
+
+            auto session = LoadSession(path);
+            session->Timing = timing;
+            session->Handler = ThrowOrReturnPtr(env, create_handler(session.get(),
+                                                                    replayPluginsGetAll,
+                                                                    replayContextGetAppVersion,
+                                                                    replayContextGetCurrentGameVersion,
+                                                                    replayContextGetExtenderVersion,
+                                                                    replayUIStartDialog,
+                                                                    replayUIEndDialog,
+                                                                    replayUIUpdateState));
+
+            const auto fileSystemResult = session->HasFileSystem
+                                              ? set_file_system_callbacks(session.get(), replayReadFileContent, replayReadDirectoryFileList, replayReadDirectoryList,
+                                                                          session->HasStat ? replayStat : nullptr,
+                                                                          session->HasStat ? FileSystem::openFile<replayReadFileContent, replayStat> : FileSystem::openFile<replayReadFileContent, nullptr>,
+                                                                          FileSystem::readFile<replayReadFileContent>,
+                                                                          FileSystem::closeFile)
+                                              : set_default_file_system_callbacks();
+            if (fileSystemResult != 0)
+            {
+                NAPI_THROW(Error::New(env, "Failed to set file system callbacks"));
+            }
+
+            RecordReader reader(session->InstallArgs, 0);
+            std::string files, stopPatterns, pluginPath, scriptPath, preset;
+            const auto hasFiles = reader.Blob(files);
+            const auto hasStopPatterns = reader.Blob(stopPatterns);
+            const auto hasPluginPath = reader.Blob(pluginPath);
+            const auto hasScriptPath = reader.Blob(scriptPath);
+            const auto hasPreset = reader.Blob(preset);
+            const auto preselect = static_cast<uint8_t>(reader.Int());
+            const auto validate = static_cast<uint8_t>(reader.Int());
+            const auto headless = static_cast<uint8_t>(reader.Int());
+
+            const auto filesCopy = hasFiles ? CopyWithFree(ToUtf16(files)) : NullStringCopy();
+            const auto stopPatternsCopy = hasStopPatterns ? CopyWithFree(ToUtf16(stopPatterns)) : NullStringCopy();
+            const auto pluginPathCopy = hasPluginPath ? CopyWithFree(ToUtf16(pluginPath)) : NullStringCopy();
+            const auto scriptPathCopy = hasScriptPath ? CopyWithFree(ToUtf16(scriptPath)) : NullStringCopy();
+            const auto presetCopy = hasPreset ? CopyWithFree(ToUtf16(preset)) : NullStringCopy();
+
+            auto cbData = CreateResultCallbackData(env, functionName);
+            const auto deferred = cbData->deferred;
+            const auto tsfn = cbData->tsfn;
+
+            session->CallbackData = cbData;
+            session->Running = true;
+            CurrentSession = std::move(session);
+
+            const auto result = install(
+                CurrentSession->Handler,
+                filesCopy.get(),
+                stopPatternsCopy.get(),
+                pluginPathCopy.get(),
+                scriptPathCopy.get(),
+                presetCopy.get(),
+                preselect,
+                validate,
+                headless,
+                CurrentSession.get(),
+                HandleReplayResultCallback);
+            if (result == nullptr || result->error != nullptr)
+            {
+                set_default_file_system_callbacks();
+                CurrentSession->Running = false;
+            }
+            return ReturnAndHandleReject(env, result, deferred, tsfn);
+        }
+        catch (const Napi::Error &e)
+        {
+            logger.LogError(e);
+            throw;
+        }
+        catch (const std::exception &e)
+        {
+            logger.LogException(e);
+            throw;
+        }
+        catch (...)
+        {
+            logger.Log("Unknown exception");
+            throw;
+        }
+    }
+
+    Value GetReplayStats(const CallbackInfo &info)
+    {
+        LoggerScope logger(__FUNCTION__);
+
+        try
+        {
+            const auto env = info.Env();
+
+            std::lock_guard<std::mutex> lock(SessionMutex);
+            auto stats = Object::New(env);
+            const auto session = CurrentSession.get();
+            stats.Set("running", Boolean::New(env, session != nullptr && session->Running));
+            stats.Set("answered", Number::New(env, session == nullptr ? 0 : static_cast<double>(session->Answered)));
+            stats.Set("missed", Number::New(env, session == nullptr ? 0 : static_cast<double>(session->Missed)));
+            stats.Set("dialogActions", Number::New(env, session == nullptr ? 0 : static_cast<double>(session->Actions)));
+            return stats;
+        }
+        catch (const Napi::Error &e)
+        {
+            logger.LogError(e);
+            throw;
+        }
+        catch (const std::exception &e)
+        {
+            logger.LogException(e);
+            throw;
+        }
+        catch (...)
+        {
+            logger.Log("Unknown exception");
+            throw;
+        }
+    }
+
+    Object Init(const Env env, Object exports)
+    {
+        exports.Set("startRecording", Function::New(env, StartRecording));
+        exports.Set("stopRecording", Function::New(env, StopRecording));
+        exports.Set("replayInstall", Function::New(env, ReplayInstall));
+        exports.Set("getReplayStats", Function::New(env, GetReplayStats));
+
+        return exports;
+    }
+}
+#endif
@@ -0,0 +1,160 @@
+#ifndef VE_RUNTIME_GUARD_HPP_
+#define VE_RUNTIME_GUARD_HPP_
+
+#include <cstdlib>
+#include <optional>
+#include <string>
+#include <vector>
+#include <napi.h>
+#include "ModInstaller.Native.h"
+#include "Logger.hpp"
+#include "Utils.Callbacks.hpp"
+#include "Utils.Return.hpp"
+
+using namespace Napi;
+using namespace Utils;
+using namespace ModInstaller::Native;
+
+namespace Bindings::Runtime
+{
+    Value Warmup(const CallbackInfo &info)
+    {
+        const auto functionName = __FUNCTION__;
+        LoggerScope logger(functionName);
+
+        try
+        {
+            const auto env = info.Env();
+            const auto optionsRaw = info[0];
+
+            const auto optionsCopy = optionsRaw.IsUndefined() || optionsRaw.IsNull() ? NullStringCopy() : CopyWithFree(JSONStringify(optionsRaw.As<Object>()).Utf16Value());
+
+            auto cbData = CreateResultCallbackData(env, functionName);
+            const auto deferred = cbData->deferred;
+            const auto tsfn = cbData->tsfn;
+
+            const auto result = warmup(optionsCopy.get(), cbData, HandleJsonResultCallback);
+            return ReturnAndHandleReject(env, result, deferred, tsfn);
+        }
+        catch (const Napi::Error &e)
+        {
+            logger.LogError(e);
+            throw;
+        }
+        catch (const std::exception &e)
+        {
+            logger.LogException(e);
+            throw;
+        }
+        catch (...)
+        {
+            logger.Log("Unknown exception");
+            throw;
+        }
+    }
+
+    struct StartupVariable
+    {
+        const char *name;
+        std::optional<std::string> previous;
+    };
+
+    // The runtime reads these when it starts, so they only apply while no other binding has called into it.
+    // configure_runtime rejects a later call asking for something else
+    static StartupVariable SetStartupVariable(const char *name, const std::string &value)
+    {
+        const auto current = std::getenv(name);
+        StartupVariable variable{name, current != nullptr ? std::optional<std::string>(current) : std::nullopt};
+#ifdef _WIN32
+        _putenv_s(name, value.c_str());
+#else
+        setenv(name, value.c_str(), 1);
+#endif
+        return variable;
+    }
+
+    // A rejected call leaves the environment as it found it, child processes inherit it
+    static void RestoreStartupVariable(const StartupVariable &variable)
+    {
+#ifdef _WIN32
+        _putenv_s(variable.name, variable.previous.value_or("").c_str());
+#else
+        if (variable.previous.has_value())
+        {
+            setenv(variable.name, variable.previous->c_str(), 1);
+        }
+        else
+        {
+            unsetenv(variable.name);
+        }
+#endif
+    }
+
+    Value ConfigureRuntime(const CallbackInfo &info)
+    {
+        LoggerScope logger(__FUNCTION__);
+
+        try
+        {
+            const auto env = info.Env();
+            const auto optionsRaw = info[0];
+
+            std::vector<StartupVariable> written;
+            if (optionsRaw.IsObject())
+            {
+                const auto options = optionsRaw.As<Object>();
+                const auto gcServer = options.Get("gcServer");
+                const auto gcConserveMemory = options.Get("gcConserveMemory");
+                if (gcConserveMemory.IsNumber() && (gcConserveMemory.As<Number>().Int32Value() < 0 || gcConserveMemory.As<Number>().Int32Value() > 9))
+                {
+                    NAPI_THROW(RangeError::New(env, "gcConserveMemory must be between 0 and 9"));
+                }
+
+                if (gcServer.IsBoolean())
+                {
+                    written.push_back(SetStartupVariable("DOTNET_gcServer", gcServer.As<Boolean>().Value() ? "1" : "0"));
+                }
+                if (gcConserveMemory.IsNumber())
+                {
+                    written.push_back(SetStartupVariable("DOTNET_GCConserveMemory", std::to_string(gcConserveMemory.As<Number>().Int32Value())));
+                }
+            }
+
+            const auto optionsCopy = optionsRaw.IsUndefined() || optionsRaw.IsNull() ? NullStringCopy() : CopyWithFree(JSONStringify(optionsRaw.As<Object>()).Utf16Value());
+
+            const auto result = configure_runtime(optionsCopy.get());
+            if (result == nullptr || result->error != nullptr)
+            {
+                for (const auto &variable : written)
+                {
+                    RestoreStartupVariable(variable);
+                }
+            }
+            return ThrowOrReturnJson(env, result);
+        }
+        catch (const Napi::Error &e)
+        {
+            logger.LogError(e);
+            throw;
+        }
+        catch (const std::exception &e)
+        {
+            logger.LogException(e);
+            throw;
+        }
+        catch (...)
+        {
+            logger.Log("Unknown exception");
+            throw;
+        }
+    }
+
+    Object Init(const Env env, Object exports)
+    {
+        exports.Set("warmup", Function::New(env, Warmup));
+        exports.Set("configureRuntime", Function::New(env, ConfigureRuntime));
+
+        return exports;
+    }
+}
+#endif
@@ -0,0 +1,151 @@
+#ifndef VE_SCRIPTCACHE_GUARD_HPP_
+#define VE_SCRIPTCACHE_GUARD_HPP_
+
+#include <napi.h>
+#include "ModInstaller.Native.h"
+#include "Logger.hpp"
+#include "Utils.Callbacks.hpp"
+#include "Utils.Return.hpp"
+
+using namespace Napi;
+using namespace Utils;
+using namespace ModInstaller::Native;
+
+namespace Bindings::ScriptCache
+{
+    Value PrecompileScript(const CallbackInfo &info)
+    {
+        const auto functionName = __FUNCTION__;
+        LoggerScope logger(functionName);
+
+        try
+        {
+            const auto env = info.Env();
+            const auto scriptPath = info[0].As<String>();
+            const auto validate = info.Length() > 1 && info[1].IsBoolean() && info[1].As<Boolean>().Value();
+
+            const auto scriptPathCopy = CopyWithFree(scriptPath.Utf16Value());
+            const auto validateCopy = validate ? (uint8_t)1 : (uint8_t)0;
+
+            auto cbData = CreateResultCallbackData(env, functionName);
+            const auto deferred = cbData->deferred;
+            const auto tsfn = cbData->tsfn;
+
+            const auto result = precompile_script(scriptPathCopy.get(), validateCopy, cbData, HandleBooleanResultCallback);
+            return ReturnAndHandleReject(env, result, deferred, tsfn);
+        }
+        catch (const Napi::Error &e)
+        {
+            logger.LogError(e);
+            throw;
+        }
+        catch (const std::exception &e)
+        {
+            logger.LogException(e);
+            throw;
+        }
+        catch (...)
+        {
+            logger.Log("Unknown exception");
+            throw;
+        }
+    }
+
+    void ClearScriptCache(const CallbackInfo &info)
+    {
+        LoggerScope logger(__FUNCTION__);
+
+        try
+        {
+            const auto env = info.Env();
+
+            const auto result = clear_script_cache();
+            ThrowOrReturn(env, result);
+        }
+        catch (const Napi::Error &e)
+        {
+            logger.LogError(e);
+            throw;
+        }
+        catch (const std::exception &e)
+        {
+            logger.LogException(e);
+            throw;
+        }
+        catch (...)
+        {
+            logger.Log("Unknown exception");
+            throw;
+        }
+    }
+
+    void SetScriptCacheDirectory(const CallbackInfo &info)
+    {
+        LoggerScope logger(__FUNCTION__);
+
+        try
+        {
+            const auto env = info.Env();
+            const auto directoryRaw = info[0];
+
+            const auto directoryCopy = directoryRaw.IsUndefined() || directoryRaw.IsNull() ? NullStringCopy() : CopyWithFree(directoryRaw.As<String>().Utf16Value());
+
+            const auto result = set_script_cache_directory(directoryCopy.get());
+            ThrowOrReturn(env, result);
+        }
+        catch (const Napi::Error &e)
+        {
+            logger.LogError(e);
+            throw;
+        }
+        catch (const std::exception &e)
+        {
+            logger.LogException(e);
+            throw;
+        }
+        catch (...)
+        {
+            logger.Log("Unknown exception");
+            throw;
+        }
+    }
+
+    Value ScriptCacheStats(const CallbackInfo &info)
+    {
+        LoggerScope logger(__FUNCTION__);
+
+        try
+        {
+            const auto env = info.Env();
+
+            const auto result = script_cache_stats();
+            return ThrowOrReturnJson(env, result);
+        }
+        catch (const Napi::Error &e)
+        {
+            logger.LogError(e);
+            throw;
+        }
+        catch (const std::exception &e)
+        {
+            logger.LogException(e);
+            throw;
+        }
+        catch (...)
+        {
+            logger.Log("Unknown exception");
+            throw;
+        }
+    }
+
+    Object Init(const Env env, Object exports)
+    {
+        exports.Set("precompileScript", Function::New(env, PrecompileScript));
+        exports.Set("clearScriptCache", Function::New(env, ClearScriptCache));
+        exports.Set("setScriptCacheDirectory", Function::New(env, SetScriptCacheDirectory));
+        exports.Set("scriptCacheStats", Function::New(env, ScriptCacheStats));
+
+        return exports;
+    }
+}
+#endif
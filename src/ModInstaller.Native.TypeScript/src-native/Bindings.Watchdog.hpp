@@ -0,0 +1,155 @@
+#ifndef VE_WATCHDOG_GUARD_HPP_
+#define VE_WATCHDOG_GUARD_HPP_
+
+#include <napi.h>
+#include "Logger.hpp"
+#include "Utils.Watchdog.hpp"
+
+using namespace Napi;
+using namespace Utils;
+
+namespace Bindings::Watchdog
+{
+    using Utils::Watchdog::Category;
+    using Utils::Watchdog::CategoryCount;
+    using Utils::Watchdog::CategoryName;
+    using Utils::Watchdog::Monitor;
+
+    static Object TimeoutsObject(const Napi::Env env, const std::array<uint32_t, CategoryCount> &timeoutsMs)
+    {
+        auto timeouts = Object::New(env);
+        for (size_t i = 0; i < CategoryCount; i++)
+        {
+            timeouts.Set(CategoryName(static_cast<Category>(i)), Number::New(env, timeoutsMs[i]));
+        }
+        return timeouts;
+    }
+
+    Value ConfigureWatchdog(const CallbackInfo &info)
+    {
+        LoggerScope logger(__FUNCTION__);
+
+        try
+        {
+            const auto env = info.Env();
+
+            if (info.Length() > 0 && info[0].IsObject())
+            {
+                const auto options = info[0].As<Object>();
+
+                // Validate everything first, so a bad value doesn't leave half of the deadlines changed
+                std::array<int64_t, CategoryCount> timeoutsMs;
+                for (size_t i = 0; i < CategoryCount; i++)
+                {
+                    const auto value = options.Get(CategoryName(static_cast<Category>(i)));
+                    timeoutsMs[i] = -1;
+                    if (value.IsUndefined())
+                    {
+                        continue;
+                    }
+
+                    const auto timeoutMs = value.IsNumber() ? value.As<Number>().Int64Value() : -1;
+                    if (timeoutMs < 0 || timeoutMs > UINT32_MAX)
+                    {
+                        NAPI_THROW(RangeError::New(env, std::string(CategoryName(static_cast<Category>(i))) + " must be a timeout in milliseconds, 0 to wait without a deadline"));
+                    }
+                    timeoutsMs[i] = timeoutMs;
+                }
+
+                for (size_t i = 0; i < CategoryCount; i++)
+                {
+                    if (timeoutsMs[i] >= 0)
+                    {
+                        Monitor::SetTimeout(static_cast<Category>(i), static_cast<uint32_t>(timeoutsMs[i]));
+                    }
+                }
+            }
+
+            return TimeoutsObject(env, Monitor::GetStats().timeoutsMs);
+        }
+        catch (const Napi::Error &e)
+        {
+            logger.LogError(e);
+            throw;
+        }
+        catch (const std::exception &e)
+        {
+            logger.LogException(e);
+            throw;
+        }
+        catch (...)
+        {
+            logger.Log("Unknown exception");
+            throw;
+        }
+    }
+
+    Value GetStallStats(const CallbackInfo &info)
+    {
+        LoggerScope logger(__FUNCTION__);
+
+        try
+        {
+            const auto env = info.Env();
+            const auto stats = Monitor::GetStats();
+
+            auto stalls = Object::New(env);
+            for (size_t i = 0; i < CategoryCount; i++)
+            {
+                stalls.Set(CategoryName(static_cast<Category>(i)), Number::New(env, static_cast<double>(stats.stalls[i])));
+            }
+
+            auto recent = Array::New(env, stats.recent.size());
+            for (size_t i = 0; i < stats.recent.size(); i++)
+            {
+                const auto &stall = stats.recent[i];
+                auto entry = Object::New(env);
+                entry.Set("callback", String::New(env, stall.callback));
+                entry.Set("category", String::New(env, CategoryName(stall.category)));
+                entry.Set("waitedMs", Number::New(env, static_cast<double>(stall.waitedMs)));
+                entry.Set("state", String::New(env, stall.running ? "running" : "queued"));
+                entry.Set("sinceLastCallbackMs", stall.sinceLastCallbackMs < 0 ? env.Null() : Number::New(env, static_cast<double>(stall.sinceLastCallbackMs)));
+                recent.Set(static_cast<uint32_t>(i), entry);
+            }
+
+            auto result = Object::New(env);
+            result.Set("timeouts", TimeoutsObject(env, stats.timeoutsMs));
+            result.Set("stalls", stalls);
+            result.Set("late", Number::New(env, static_cast<double>(stats.late)));
+            result.Set("recent", recent);
+            return result;
+        }
+        catch (const Napi::Error &e)
+        {
+            logger.LogError(e);
+            throw;
+        }
+        catch (const std::exception &e)
+        {
+            logger.LogException(e);
+            throw;
+        }
+        catch (...)
+        {
+            logger.Log("Unknown exception");
+            throw;
+        }
+    }
+
+    void ResetStallStats(const CallbackInfo &info)
+    {
+        LoggerScope logger(__FUNCTION__);
+
+        Monitor::ResetStats();
+    }
+
+    Object Init(const Env env, Object exports)
+    {
+        exports.Set("configureWatchdog", Function::New(env, ConfigureWatchdog));
+        exports.Set("getStallStats", Function::New(env, GetStallStats));
+        exports.Set("resetStallStats", Function::New(env, ResetStallStats));
+
+        return exports;
+    }
+}
+#endif
@@ -3,6 +3,7 @@
 
 #include <napi.h>
 #include <codecvt>
+#include <functional>
 #include "ModInstaller.Native.h"
 #include "Logger.hpp"
 #include "Utils.Generic.hpp"
@@ -17,6 +18,8 @@ namespace Utils
     {
         Napi::Promise::Deferred deferred;
         Napi::ThreadSafeFunction tsfn;
+        // Called when an install result arrives, before it is resolved, on the thread that delivered it
+        std::function<void()> ended;
     };
 
     using del_rcbd = std::unique_ptr<ResultCallbackData, deleter<ResultCallbackData>>;
@@ -316,6 +319,80 @@ namespace Utils
         }
     }
 
+    // Resolves with Convert(data) or null when there is no data, Convert throws a Napi::Error to reject.
+    // Convert may take over the data, it is freed otherwise.
+    template <Napi::Value (*Convert)(Napi::Env, del_bytes &, size_t)>
+    void HandleDataResultCallback(param_ptr *p_owner, return_value_data *returnData)
+    {
+        const auto functionName = __FUNCTION__;
+        LoggerScope logger(functionName);
+        try
+        {
+            auto manager = const_cast<ResultCallbackData *>(static_cast<const ResultCallbackData *>(p_owner));
+            del_rcbd del{manager};
+
+            const auto callback = [functionName, manager, returnData](Napi::Env env, Napi::Function jsCallback)
+            {
+                LoggerScope callbackLogger(NAMEOFWITHCALLBACK(functionName, callback));
+
+                del_data del{returnData};
+
+                if (returnData == nullptr)
+                {
+                    callbackLogger.Log("Null return data");
+                    const auto isError = Napi::Boolean::New(env, true);
+                    const auto error = Napi::Error::New(env, "Return value was null!").Value();
+                    jsCallback.Call({isError, error});
+                    return;
+                }
+
+                if (returnData->error != nullptr)
+                {
+                    callbackLogger.Log("Error");
+                    const auto isError = Napi::Boolean::New(env, true);
+                    const auto errorStr = std::unique_ptr<char16_t[], common_deallocor<char16_t>>(returnData->error);
+                    const auto error = Napi::Error::New(env, String::New(env, errorStr.get())).Value();
+                    jsCallback.Call({isError, error});
+                }
+                else if (returnData->value == nullptr)
+                {
+                    callbackLogger.Log("Result is null");
+                    jsCallback.Call({Napi::Boolean::New(env, false), env.Null()});
+                }
+                else
+                {
+                    callbackLogger.Log("Resolving");
+                    auto value = del_bytes(returnData->value);
+                    try
+                    {
+                        const auto result = Convert(env, value, static_cast<size_t>(returnData->length));
+                        jsCallback.Call({Napi::Boolean::New(env, false), result});
+                    }
+                    catch (const Napi::Error &e)
+                    {
+                        callbackLogger.LogError(e);
+                        jsCallback.Call({Napi::Boolean::New(env, true), e.Value()});
+                    }
+                }
+            };
+
+            manager->tsfn.BlockingCall(callback);
+            manager->tsfn.Release();
+        }
+        catch (const Napi::Error &e)
+        {
+            logger.LogError(e);
+        }
+        catch (const std::exception &e)
+        {
+            logger.LogException(e);
+        }
+        catch (...)
+        {
+            logger.Log("Unknown exception");
+        }
+    }
+
     std::u16string GetErrorMessage(const Napi::Error e)
     {
         const auto errorValue = e.Value();
@@ -0,0 +1,356 @@
+#ifndef VE_LIB_UTILS_COMPACTRESULT_GUARD_HPP_
+#define VE_LIB_UTILS_COMPACTRESULT_GUARD_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Reader for the install result layout written by InstallResultEncoder in ModInstaller.Native:
+//   u32 magic "FMIR", u32 version
+//   u32 string count, per string: i32 prefix (an earlier string, -1 for none), u32 UTF-8 suffix length, bytes
+//   i32 message
+//   u32 instruction count n
+//   u8[n] type, u8[n] flags, i32[n] source, i32[n] destination, i32[n] priority
+//   per instruction in order, if flagged: i32 type name, i32 section, i32 key, i32 value, u32 data length and bytes
+//   u32 decisions length, UTF-8 JSON
+// Integers are little-endian, strings are indices into the table with -1 for null. A string is its prefix
+// followed by its suffix, paths share their directories this way and are only joined when they are read.
+namespace Utils::CompactResult
+{
+    constexpr uint32_t Magic = 0x52494d46;
+    constexpr uint32_t Version = 2;
+
+    constexpr uint8_t OtherType = 0xFF;
+    constexpr uint8_t FlagTypeName = 1;
+    constexpr uint8_t FlagIni = 2;
+    constexpr uint8_t FlagData = 4;
+
+    constexpr const char *TypeNames[] = {"copy", "mkdir", "generatefile", "iniedit", "enableplugin", "enableallplugins", "unsupported", "error"};
+    constexpr uint8_t TypeCount = sizeof(TypeNames) / sizeof(TypeNames[0]);
+
+    struct Instruction
+    {
+        // Index into TypeNames, OtherType when the name is in typeName
+        uint8_t type;
+        int32_t typeName;
+        int32_t source;
+        int32_t destination;
+        int32_t priority;
+        bool hasIni;
+        int32_t section;
+        int32_t key;
+        int32_t value;
+        bool hasData;
+        const uint8_t *data;
+        uint32_t dataLength;
+    };
+
+    class Cursor
+    {
+    private:
+        const uint8_t *_pos;
+        const uint8_t *_end;
+
+    public:
+        Cursor(const uint8_t *data, const size_t length) : _pos(data), _end(data + length) {}
+
+        size_t Remaining() const
+        {
+            return static_cast<size_t>(_end - _pos);
+        }
+
+        const uint8_t *Position() const
+        {
+            return _pos;
+        }
+
+        bool Skip(const size_t length)
+        {
+            if (Remaining() < length)
+            {
+                return false;
+            }
+            _pos += length;
+            return true;
+        }
+
+        bool ReadUInt32(uint32_t &value)
+        {
+            if (Remaining() < 4)
+            {
+                return false;
+            }
+            value = static_cast<uint32_t>(_pos[0]) | static_cast<uint32_t>(_pos[1]) << 8 | static_cast<uint32_t>(_pos[2]) << 16 | static_cast<uint32_t>(_pos[3]) << 24;
+            _pos += 4;
+            return true;
+        }
+
+        bool ReadInt32(int32_t &value)
+        {
+            uint32_t raw;
+            if (!ReadUInt32(raw))
+            {
+                return false;
+            }
+            std::memcpy(&value, &raw, sizeof(value));
+            return true;
+        }
+
+        // Reads the i-th little-endian int32 of a column, the bounds are checked by the caller
+        static int32_t Column(const uint8_t *column, const uint32_t i)
+        {
+            Cursor cursor(column + static_cast<size_t>(i) * 4, 4);
+            int32_t value = 0;
+            cursor.ReadInt32(value);
+            return value;
+        }
+    };
+
+    // Validated offsets into an encoded result, for random access to its strings and instructions.
+    // The data has to outlive the index.
+    class Index
+    {
+    private:
+        struct Span
+        {
+            const char *data;
+            uint32_t length;
+        };
+
+        struct Entry
+        {
+            int32_t prefix;
+            Span suffix;
+            // Prefixes included
+            uint32_t length;
+        };
+
+        std::vector<Entry> _strings;
+        // Offset of each instruction's extras, only read for flagged instructions
+        std::vector<uint32_t> _extras;
+        const uint8_t *_data = nullptr;
+        size_t _length = 0;
+        const uint8_t *_types = nullptr;
+        const uint8_t *_flags = nullptr;
+        const uint8_t *_sources = nullptr;
+        const uint8_t *_destinations = nullptr;
+        const uint8_t *_priorities = nullptr;
+        uint32_t _count = 0;
+        int32_t _message = -1;
+        Span _decisions{nullptr, 0};
+
+        bool IsString(const int32_t index) const
+        {
+            return index == -1 || (index >= 0 && static_cast<size_t>(index) < _strings.size());
+        }
+
+    public:
+        // Returns the reason the data is malformed, nullptr on success
+        const char *Parse(const uint8_t *data, const size_t length)
+        {
+            _data = data;
+            _length = length;
+            Cursor cursor(data, length);
+            uint32_t magic, version, stringCount;
+            if (!cursor.ReadUInt32(magic) || magic != Magic)
+            {
+                return "Not a compact install result";
+            }
+            if (!cursor.ReadUInt32(version) || version != Version)
+            {
+                return "Unsupported compact install result version";
+            }
+            if (!cursor.ReadUInt32(stringCount) || stringCount > cursor.Remaining() / 8)
+            {
+                return "Truncated string table";
+            }
+
+            _strings.reserve(stringCount);
+            for (uint32_t i = 0; i < stringCount; i++)
+            {
+                int32_t prefix;
+                uint32_t stringLength;
+                const auto valid = cursor.ReadInt32(prefix) && cursor.ReadUInt32(stringLength);
+                const auto start = cursor.Position();
+                if (!valid || !cursor.Skip(stringLength))
+                {
+                    return "Truncated string table";
+                }
+                // Only earlier strings, so prefixes can't form a cycle
+                if (prefix < -1 || (prefix >= 0 && static_cast<uint32_t>(prefix) >= i))
+                {
+                    return "String prefix out of range";
+                }
+                const auto prefixLength = prefix == -1 ? 0 : _strings[prefix].length;
+                if (stringLength > UINT32_MAX - prefixLength)
+                {
+                    return "String too long";
+                }
+                _strings.push_back({prefix, {reinterpret_cast<const char *>(start), stringLength}, prefixLength + stringLength});
+            }
+
+            if (!cursor.ReadInt32(_message) || !IsString(_message) || !cursor.ReadUInt32(_count))
+            {
+                return "Truncated header";
+            }
+            // Two byte columns and three int32 columns
+            if (_count > cursor.Remaining() / 14)
+            {
+                return "Truncated instruction columns";
+            }
+
+            _types = cursor.Position();
+            _flags = _types + _count;
+            _sources = _flags + _count;
+            _destinations = _sources + static_cast<size_t>(_count) * 4;
+            _priorities = _destinations + static_cast<size_t>(_count) * 4;
+            cursor.Skip(static_cast<size_t>(_count) * 14);
+
+            _extras.resize(_count);
+            for (uint32_t i = 0; i < _count; i++)
+            {
+                const auto type = _types[i];
+                if (type >= TypeCount && type != OtherType)
+                {
+                    return "Unknown instruction type";
+                }
+                if (!IsString(Cursor::Column(_sources, i)) || !IsString(Cursor::Column(_destinations, i)))
+                {
+                    return "String index out of range";
+                }
+
+                _extras[i] = static_cast<uint32_t>(cursor.Position() - data);
+                const auto flag = _flags[i];
+                int32_t index;
+                if ((flag & FlagTypeName) != 0 && (!cursor.ReadInt32(index) || !IsString(index)))
+                {
+                    return "Truncated instruction extras";
+                }
+                if ((flag & FlagIni) != 0)
+                {
+                    for (int field = 0; field < 3; field++)
+                    {
+                        if (!cursor.ReadInt32(index) || !IsString(index))
+                        {
+                            return "Truncated instruction extras";
+                        }
+                    }
+                }
+                uint32_t dataLength;
+                if ((flag & FlagData) != 0 && (!cursor.ReadUInt32(dataLength) || !cursor.Skip(dataLength)))
+                {
+                    return "Truncated instruction data";
+                }
+            }
+
+            uint32_t decisionsLength;
+            const auto valid = cursor.ReadUInt32(decisionsLength);
+            const auto decisions = cursor.Position();
+            if (!valid || !cursor.Skip(decisionsLength))
+            {
+                return "Truncated decisions";
+            }
+            _decisions = {reinterpret_cast<const char *>(decisions), decisionsLength};
+            return nullptr;
+        }
+
+        size_t StringCount() const
+        {
+            return _strings.size();
+        }
+
+        // Joins the string with its prefixes into value
+        void String(const uint32_t index, std::string &value) const
+        {
+            value.resize(_strings[index].length);
+            auto end = value.size();
+            for (auto i = static_cast<int32_t>(index); i != -1; i = _strings[i].prefix)
+            {
+                const auto &suffix = _strings[i].suffix;
+                end -= suffix.length;
+                std::memcpy(&value[end], suffix.data, suffix.length);
+            }
+        }
+
+        int32_t Message() const
+        {
+            return _message;
+        }
+
+        uint32_t Count() const
+        {
+            return _count;
+        }
+
+        uint8_t Type(const uint32_t i) const
+        {
+            return _types[i];
+        }
+
+        const char *Decisions(uint32_t &length) const
+        {
+            length = _decisions.length;
+            return _decisions.data;
+        }
+
+        // Only valid after a successful Parse, i has to be below Count()
+        Instruction At(const uint32_t i) const
+        {
+            Instruction instruction{_types[i], -1, Cursor::Column(_sources, i), Cursor::Column(_destinations, i), Cursor::Column(_priorities, i), false, -1, -1, -1, false, nullptr, 0};
+
+            const auto flag = _flags[i];
+            if (flag == 0)
+            {
+                return instruction;
+            }
+
+            // Parse checked the bounds
+            Cursor cursor(_data + _extras[i], _length - _extras[i]);
+            if ((flag & FlagTypeName) != 0)
+            {
+                cursor.ReadInt32(instruction.typeName);
+            }
+            if ((flag & FlagIni) != 0)
+            {
+                instruction.hasIni = true;
+                cursor.ReadInt32(instruction.section);
+                cursor.ReadInt32(instruction.key);
+                cursor.ReadInt32(instruction.value);
+            }
+            if ((flag & FlagData) != 0)
+            {
+                instruction.hasData = true;
+                cursor.ReadUInt32(instruction.dataLength);
+                instruction.data = cursor.Position();
+            }
+            return instruction;
+        }
+    };
+
+    // Calls visitor.Begin(index) once the data is validated, then visitor.Instruction(i, instruction) for each
+    // instruction and visitor.Decisions(data, length). Strings are read from the index as they are needed.
+    // Returns the reason the data is malformed, nullptr on success.
+    template <typename TVisitor>
+    const char *Decode(const uint8_t *data, const size_t length, TVisitor &visitor)
+    {
+        Index index;
+        const auto error = index.Parse(data, length);
+        if (error != nullptr)
+        {
+            return error;
+        }
+
+        visitor.Begin(index);
+        for (uint32_t i = 0; i < index.Count(); i++)
+        {
+            visitor.Instruction(i, index.At(i));
+        }
+        uint32_t decisionsLength;
+        const auto decisions = index.Decisions(decisionsLength);
+        visitor.Decisions(decisions, decisionsLength);
+        return nullptr;
+    }
+}
+#endif
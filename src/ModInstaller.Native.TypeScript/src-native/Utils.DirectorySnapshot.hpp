@@ -0,0 +1,477 @@
+#ifndef VE_LIB_UTILS_DIRECTORY_SNAPSHOT_GUARD_HPP_
+#define VE_LIB_UTILS_DIRECTORY_SNAPSHOT_GUARD_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <cwctype>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Utils.Glob.hpp"
+
+// In-memory index of a directory tree served by the JS FileSystem callbacks.
+// The first recursive readDirectoryFileList query below a directory lists that directory recursively once;
+// later file listings, exists checks and pattern queries below it are answered from the index.
+// The listing has no entries for empty directories, so readDirectoryList always goes to JS.
+// A snapshot is dropped as soon as one of the installs running when it was taken ends, so a root
+// doesn't keep serving an old listing while other installs keep overlapping.
+namespace Utils
+{
+    struct SnapshotAnswer
+    {
+        bool answered;
+        // JSON array of paths, or empty for a null result
+        std::u16string json;
+    };
+
+    class DirectorySnapshot
+    {
+    private:
+        struct File
+        {
+            std::u16string path;
+            std::u16string name;
+        };
+
+        struct Directory
+        {
+            std::u16string path;
+            std::vector<uint32_t> files;
+            std::vector<uint32_t> directories;
+        };
+
+        std::u16string _root;
+        bool _exists;
+        std::vector<File> _files;
+        std::vector<Directory> _directories;
+        std::unordered_map<std::u16string, uint32_t> _index;
+
+        uint32_t AddDirectory(const std::u16string &key, const std::u16string &path)
+        {
+            const auto index = static_cast<uint32_t>(_directories.size());
+            _directories.push_back(Directory{path, {}, {}});
+            _index.emplace(key, index);
+            return index;
+        }
+
+        // Returns the directory for the key, creating it and its parents up to the root
+        uint32_t EnsureDirectory(const std::u16string &key, const std::u16string &path)
+        {
+            const auto it = _index.find(key);
+            if (it != _index.end())
+            {
+                return it->second;
+            }
+
+            const auto separator = key.rfind(u'\\');
+            const auto parentKey = separator == std::u16string::npos || separator < _root.size() ? _root : key.substr(0, separator);
+            const auto parent = EnsureDirectory(parentKey, path.substr(0, parentKey.size()));
+            const auto index = AddDirectory(key, path);
+            _directories[parent].directories.push_back(index);
+            return index;
+        }
+
+        void CollectFiles(const Directory &directory, const Glob &glob, const bool recursive, std::u16string &json, bool &first) const
+        {
+            for (const auto file : directory.files)
+            {
+                if (glob.Match(_files[file].name))
+                {
+                    AppendJsonString(json, _files[file].path, first);
+                }
+            }
+            if (recursive)
+            {
+                for (const auto child : directory.directories)
+                {
+                    CollectFiles(_directories[child], glob, recursive, json, first);
+                }
+            }
+        }
+
+    public:
+        DirectorySnapshot(const std::u16string &rootPath, const bool exists, const std::vector<std::u16string> &files)
+            : _root(Normalize(rootPath)), _exists(exists)
+        {
+            AddDirectory(_root, rootPath);
+
+            const auto prefixLength = _root.empty() ? 0 : _root.size() + 1;
+            for (const auto &path : files)
+            {
+                const auto key = Normalize(path);
+                if (key.size() <= prefixLength || (prefixLength > 0 && (key.compare(0, _root.size(), _root) != 0 || key[_root.size()] != u'\\')))
+                {
+                    continue;
+                }
+
+                // Archive listings carry directory entries with a trailing separator
+                if (path.back() == u'\\' || path.back() == u'/')
+                {
+                    EnsureDirectory(key, path.substr(0, key.size()));
+                    continue;
+                }
+
+                const auto separator = key.rfind(u'\\');
+                const auto hasParent = separator != std::u16string::npos && separator >= prefixLength;
+                const auto parent = hasParent ? EnsureDirectory(key.substr(0, separator), path.substr(0, separator)) : 0;
+                const auto index = static_cast<uint32_t>(_files.size());
+                _files.push_back(File{path, key.substr(hasParent ? separator + 1 : prefixLength)});
+                _directories[parent].files.push_back(index);
+            }
+        }
+
+        const std::u16string &Root() const
+        {
+            return _root;
+        }
+
+        size_t FileCount() const
+        {
+            return _files.size();
+        }
+
+        size_t DirectoryCount() const
+        {
+            return _directories.size();
+        }
+
+        // Case-insensitive key with a single separator style and no trailing separator
+        static std::u16string Normalize(const std::u16string &path)
+        {
+            std::u16string key(path);
+            for (auto &c : key)
+            {
+                if (c == u'/')
+                    c = u'\\';
+                else if (c < 0x80)
+                    c = static_cast<char16_t>(c >= u'A' && c <= u'Z' ? c + 32 : c);
+                else
+                    c = static_cast<char16_t>(std::towlower(static_cast<wint_t>(c)));
+            }
+            while (!key.empty() && key.back() == u'\\')
+            {
+                key.pop_back();
+            }
+            return key;
+        }
+
+        static void AppendJsonString(std::u16string &json, const std::u16string &value, bool &first)
+        {
+            static const char16_t hex[] = u"0123456789abcdef";
+            json += first ? u"\"" : u",\"";
+            first = false;
+            for (const auto c : value)
+            {
+                if (c == u'"' || c == u'\\')
+                {
+                    json += u'\\';
+                    json += c;
+                }
+                else if (c < 0x20)
+                {
+                    json += u"\\u00";
+                    json += hex[c >> 4];
+                    json += hex[c & 0xF];
+                }
+                else
+                {
+                    json += c;
+                }
+            }
+            json += u'"';
+        }
+
+        // Parses a JSON array of strings; returns false for null or anything else
+        static bool ParseJsonStringArray(const char16_t *json, std::vector<std::u16string> &values)
+        {
+            if (json == nullptr)
+            {
+                return false;
+            }
+
+            const auto skip = [&json]()
+            {
+                while (*json == u' ' || *json == u'\t' || *json == u'\n' || *json == u'\r')
+                    json++;
+            };
+            const auto hexValue = [](const char16_t c) -> int
+            {
+                if (c >= u'0' && c <= u'9')
+                    return c - u'0';
+                if (c >= u'a' && c <= u'f')
+                    return c - u'a' + 10;
+                if (c >= u'A' && c <= u'F')
+                    return c - u'A' + 10;
+                return -1;
+            };
+
+            skip();
+            if (*json++ != u'[')
+                return false;
+            skip();
+            if (*json == u']')
+                return true;
+
+            while (true)
+            {
+                skip();
+                if (*json++ != u'"')
+                    return false;
+
+                std::u16string value;
+                while (*json != u'"')
+                {
+                    if (*json == 0)
+                        return false;
+                    if (*json != u'\\')
+                    {
+                        value += *json++;
+                        continue;
+                    }
+                    json++;
+                    switch (*json++)
+                    {
+                    case u'"': value += u'"'; break;
+                    case u'\\': value += u'\\'; break;
+                    case u'/': value += u'/'; break;
+                    case u'b': value += u'\b'; break;
+                    case u'f': value += u'\f'; break;
+                    case u'n': value += u'\n'; break;
+                    case u'r': value += u'\r'; break;
+                    case u't': value += u'\t'; break;
+                    case u'u':
+                    {
+                        int code = 0;
+                        for (int i = 0; i < 4; i++)
+                        {
+                            const auto digit = hexValue(*json++);
+                            if (digit < 0)
+                                return false;
+                            code = code * 16 + digit;
+                        }
+                        value += static_cast<char16_t>(code);
+                        break;
+                    }
+                    default:
+                        return false;
+                    }
+                }
+                json++;
+                values.push_back(std::move(value));
+
+                skip();
+                if (*json == u',')
+                {
+                    json++;
+                    continue;
+                }
+                return *json == u']';
+            }
+        }
+
+        // Files below the directory whose name matches the pattern; search type 1 is AllDirectories
+        SnapshotAnswer ReadDirectoryFileList(const std::u16string &directoryPath, const char16_t *pattern, const int32_t searchType) const
+        {
+            if (!_exists)
+            {
+                return SnapshotAnswer{true, u""};
+            }
+            const auto it = _index.find(Normalize(directoryPath));
+            if (it == _index.end())
+            {
+                // Empty and missing directories are not part of the file listing
+                return SnapshotAnswer{false, u""};
+            }
+
+            std::u16string json = u"[";
+            auto first = true;
+            CollectFiles(_directories[it->second], Glob(pattern == nullptr ? u"*" : pattern), searchType == 1, json, first);
+            json += u']';
+            return SnapshotAnswer{true, json};
+        }
+
+        // Only directories are answered, the listing carries no file sizes
+        SnapshotAnswer Stat(const std::u16string &path) const
+        {
+            if (!_exists)
+            {
+                return SnapshotAnswer{true, u""};
+            }
+            if (_index.find(Normalize(path)) == _index.end())
+            {
+                return SnapshotAnswer{false, u""};
+            }
+            return SnapshotAnswer{true, u"{\"kind\":\"directory\",\"size\":0}"};
+        }
+    };
+
+    // The snapshots of one FileSystem, keyed by root
+    class DirectorySnapshots
+    {
+    public:
+        // Lists a root recursively through the JS callbacks; returns false when the listing failed
+        using Loader = std::function<bool(const std::u16string &root, bool &exists, std::vector<std::u16string> &files)>;
+
+    private:
+        struct Entry
+        {
+            std::shared_ptr<const DirectorySnapshot> snapshot;
+            // The installs running when the snapshot was taken
+            std::vector<uint64_t> installs;
+        };
+
+        static inline std::mutex _installsMutex;
+        static inline std::set<uint64_t> _runningInstalls;
+        static inline uint64_t _nextInstall = 0;
+        static inline std::atomic<int32_t> _activeInstalls{0};
+        static inline std::atomic<uint64_t> _generation{0};
+        static inline std::atomic<bool> _enabled{true};
+        static inline thread_local bool _loading = false;
+
+        std::mutex _mutex;
+        uint64_t _snapshotGeneration = 0;
+        std::map<std::u16string, Entry> _snapshots;
+
+        static std::vector<uint64_t> RunningInstalls()
+        {
+            std::lock_guard<std::mutex> lock(_installsMutex);
+            return std::vector<uint64_t>(_runningInstalls.begin(), _runningInstalls.end());
+        }
+
+        static bool StillRunning(const std::vector<uint64_t> &installs)
+        {
+            std::lock_guard<std::mutex> lock(_installsMutex);
+            for (const auto install : installs)
+            {
+                if (_runningInstalls.find(install) == _runningInstalls.end())
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        std::shared_ptr<const DirectorySnapshot> Find(const std::u16string &directoryPath)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            const auto generation = _generation.load();
+            if (_snapshotGeneration != generation)
+            {
+                _snapshots.clear();
+                _snapshotGeneration = generation;
+            }
+
+            auto key = DirectorySnapshot::Normalize(directoryPath);
+            while (true)
+            {
+                const auto it = _snapshots.find(key);
+                if (it != _snapshots.end())
+                {
+                    if (StillRunning(it->second.installs))
+                    {
+                        return it->second.snapshot;
+                    }
+                    // An outer root may still be current
+                    _snapshots.erase(it);
+                }
+                if (key.empty())
+                {
+                    return nullptr;
+                }
+                const auto separator = key.rfind(u'\\');
+                key = separator == std::u16string::npos ? std::u16string() : key.substr(0, separator);
+            }
+        }
+
+        std::shared_ptr<const DirectorySnapshot> FindOrLoad(const std::u16string &directoryPath, const bool recursive, const Loader &loader)
+        {
+            if (!_enabled || _loading || _activeInstalls.load() == 0)
+            {
+                return nullptr;
+            }
+
+            auto snapshot = Find(directoryPath);
+            if (snapshot != nullptr || !recursive)
+            {
+                // A single directory is cheaper to list in JS than the whole tree below it
+                return snapshot;
+            }
+
+            // The listing goes through the JS bridge and may block on the main thread, never hold the lock
+            const auto generation = _generation.load();
+            auto installs = RunningInstalls();
+            auto exists = true;
+            std::vector<std::u16string> files;
+            _loading = true;
+            const auto loaded = loader(directoryPath, exists, files);
+            _loading = false;
+            if (!loaded)
+            {
+                return nullptr;
+            }
+
+            snapshot = std::make_shared<const DirectorySnapshot>(directoryPath, exists, files);
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_snapshotGeneration == generation)
+            {
+                _snapshots[snapshot->Root()] = Entry{snapshot, std::move(installs)};
+            }
+            return snapshot;
+        }
+
+    public:
+        // Returns the id EndInstall takes
+        static uint64_t BeginInstall()
+        {
+            std::lock_guard<std::mutex> lock(_installsMutex);
+            const auto install = ++_nextInstall;
+            _runningInstalls.insert(install);
+            _activeInstalls++;
+            return install;
+        }
+
+        // Snapshots taken while the install was running are dropped on their next lookup
+        static void EndInstall(const uint64_t install) noexcept
+        {
+            std::lock_guard<std::mutex> lock(_installsMutex);
+            if (_runningInstalls.erase(install) != 0 && --_activeInstalls == 0)
+            {
+                // Nothing can use the snapshots anymore, let them go without waiting for a lookup
+                _generation++;
+            }
+        }
+
+        static void SetEnabled(const bool enabled) noexcept
+        {
+            _enabled = enabled;
+            _generation++;
+        }
+
+        SnapshotAnswer ReadDirectoryFileList(const char16_t *directoryPath, const char16_t *pattern, const int32_t searchType, const Loader &loader)
+        {
+            if (directoryPath == nullptr)
+            {
+                return SnapshotAnswer{false, u""};
+            }
+            const auto snapshot = FindOrLoad(directoryPath, searchType == 1, loader);
+            return snapshot == nullptr ? SnapshotAnswer{false, u""} : snapshot->ReadDirectoryFileList(directoryPath, pattern, searchType);
+        }
+
+        // Never loads a snapshot, a single stat is cheaper than listing the root
+        SnapshotAnswer Stat(const char16_t *path)
+        {
+            if (path == nullptr || !_enabled || _activeInstalls.load() == 0)
+            {
+                return SnapshotAnswer{false, u""};
+            }
+            const auto snapshot = Find(path);
+            return snapshot == nullptr ? SnapshotAnswer{false, u""} : snapshot->Stat(path);
+        }
+    };
+}
+#endif
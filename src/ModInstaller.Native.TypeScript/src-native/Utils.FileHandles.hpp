@@ -0,0 +1,122 @@
+#ifndef VE_LIB_UTILS_FILE_HANDLES_GUARD_HPP_
+#define VE_LIB_UTILS_FILE_HANDLES_GUARD_HPP_
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// Open file handles of the open/read/close protocol.
+// The JS host only serves offset/length reads by path, a handle remembers the path and size
+// resolved on open so chunked reads from ModInstaller.Native never resolve them again.
+namespace Utils
+{
+    struct FileHandle
+    {
+        std::u16string path;
+        // -1 when the host has no stat callback and the size is unknown
+        int64_t size;
+    };
+
+    class FileHandles
+    {
+    private:
+        std::mutex _mutex;
+        int32_t _next = 1;
+        std::unordered_map<int32_t, FileHandle> _handles;
+
+    public:
+        // Handles are unique process-wide so a stale handle can never hit another FileSystem
+        static FileHandles &Instance()
+        {
+            static FileHandles handles;
+            return handles;
+        }
+
+        int32_t Open(const std::u16string &path, const int64_t size)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            auto handle = _next++;
+            if (_next <= 0)
+            {
+                _next = 1;
+            }
+            _handles[handle] = FileHandle{path, size};
+            return handle;
+        }
+
+        bool Find(const int32_t handle, FileHandle &file)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            const auto it = _handles.find(handle);
+            if (it == _handles.end())
+            {
+                return false;
+            }
+            file = it->second;
+            return true;
+        }
+
+        bool Close(const int32_t handle)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _handles.erase(handle) > 0;
+        }
+
+        size_t Count()
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _handles.size();
+        }
+
+        // Reads kind and size from a stat result; false for directories and unparsable values
+        static bool ParseFileStat(const char16_t *json, int64_t &size)
+        {
+            if (json == nullptr)
+            {
+                return false;
+            }
+
+            const std::u16string value{json};
+            if (value.find(u"\"directory\"") != std::u16string::npos)
+            {
+                return false;
+            }
+
+            const auto key = value.find(u"\"size\"");
+            if (key == std::u16string::npos)
+            {
+                size = -1;
+                return true;
+            }
+
+            auto i = value.find(u':', key);
+            if (i == std::u16string::npos)
+            {
+                return false;
+            }
+            i++;
+            while (i < value.size() && (value[i] == u' ' || value[i] == u'\t'))
+            {
+                i++;
+            }
+
+            const auto negative = i < value.size() && value[i] == u'-';
+            if (negative)
+            {
+                i++;
+            }
+            int64_t parsed = 0;
+            auto digits = false;
+            while (i < value.size() && value[i] >= u'0' && value[i] <= u'9')
+            {
+                parsed = parsed * 10 + (value[i] - u'0');
+                digits = true;
+                i++;
+            }
+            size = !digits || negative ? -1 : parsed;
+            return true;
+        }
+    };
+}
+#endif
@@ -36,7 +36,9 @@ namespace Utils
     using del_int32 = std::unique_ptr<return_value_int32, common_deallocor<return_value_int32>>;
     using del_uint32 = std::unique_ptr<return_value_uint32, common_deallocor<return_value_uint32>>;
     using del_ptr = std::unique_ptr<return_value_ptr, common_deallocor<return_value_ptr>>;
+    using del_data = std::unique_ptr<return_value_data, common_deallocor<return_value_data>>;
     using del_async = std::unique_ptr<return_value_async, common_deallocor<return_value_async>>;
+    using del_bytes = std::unique_ptr<uint8_t[], common_deallocor<uint8_t>>;
 
     uint8_t *const Copy(const uint8_t *src, const size_t length)
     {
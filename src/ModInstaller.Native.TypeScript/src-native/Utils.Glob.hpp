@@ -0,0 +1,328 @@
+#ifndef VE_LIB_UTILS_GLOB_GUARD_HPP_
+#define VE_LIB_UTILS_GLOB_GUARD_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <cwctype>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define VE_GLOB_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(VE_GLOB_X86) && (defined(__GNUC__) || defined(__clang__))
+#define VE_GLOB_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define VE_GLOB_TARGET_AVX2
+#endif
+
+// Case-insensitive '*'/'?' wildcard matching of file names, as used by directory pattern queries.
+// A pattern is compiled once into the literal runs between its stars; matching anchors the first and
+// last run and finds the middle ones left to right, searching for each run's first literal character
+// with SSE2/AVX2 when the CPU has them and a scalar loop otherwise.
+namespace Utils
+{
+    enum class GlobSimd
+    {
+        Scalar,
+        Sse2,
+        Avx2
+    };
+
+    namespace GlobDetail
+    {
+        // Same folding as DirectorySnapshot::Normalize
+        inline char16_t Fold(const char16_t c)
+        {
+            if (c < 0x80)
+            {
+                return static_cast<char16_t>(c >= u'A' && c <= u'Z' ? c + 32 : c);
+            }
+            return static_cast<char16_t>(std::towlower(static_cast<wint_t>(c)));
+        }
+
+        inline char16_t Upper(const char16_t c)
+        {
+            if (c < 0x80)
+            {
+                return static_cast<char16_t>(c >= u'a' && c <= u'z' ? c - 32 : c);
+            }
+            return static_cast<char16_t>(std::towupper(static_cast<wint_t>(c)));
+        }
+
+        inline size_t FindCharScalar(const char16_t *s, const size_t n, const char16_t a, const char16_t b)
+        {
+            for (size_t i = 0; i < n; i++)
+            {
+                if (s[i] == a || s[i] == b)
+                {
+                    return i;
+                }
+            }
+            return n;
+        }
+
+#if defined(VE_GLOB_X86)
+        inline uint32_t CountTrailingZeros(const uint32_t mask)
+        {
+#if defined(_MSC_VER)
+            unsigned long index;
+            _BitScanForward(&index, mask);
+            return static_cast<uint32_t>(index);
+#else
+            return static_cast<uint32_t>(__builtin_ctz(mask));
+#endif
+        }
+
+        inline size_t FindCharSse2(const char16_t *s, const size_t n, const char16_t a, const char16_t b)
+        {
+            const auto va = _mm_set1_epi16(static_cast<short>(a));
+            const auto vb = _mm_set1_epi16(static_cast<short>(b));
+            size_t i = 0;
+            for (; i + 8 <= n; i += 8)
+            {
+                const auto v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i));
+                const auto mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi16(v, va), _mm_cmpeq_epi16(v, vb))));
+                if (mask != 0)
+                {
+                    return i + CountTrailingZeros(mask) / 2;
+                }
+            }
+            return i + FindCharScalar(s + i, n - i, a, b);
+        }
+
+        VE_GLOB_TARGET_AVX2 inline size_t FindCharAvx2(const char16_t *s, const size_t n, const char16_t a, const char16_t b)
+        {
+            const auto va = _mm256_set1_epi16(static_cast<short>(a));
+            const auto vb = _mm256_set1_epi16(static_cast<short>(b));
+            size_t i = 0;
+            for (; i + 16 <= n; i += 16)
+            {
+                const auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i));
+                const auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi16(v, va), _mm256_cmpeq_epi16(v, vb))));
+                if (mask != 0)
+                {
+                    return i + CountTrailingZeros(mask) / 2;
+                }
+            }
+            return i + FindCharSse2(s + i, n - i, a, b);
+        }
+
+        inline bool HasAvx2()
+        {
+#if defined(_MSC_VER)
+            int info[4];
+            __cpuid(info, 0);
+            if (info[0] < 7)
+            {
+                return false;
+            }
+            __cpuid(info, 1);
+            // OSXSAVE and AVX, then the OS has to save the YMM registers
+            if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0 || (_xgetbv(0) & 6) != 6)
+            {
+                return false;
+            }
+            __cpuidex(info, 7, 0);
+            return (info[1] & (1 << 5)) != 0;
+#else
+            return __builtin_cpu_supports("avx2");
+#endif
+        }
+#endif
+    }
+
+    class Glob
+    {
+    private:
+        struct Run
+        {
+            // Folded text, '?' matches any character
+            std::u16string text;
+            // First literal character, npos when the run is only '?'
+            size_t anchor;
+            char16_t lower;
+            char16_t upper;
+        };
+
+        std::vector<Run> _runs;
+        bool _leadingStar = false;
+        bool _trailingStar = false;
+        bool _matchAll = false;
+
+        static bool Verify(const Run &run, const char16_t *name)
+        {
+            for (size_t i = 0; i < run.text.size(); i++)
+            {
+                const auto c = run.text[i];
+                if (c != u'?' && GlobDetail::Fold(name[i]) != c)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // Leftmost start in [from, to) where the run matches, npos if none
+        static size_t Find(const Run &run, const char16_t *name, const size_t from, const size_t to, const GlobSimd simd)
+        {
+            if (to < from || to - from < run.text.size())
+            {
+                return std::u16string::npos;
+            }
+            if (run.anchor == std::u16string::npos)
+            {
+                return from;
+            }
+
+            const auto last = to - run.text.size();
+            auto start = from;
+            while (start <= last)
+            {
+                const auto s = name + start + run.anchor;
+                const auto n = last - start + 1;
+                size_t offset;
+                switch (simd)
+                {
+#if defined(VE_GLOB_X86)
+                case GlobSimd::Avx2:
+                    offset = GlobDetail::FindCharAvx2(s, n, run.lower, run.upper);
+                    break;
+                case GlobSimd::Sse2:
+                    offset = GlobDetail::FindCharSse2(s, n, run.lower, run.upper);
+                    break;
+#endif
+                default:
+                    offset = GlobDetail::FindCharScalar(s, n, run.lower, run.upper);
+                    break;
+                }
+                if (offset >= n)
+                {
+                    return std::u16string::npos;
+                }
+
+                start += offset;
+                if (Verify(run, name + start))
+                {
+                    return start;
+                }
+                start++;
+            }
+            return std::u16string::npos;
+        }
+
+    public:
+        explicit Glob(const std::u16string &pattern)
+        {
+            _matchAll = pattern.empty() || pattern == u"*" || pattern == u"*.*";
+            _leadingStar = !pattern.empty() && pattern.front() == u'*';
+            _trailingStar = !pattern.empty() && pattern.back() == u'*';
+
+            size_t begin = 0;
+            while (begin <= pattern.size())
+            {
+                auto end = pattern.find(u'*', begin);
+                if (end == std::u16string::npos)
+                {
+                    end = pattern.size();
+                }
+                if (end > begin)
+                {
+                    Run run{std::u16string(), std::u16string::npos, 0, 0};
+                    for (auto i = begin; i < end; i++)
+                    {
+                        const auto c = pattern[i] == u'?' ? u'?' : GlobDetail::Fold(pattern[i]);
+                        if (c != u'?' && run.anchor == std::u16string::npos)
+                        {
+                            run.anchor = run.text.size();
+                            run.lower = c;
+                            run.upper = GlobDetail::Upper(c);
+                        }
+                        run.text += c;
+                    }
+                    _runs.push_back(std::move(run));
+                }
+                begin = end + 1;
+            }
+        }
+
+        static GlobSimd DetectedSimd()
+        {
+#if defined(VE_GLOB_X86)
+            static const auto simd = GlobDetail::HasAvx2() ? GlobSimd::Avx2 : GlobSimd::Sse2;
+            return simd;
+#else
+            return GlobSimd::Scalar;
+#endif
+        }
+
+        bool MatchAll() const
+        {
+            return _matchAll;
+        }
+
+        bool Match(const std::u16string &name) const
+        {
+            return Match(name.data(), name.size(), DetectedSimd());
+        }
+
+        bool Match(const char16_t *name, const size_t length, const GlobSimd simd) const
+        {
+            if (_matchAll)
+            {
+                return true;
+            }
+            if (_runs.empty())
+            {
+                // Only stars
+                return true;
+            }
+
+            auto first = _runs.begin();
+            auto last = _runs.end();
+            size_t pos = 0;
+            auto end = length;
+
+            if (!_leadingStar)
+            {
+                if (_runs.size() == 1 && !_trailingStar)
+                {
+                    return length == first->text.size() && Verify(*first, name);
+                }
+                if (length < first->text.size() || !Verify(*first, name))
+                {
+                    return false;
+                }
+                pos = first->text.size();
+                ++first;
+            }
+
+            if (!_trailingStar)
+            {
+                --last;
+                if (length < pos + last->text.size() || !Verify(*last, name + length - last->text.size()))
+                {
+                    return false;
+                }
+                end = length - last->text.size();
+            }
+
+            for (auto run = first; run < last; ++run)
+            {
+                const auto found = Find(*run, name, pos, end, simd);
+                if (found == std::u16string::npos)
+                {
+                    return false;
+                }
+                pos = found + run->text.size();
+            }
+            return true;
+        }
+    };
+}
+#endif
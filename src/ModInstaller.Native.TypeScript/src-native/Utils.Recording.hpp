@@ -0,0 +1,499 @@
+#ifndef VE_LIB_UTILS_RECORDING_GUARD_HPP_
+#define VE_LIB_UTILS_RECORDING_GUARD_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <codecvt>
+#include <cstdio>
+#include <locale>
+#include <map>
+#include <stdexcept>
+#include <algorithm>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "ModInstaller.Native.h"
+
+using namespace ModInstaller::Native;
+
+// Record of the callback traffic between ModInstaller.Native and the host.
+//
+// File layout (little endian):
+//   header: u32 magic 'FMRL', u16 format version, u16 reserved
+//   record: u8 kind, u8 thread, varint start delta (us), varint duration (us), fields...
+//
+// Fields are varints (zigzag for signed values), or length-prefixed blobs where the prefix
+// is varint(length + 1) and 0 marks null. Strings and JSON are stored as UTF-8.
+// The arguments of a record come first, then its results, in the order given by KindFields.
+namespace Utils::Recording
+{
+    constexpr uint32_t Magic = 0x4C524D46; // 'FMRL'
+    constexpr uint16_t FormatVersion = 2;
+
+    enum class Kind : uint8_t
+    {
+        Install = 1,
+        ReadFileContent,
+        ReadDirectoryFileList,
+        ReadDirectoryList,
+        PluginsGetAll,
+        ContextGetAppVersion,
+        ContextGetCurrentGameVersion,
+        ContextGetExtenderVersion,
+        UIStartDialog,
+        UIEndDialog,
+        UIUpdateState,
+        UISelect,
+        UIContinue,
+        UICancel,
+        Stat,
+        Max
+    };
+
+    enum class FieldType : uint8_t
+    {
+        Int,
+        Text,
+        Blob
+    };
+
+    struct KindFields
+    {
+        std::vector<FieldType> args;
+        std::vector<FieldType> results;
+    };
+
+    // Results always start with the error text of the return value
+    inline const KindFields &FieldsOf(const Kind kind)
+    {
+        static const std::map<Kind, KindFields> fields{
+            {Kind::Install, {{FieldType::Text, FieldType::Text, FieldType::Text, FieldType::Text, FieldType::Text, FieldType::Int, FieldType::Int, FieldType::Int}, {}}},
+            {Kind::ReadFileContent, {{FieldType::Text, FieldType::Int, FieldType::Int}, {FieldType::Text, FieldType::Blob}}},
+            {Kind::ReadDirectoryFileList, {{FieldType::Text, FieldType::Text, FieldType::Int}, {FieldType::Text, FieldType::Text}}},
+            {Kind::ReadDirectoryList, {{FieldType::Text}, {FieldType::Text, FieldType::Text}}},
+            {Kind::PluginsGetAll, {{FieldType::Int}, {FieldType::Text, FieldType::Text}}},
+            {Kind::ContextGetAppVersion, {{}, {FieldType::Text, FieldType::Text}}},
+            {Kind::ContextGetCurrentGameVersion, {{}, {FieldType::Text, FieldType::Text}}},
+            {Kind::ContextGetExtenderVersion, {{FieldType::Text}, {FieldType::Text, FieldType::Text}}},
+            {Kind::UIStartDialog, {{FieldType::Text, FieldType::Text}, {FieldType::Text}}},
+            {Kind::UIEndDialog, {{}, {FieldType::Text}}},
+            {Kind::UIUpdateState, {{FieldType::Text, FieldType::Int}, {FieldType::Text}}},
+            {Kind::UISelect, {{FieldType::Int, FieldType::Int, FieldType::Text}, {}}},
+            {Kind::UIContinue, {{FieldType::Int, FieldType::Int}, {}}},
+            {Kind::UICancel, {{}, {}}},
+            {Kind::Stat, {{FieldType::Text}, {FieldType::Text, FieldType::Text}}},
+        };
+        return fields.at(kind);
+    }
+
+    class RecordWriter
+    {
+    private:
+        std::string _buffer;
+
+    public:
+        void Byte(const uint8_t value)
+        {
+            _buffer.push_back(static_cast<char>(value));
+        }
+
+        void Varint(uint64_t value)
+        {
+            while (value >= 0x80)
+            {
+                Byte(static_cast<uint8_t>(value | 0x80));
+                value >>= 7;
+            }
+            Byte(static_cast<uint8_t>(value));
+        }
+
+        void Int(const int64_t value)
+        {
+            Varint((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+        }
+
+        void Blob(const uint8_t *data, const size_t length)
+        {
+            if (data == nullptr)
+            {
+                Varint(0);
+                return;
+            }
+            Varint(length + 1);
+            _buffer.append(reinterpret_cast<const char *>(data), length);
+        }
+
+        void Text(const char16_t *value)
+        {
+            if (value == nullptr)
+            {
+                Varint(0);
+                return;
+            }
+            std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t> conv;
+            const auto utf8 = conv.to_bytes(value);
+            Blob(reinterpret_cast<const uint8_t *>(utf8.data()), utf8.size());
+        }
+
+        template <typename T>
+        void Error(const T *result)
+        {
+            Text(result == nullptr ? u"Missing return value" : result->error);
+        }
+
+        const std::string &Buffer() const
+        {
+            return _buffer;
+        }
+    };
+
+    class RecordReader
+    {
+    private:
+        const std::string &_data;
+        size_t _offset;
+
+    public:
+        RecordReader(const std::string &data, const size_t offset) : _data(data), _offset(offset) {}
+
+        size_t Offset() const
+        {
+            return _offset;
+        }
+
+        bool AtEnd() const
+        {
+            return _offset >= _data.size();
+        }
+
+        uint8_t Byte()
+        {
+            if (_offset >= _data.size())
+            {
+                throw std::runtime_error("Recording is truncated");
+            }
+            return static_cast<uint8_t>(_data[_offset++]);
+        }
+
+        uint64_t Varint()
+        {
+            uint64_t value = 0;
+            for (int shift = 0; shift < 64; shift += 7)
+            {
+                const auto byte = Byte();
+                value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+                if ((byte & 0x80) == 0)
+                {
+                    return value;
+                }
+            }
+            throw std::runtime_error("Recording has a malformed varint");
+        }
+
+        int64_t Int()
+        {
+            const auto value = Varint();
+            return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+        }
+
+        // Returns false for null
+        bool Blob(std::string &value)
+        {
+            const auto length = Varint();
+            if (length == 0)
+            {
+                value.clear();
+                return false;
+            }
+            if (_offset + length - 1 > _data.size())
+            {
+                throw std::runtime_error("Recording is truncated");
+            }
+            value.assign(_data, _offset, length - 1);
+            _offset += length - 1;
+            return true;
+        }
+
+        void Skip(const FieldType type)
+        {
+            std::string ignored;
+            if (type == FieldType::Int)
+            {
+                Varint();
+            }
+            else
+            {
+                Blob(ignored);
+            }
+        }
+    };
+
+    class Recorder
+    {
+    private:
+        static inline std::atomic<bool> _active{false};
+        static inline std::mutex _mutex;
+        static inline FILE *_file = nullptr;
+        static inline std::chrono::steady_clock::time_point _origin;
+        static inline uint64_t _lastStartUs = 0;
+        static inline uint64_t _records = 0;
+        static inline uint64_t _bytes = 0;
+        static inline std::map<std::thread::id, uint8_t> _threads;
+
+    public:
+        static bool IsActive() noexcept
+        {
+            return _active.load(std::memory_order_relaxed);
+        }
+
+        static std::chrono::steady_clock::time_point Now() noexcept
+        {
+            return std::chrono::steady_clock::now();
+        }
+
+        static bool Start(const std::string &path)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_file != nullptr)
+            {
+                return false;
+            }
+            _file = std::fopen(path.c_str(), "wb");
+            if (_file == nullptr)
+            {
+                return false;
+            }
+
+            const uint8_t header[8] = {
+                static_cast<uint8_t>(Magic), static_cast<uint8_t>(Magic >> 8), static_cast<uint8_t>(Magic >> 16), static_cast<uint8_t>(Magic >> 24),
+                static_cast<uint8_t>(FormatVersion), static_cast<uint8_t>(FormatVersion >> 8), 0, 0};
+            std::fwrite(header, 1, sizeof(header), _file);
+
+            _origin = Now();
+            _lastStartUs = 0;
+            _records = 0;
+            _bytes = sizeof(header);
+            _threads.clear();
+            _active.store(true);
+            return true;
+        }
+
+        // Returns the number of records and bytes written
+        static std::pair<uint64_t, uint64_t> Stop()
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _active.store(false);
+            if (_file != nullptr)
+            {
+                std::fclose(_file);
+                _file = nullptr;
+            }
+            return {_records, _bytes};
+        }
+
+        template <typename TFields>
+        static void Write(const Kind kind, const std::chrono::steady_clock::time_point start, TFields fields) noexcept
+        {
+            try
+            {
+                const auto end = Now();
+                RecordWriter body;
+                fields(body);
+
+                std::lock_guard<std::mutex> lock(_mutex);
+                if (_file == nullptr)
+                {
+                    return;
+                }
+
+                const auto startUs = static_cast<uint64_t>(std::max<int64_t>(0, std::chrono::duration_cast<std::chrono::microseconds>(start - _origin).count()));
+                const auto durationUs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
+                const auto thread = _threads.emplace(std::this_thread::get_id(), static_cast<uint8_t>(std::min<size_t>(_threads.size(), 255))).first->second;
+
+                // Records are written when a call completes, so starts are not monotonic; the delta is signed
+                RecordWriter head;
+                head.Byte(static_cast<uint8_t>(kind));
+                head.Byte(thread);
+                head.Int(static_cast<int64_t>(startUs) - static_cast<int64_t>(_lastStartUs));
+                head.Varint(durationUs);
+                _lastStartUs = startUs;
+
+                std::fwrite(head.Buffer().data(), 1, head.Buffer().size(), _file);
+                std::fwrite(body.Buffer().data(), 1, body.Buffer().size(), _file);
+                _records++;
+                _bytes += head.Buffer().size() + body.Buffer().size();
+            }
+            catch (...)
+            {
+                // Recording must never break the install it observes
+            }
+        }
+    };
+
+    // Wrappers registered in place of the bridge callbacks; they forward directly unless recording
+
+    template <return_value_data *(*Fn)(param_ptr *, param_string *, param_int, param_int)>
+    return_value_data *RecordReadFileContent(param_ptr *p_owner, param_string *p_file_path, param_int offset, param_int length) noexcept
+    {
+        if (!Recorder::IsActive())
+            return Fn(p_owner, p_file_path, offset, length);
+        const auto start = Recorder::Now();
+        const auto result = Fn(p_owner, p_file_path, offset, length);
+        Recorder::Write(Kind::ReadFileContent, start, [&](RecordWriter &w)
+                        { w.Text(p_file_path); w.Int(offset); w.Int(length);
+                          w.Error(result);
+                          w.Blob(result == nullptr ? nullptr : result->value, result == nullptr ? 0 : static_cast<size_t>(result->length)); });
+        return result;
+    }
+
+    template <return_value_json *(*Fn)(param_ptr *, param_string *, param_string *, param_int)>
+    return_value_json *RecordReadDirectoryFileList(param_ptr *p_owner, param_string *p_directory_path, param_string *p_pattern, param_int search_type) noexcept
+    {
+        if (!Recorder::IsActive())
+            return Fn(p_owner, p_directory_path, p_pattern, search_type);
+        const auto start = Recorder::Now();
+        const auto result = Fn(p_owner, p_directory_path, p_pattern, search_type);
+        Recorder::Write(Kind::ReadDirectoryFileList, start, [&](RecordWriter &w)
+                        { w.Text(p_directory_path); w.Text(p_pattern); w.Int(search_type);
+                          w.Error(result); w.Text(result == nullptr ? nullptr : result->value); });
+        return result;
+    }
+
+    template <return_value_json *(*Fn)(param_ptr *, param_string *)>
+    return_value_json *RecordReadDirectoryList(param_ptr *p_owner, param_string *p_directory_path) noexcept
+    {
+        if (!Recorder::IsActive())
+            return Fn(p_owner, p_directory_path);
+        const auto start = Recorder::Now();
+        const auto result = Fn(p_owner, p_directory_path);
+        Recorder::Write(Kind::ReadDirectoryList, start, [&](RecordWriter &w)
+                        { w.Text(p_directory_path);
+                          w.Error(result); w.Text(result == nullptr ? nullptr : result->value); });
+        return result;
+    }
+
+    template <return_value_json *(*Fn)(param_ptr *, param_string *)>
+    return_value_json *RecordStat(param_ptr *p_owner, param_string *p_path) noexcept
+    {
+        if (!Recorder::IsActive())
+            return Fn(p_owner, p_path);
+        const auto start = Recorder::Now();
+        const auto result = Fn(p_owner, p_path);
+        Recorder::Write(Kind::Stat, start, [&](RecordWriter &w)
+                        { w.Text(p_path);
+                          w.Error(result); w.Text(result == nullptr ? nullptr : result->value); });
+        return result;
+    }
+
+    template <return_value_json *(*Fn)(param_ptr *, param_bool)>
+    return_value_json *RecordPluginsGetAll(param_ptr *p_owner, param_bool active_only) noexcept
+    {
+        if (!Recorder::IsActive())
+            return Fn(p_owner, active_only);
+        const auto start = Recorder::Now();
+        const auto result = Fn(p_owner, active_only);
+        Recorder::Write(Kind::PluginsGetAll, start, [&](RecordWriter &w)
+                        { w.Int(active_only);
+                          w.Error(result); w.Text(result == nullptr ? nullptr : result->value); });
+        return result;
+    }
+
+    template <Kind K, return_value_string *(*Fn)(param_ptr *)>
+    return_value_string *RecordContextGet(param_ptr *p_owner) noexcept
+    {
+        if (!Recorder::IsActive())
+            return Fn(p_owner);
+        const auto start = Recorder::Now();
+        const auto result = Fn(p_owner);
+        Recorder::Write(K, start, [&](RecordWriter &w)
+                        { w.Error(result); w.Text(result == nullptr ? nullptr : result->value); });
+        return result;
+    }
+
+    template <return_value_string *(*Fn)(param_ptr *, param_string *)>
+    return_value_string *RecordContextGetExtenderVersion(param_ptr *p_owner, param_string *p_extender) noexcept
+    {
+        if (!Recorder::IsActive())
+            return Fn(p_owner, p_extender);
+        const auto start = Recorder::Now();
+        const auto result = Fn(p_owner, p_extender);
+        Recorder::Write(Kind::ContextGetExtenderVersion, start, [&](RecordWriter &w)
+                        { w.Text(p_extender);
+                          w.Error(result); w.Text(result == nullptr ? nullptr : result->value); });
+        return result;
+    }
+
+    template <return_value_void *(*Fn)(param_ptr *, param_string *, param_json *, param_ptr *,
+                                       void (*)(param_ptr *, param_int, param_int, param_json *, return_value_void *),
+                                       void (*)(param_ptr *, param_bool, param_int, return_value_void *),
+                                       void (*)(param_ptr *, return_value_void *))>
+    return_value_void *RecordUIStartDialog(param_ptr *p_owner, param_string *p_module_name, param_json *p_image, param_ptr *p_callback_handler,
+                                           void (*p_select_callback)(param_ptr *, param_int, param_int, param_json *, return_value_void *),
+                                           void (*p_cont_callback)(param_ptr *, param_bool, param_int, return_value_void *),
+                                           void (*p_cancel_callback)(param_ptr *, return_value_void *)) noexcept
+    {
+        if (!Recorder::IsActive())
+            return Fn(p_owner, p_module_name, p_image, p_callback_handler, p_select_callback, p_cont_callback, p_cancel_callback);
+        const auto start = Recorder::Now();
+        const auto result = Fn(p_owner, p_module_name, p_image, p_callback_handler, p_select_callback, p_cont_callback, p_cancel_callback);
+        Recorder::Write(Kind::UIStartDialog, start, [&](RecordWriter &w)
+                        { w.Text(p_module_name); w.Text(p_image); w.Error(result); });
+        return result;
+    }
+
+    template <return_value_void *(*Fn)(param_ptr *)>
+    return_value_void *RecordUIEndDialog(param_ptr *p_owner) noexcept
+    {
+        if (!Recorder::IsActive())
+            return Fn(p_owner);
+        const auto start = Recorder::Now();
+        const auto result = Fn(p_owner);
+        Recorder::Write(Kind::UIEndDialog, start, [&](RecordWriter &w)
+                        { w.Error(result); });
+        return result;
+    }
+
+    template <return_value_void *(*Fn)(param_ptr *, param_json *, param_int)>
+    return_value_void *RecordUIUpdateState(param_ptr *p_owner, param_json *p_install_steps, param_int current_step) noexcept
+    {
+        if (!Recorder::IsActive())
+            return Fn(p_owner, p_install_steps, current_step);
+        const auto start = Recorder::Now();
+        const auto result = Fn(p_owner, p_install_steps, current_step);
+        Recorder::Write(Kind::UIUpdateState, start, [&](RecordWriter &w)
+                        { w.Text(p_install_steps); w.Int(current_step); w.Error(result); });
+        return result;
+    }
+
+    // The dialog callbacks run from JS into .NET, they are recorded as instant events
+    inline void RecordUISelect(const int32_t groupId, const int32_t optionId, const char16_t *selectedIds) noexcept
+    {
+        if (Recorder::IsActive())
+            Recorder::Write(Kind::UISelect, Recorder::Now(), [&](RecordWriter &w)
+                            { w.Int(groupId); w.Int(optionId); w.Text(selectedIds); });
+    }
+
+    inline void RecordUIContinue(const uint8_t goForward, const int32_t stepId) noexcept
+    {
+        if (Recorder::IsActive())
+            Recorder::Write(Kind::UIContinue, Recorder::Now(), [&](RecordWriter &w)
+                            { w.Int(goForward); w.Int(stepId); });
+    }
+
+    inline void RecordUICancel() noexcept
+    {
+        if (Recorder::IsActive())
+            Recorder::Write(Kind::UICancel, Recorder::Now(), [](RecordWriter &) {});
+    }
+
+    inline void RecordInstall(const char16_t *files, const char16_t *stopPatterns, const char16_t *pluginPath, const char16_t *scriptPath,
+                              const char16_t *preset, const uint8_t preselect, const uint8_t validate, const uint8_t headless) noexcept
+    {
+        if (Recorder::IsActive())
+            Recorder::Write(Kind::Install, Recorder::Now(), [&](RecordWriter &w)
+                            { w.Text(files); w.Text(stopPatterns); w.Text(pluginPath); w.Text(scriptPath); w.Text(preset);
+                              w.Int(preselect); w.Int(validate); w.Int(headless); });
+    }
+}
+#endif
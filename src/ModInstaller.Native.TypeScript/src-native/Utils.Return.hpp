@@ -177,5 +177,32 @@ namespace Utils
         const auto error = std::unique_ptr<char16_t[], common_deallocor<char16_t>>(result->error);
         NAPI_THROW(Error::New(env, String::New(env, error.get())));
     }
+
+    // A null value is returned as null, not as an error
+    Value ThrowOrReturnBuffer(const Env env, return_value_data *const result)
+    {
+        const del_data del{result};
+
+        if (result == nullptr)
+        {
+            Logger::Log(__FUNCTION__, "Null result");
+            NAPI_THROW(Error::New(env, String::New(env, "Return value was null!")));
+        }
+
+        if (result->error == nullptr)
+        {
+            if (result->value == nullptr)
+            {
+                return env.Null();
+            }
+
+            // External buffers are not allowed, so the data is copied and freed
+            const auto value = std::unique_ptr<uint8_t[], common_deallocor<uint8_t>>(result->value);
+            return Buffer<uint8_t>::Copy(env, value.get(), static_cast<size_t>(result->length));
+        }
+
+        const auto error = std::unique_ptr<char16_t[], common_deallocor<char16_t>>(result->error);
+        NAPI_THROW(Error::New(env, String::New(env, error.get())));
+    }
 }
 #endif
\ No newline at end of file
@@ -0,0 +1,265 @@
+#ifndef VE_LIB_UTILS_WATCHDOG_GUARD_HPP_
+#define VE_LIB_UTILS_WATCHDOG_GUARD_HPP_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <codecvt>
+#include <condition_variable>
+#include <deque>
+#include <locale>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include "ModInstaller.Native.h"
+#include "Logger.hpp"
+#include "Utils.Generic.hpp"
+
+using namespace ModInstaller::Native;
+
+// Deadlines for the callbacks ModInstaller.Native makes from its own threads.
+// Such a callback is queued on the JS thread and the calling thread waits for it. When the JS thread
+// doesn't get to it in time, the wait gives up, returns an error to the caller and records a stall.
+// A ui callback may rightly take as long as the user does, like a dialog waiting for input, so it
+// waits without a deadline until the host sets one. The other categories answer without the user
+// and get a generous default, so a stuck event loop can't hold an install thread forever.
+// The state of a call lives on the heap, so a callback that runs after its caller gave up finds out
+// and drops its result instead of writing to a stack frame that is gone.
+namespace Utils::Watchdog
+{
+    enum class Category : uint8_t
+    {
+        FileSystem,
+        Context,
+        UI,
+        Logging,
+        Max
+    };
+
+    constexpr size_t CategoryCount = static_cast<size_t>(Category::Max);
+    constexpr uint32_t DefaultTimeoutMs = 30000;
+    constexpr size_t MaxRecentStalls = 32;
+
+    inline const char *CategoryName(const Category category)
+    {
+        static const std::array<const char *, CategoryCount> names{"fileSystem", "context", "ui", "logging"};
+        return names[static_cast<size_t>(category)];
+    }
+
+    struct Stall
+    {
+        std::string callback;
+        Category category;
+        uint64_t waitedMs;
+        // Whether the JS thread had started the callback, a queued callback means the event loop didn't get to it
+        bool running;
+        // Time since the JS thread last started any of these callbacks, -1 when it never did
+        int64_t sinceLastCallbackMs;
+    };
+
+    struct StallStats
+    {
+        std::array<uint32_t, CategoryCount> timeoutsMs;
+        std::array<uint64_t, CategoryCount> stalls;
+        // Callbacks that finished after their caller gave up
+        uint64_t late;
+        std::deque<Stall> recent;
+    };
+
+    class Monitor
+    {
+    public:
+        static uint32_t GetTimeout(const Category category)
+        {
+            return _timeoutsMs[static_cast<size_t>(category)].load(std::memory_order_relaxed);
+        }
+
+        // 0 waits without a deadline
+        static void SetTimeout(const Category category, const uint32_t timeoutMs)
+        {
+            _timeoutsMs[static_cast<size_t>(category)].store(timeoutMs, std::memory_order_relaxed);
+        }
+
+        static void CallbackStarted()
+        {
+            _lastCallbackMs.store(NowMs(), std::memory_order_relaxed);
+        }
+
+        static void RecordStall(const Category category, const char *callback, const uint64_t waitedMs, const bool running)
+        {
+            const auto lastCallbackMs = _lastCallbackMs.load(std::memory_order_relaxed);
+            const auto sinceLastCallbackMs = lastCallbackMs < 0 ? -1 : NowMs() - lastCallbackMs;
+
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stalls[static_cast<size_t>(category)]++;
+            _recent.push_back(Stall{callback, category, waitedMs, running, sinceLastCallbackMs});
+            if (_recent.size() > MaxRecentStalls)
+            {
+                _recent.pop_front();
+            }
+        }
+
+        static void RecordLate()
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _late++;
+        }
+
+        static StallStats GetStats()
+        {
+            StallStats stats{};
+            for (size_t i = 0; i < CategoryCount; i++)
+            {
+                stats.timeoutsMs[i] = _timeoutsMs[i].load(std::memory_order_relaxed);
+            }
+
+            std::lock_guard<std::mutex> lock(_mutex);
+            stats.stalls = _stalls;
+            stats.late = _late;
+            stats.recent = _recent;
+            return stats;
+        }
+
+        static void ResetStats()
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stalls.fill(0);
+            _late = 0;
+            _recent.clear();
+        }
+
+        static int64_t NowMs()
+        {
+            return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+    private:
+        static inline std::array<std::atomic<uint32_t>, CategoryCount> _timeoutsMs{DefaultTimeoutMs, DefaultTimeoutMs, 0, DefaultTimeoutMs};
+        static inline std::atomic<int64_t> _lastCallbackMs{-1};
+
+        static inline std::mutex _mutex;
+        static inline std::array<uint64_t, CategoryCount> _stalls{};
+        static inline uint64_t _late = 0;
+        static inline std::deque<Stall> _recent;
+    };
+
+    // The result handed to the caller when the wait gives up, and how a result nobody waits for is freed
+    inline return_value_void *ErrorResult(return_value_void *, const std::u16string &message) { return Create(return_value_void{Copy(message)}); }
+    inline return_value_string *ErrorResult(return_value_string *, const std::u16string &message) { return Create(return_value_string{Copy(message), nullptr}); }
+    inline return_value_json *ErrorResult(return_value_json *, const std::u16string &message) { return Create(return_value_json{Copy(message), nullptr}); }
+    inline return_value_data *ErrorResult(return_value_data *, const std::u16string &message) { return Create(return_value_data{Copy(message), nullptr, 0}); }
+    inline int32_t ErrorResult(int32_t, const std::u16string &) { return -6; }
+
+    template <typename T>
+    inline void Discard(T *result)
+    {
+        if (result != nullptr)
+        {
+            common_dealloc(result->error);
+            if constexpr (!std::is_same_v<T, return_value_void>)
+            {
+                common_dealloc(result->value);
+            }
+            common_dealloc(result);
+        }
+    }
+    inline void Discard(int32_t) {}
+
+    // One callback queued on the JS thread, shared by the waiting thread and the queued callback
+    template <typename T>
+    class PendingCall
+    {
+    public:
+        PendingCall(const Category category, const char *name) : _category(category), _name(name) {}
+
+        static std::shared_ptr<PendingCall<T>> New(const Category category, const char *name)
+        {
+            return std::make_shared<PendingCall<T>>(category, name);
+        }
+
+        // Called by the queued callback before it reads the arguments. The lock is empty when the caller
+        // gave up, the arguments may be gone then. Otherwise the caller can't give up while it is held,
+        // release it once the arguments are converted.
+        std::unique_lock<std::mutex> Start()
+        {
+            Monitor::CallbackStarted();
+
+            std::unique_lock<std::mutex> lock(_mutex);
+            if (_status == Status::Abandoned)
+            {
+                return std::unique_lock<std::mutex>();
+            }
+            _status = Status::Running;
+            return lock;
+        }
+
+        void Complete(T result)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_status == Status::Abandoned)
+            {
+                Discard(result);
+                Monitor::RecordLate();
+                return;
+            }
+            _result = result;
+            _status = Status::Completed;
+            _cv.notify_one();
+        }
+
+        T Wait()
+        {
+            const auto timeoutMs = Monitor::GetTimeout(_category);
+            const auto start = std::chrono::steady_clock::now();
+
+            std::unique_lock<std::mutex> lock(_mutex);
+            const auto completed = [this]
+            { return _status == Status::Completed; };
+            if (timeoutMs == 0)
+            {
+                _cv.wait(lock, completed);
+                return _result;
+            }
+            if (_cv.wait_for(lock, std::chrono::milliseconds(timeoutMs), completed))
+            {
+                return _result;
+            }
+
+            const auto running = _status == Status::Running;
+            _status = Status::Abandoned;
+            lock.unlock();
+
+            const auto waitedMs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count());
+            Monitor::RecordStall(_category, _name, waitedMs, running);
+
+            const auto message = std::string("Callback ") + _name + " timed out after " + std::to_string(waitedMs) + " ms (" + (running ? "running" : "queued") + ")";
+            // The message would go through the log callback that just stalled
+            if (_category != Category::Logging)
+            {
+                Logger::Log(__FUNCTION__, message);
+            }
+            std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t> conv;
+            return ErrorResult(T{}, conv.from_bytes(message));
+        }
+
+    private:
+        enum class Status
+        {
+            Queued,
+            Running,
+            Completed,
+            Abandoned
+        };
+
+        const Category _category;
+        const char *const _name;
+
+        std::mutex _mutex;
+        std::condition_variable _cv;
+        Status _status = Status::Queued;
+        T _result{};
+    };
+}
+
+#endif
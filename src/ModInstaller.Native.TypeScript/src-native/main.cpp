@@ -5,7 +5,13 @@
 #include "Bindings.Common.hpp"
 #include "Bindings.Logging.Implementation.hpp"
 #include "Bindings.ModInstaller.Implementation.hpp"
+#include "Bindings.InstallResult.Implementation.hpp"
 #include "Bindings.FileSystem.Implementation.hpp"
+#include "Bindings.ScriptCache.hpp"
+#include "Bindings.ImagePrefetch.hpp"
+#include "Bindings.Runtime.hpp"
+#include "Bindings.Recording.hpp"
+#include "Bindings.Watchdog.hpp"
 
 using namespace Napi;
 
@@ -14,7 +20,13 @@ Object InitAll(const Env env, const Object exports)
   Bindings::Common::Init(env, exports);
   Bindings::Logging::Init(env, exports);
   Bindings::ModInstaller::Init(env, exports);
+  Bindings::InstallResult::Init(env, exports);
   Bindings::FileSystem::Init(env, exports);
+  Bindings::ScriptCache::Init(env, exports);
+  Bindings::ImagePrefetch::Init(env, exports);
+  Bindings::Runtime::Init(env, exports);
+  Bindings::Recording::Init(env, exports);
+  Bindings::Watchdog::Init(env, exports);
   return exports;
 }
 
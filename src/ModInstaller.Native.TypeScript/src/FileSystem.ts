@@ -9,12 +9,14 @@ export class NativeFileSystem implements types.FileSystem {
   public constructor(
     readFileContent: (filePath: string, offset: number, length: number) => Uint8Array | null,
     readDirectoryFileList: (directoryPath: string, pattern: string, searchType: number) => string[] | null,
-    readDirectoryList: (directoryPath: string) => string[] | null
+    readDirectoryList: (directoryPath: string) => string[] | null,
+    stat?: (path: string) => types.FileSystemStat | null
   ) {
     this.manager = new native.FileSystem(
       readFileContent,
       readDirectoryFileList,
-      readDirectoryList
+      readDirectoryList,
+      stat
     );
   }
 
@@ -25,4 +27,8 @@ export class NativeFileSystem implements types.FileSystem {
   public static setDefaultCallbacks = (): void => {
     return native.FileSystem.setDefaultCallbacks();
   }
+
+  public static setDirectorySnapshots = (enabled: boolean): void => {
+    return native.FileSystem.setDirectorySnapshots(enabled);
+  }
 }
\ No newline at end of file
@@ -0,0 +1,8 @@
+import { addon } from './resolve-native';
+import * as types from './types';
+
+const native: types.IImagePrefetchExtension = addon;
+
+export const setImagePrefetchCapacity = (capacity: number): void => {
+  return native.setImagePrefetchCapacity(capacity);
+}
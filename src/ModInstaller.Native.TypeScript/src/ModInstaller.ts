@@ -26,12 +26,70 @@ export class NativeModInstaller implements types.ModInstaller {
     );
   }
 
-  public install(files: string[], stopPatterns: string[], pluginPath: string,
-    scriptPath: string, preset: any, preselect: boolean, validate: boolean): Promise<types.InstallResult | null> {
-    return this.manager.install(files, stopPatterns, pluginPath, scriptPath, preset, preselect, validate);
+  public install(files: string[], stopPatterns: string[] | number, pluginPath: string,
+    scriptPath: string, preset: any, preselect: boolean, validate: boolean, headless: boolean = false): Promise<types.InstallResult | null> {
+    return this.manager.install(files, stopPatterns, pluginPath, scriptPath, preset, preselect, validate, headless);
+  }
+
+  // Same as install with the result handed over in a binary layout instead of JSON; instruction data is a Buffer
+  public installCompact(files: string[], stopPatterns: string[] | number, pluginPath: string,
+    scriptPath: string, preset: any, preselect: boolean, validate: boolean, headless: boolean = false): Promise<types.InstallResult | null> {
+    return this.manager.installCompact(files, stopPatterns, pluginPath, scriptPath, preset, preselect, validate, headless);
+  }
+
+  // Instructions stay in native memory until they are read
+  public installLazy(files: string[], stopPatterns: string[] | number, pluginPath: string,
+    scriptPath: string, preset: any, preselect: boolean, validate: boolean, headless: boolean = false): Promise<types.NativeInstallResult | null> {
+    return this.manager.installLazy(files, stopPatterns, pluginPath, scriptPath, preset, preselect, validate, headless);
+  }
+
+  // Binds the callbacks of the next install, an instance can serve any number of sequential installs
+  public reset(
+    pluginsGetAll: (activeOnly: boolean) => string[],
+    contextGetAppVersion: () => string,
+    contextGetCurrentGameVersion: () => string,
+    contextGetExtenderVersion: (extender: string) => string,
+    uiStartDialog: (moduleName: string, image: types.IHeaderImage, selectCallback: types.SelectCallback, contCallback: types.ContinueCallback, cancelCallback: types.CancelCallback) => void,
+    uiEndDialog: () => void,
+    uiUpdateState: (installSteps: types.IInstallStep[], currentStep: number) => void
+  ): void {
+    this.manager.reset(
+      pluginsGetAll,
+      contextGetAppVersion,
+      contextGetCurrentGameVersion,
+      contextGetExtenderVersion,
+      uiStartDialog,
+      uiEndDialog,
+      uiUpdateState
+    );
+  }
+
+  // An image of this instance's dialog, by the path the dialog was given; null when it isn't prefetched (yet)
+  public getImage(path: string): Buffer | null {
+    return this.manager.getImage(path);
+  }
+
+  public imagePrefetchStats(): types.ImagePrefetchStats {
+    return this.manager.imagePrefetchStats();
   }
 
   public static testSupported = (files: string[], allowedTypes: string[]): types.SupportedResult => {
     return native.ModInstaller.testSupported(files, allowedTypes);
   }
+
+  public static testSupportedAsync = (files: string[], allowedTypes: string[]): Promise<types.SupportedResult> => {
+    return native.ModInstaller.testSupportedAsync(files, allowedTypes);
+  }
+
+  public static testSupportedMany = (requests: types.SupportedRequest[]): Promise<types.SupportedResult[]> => {
+    return native.ModInstaller.testSupportedMany(requests);
+  }
+
+  public static registerStopPatterns = (stopPatterns: string[]): number => {
+    return native.ModInstaller.registerStopPatterns(stopPatterns);
+  }
+
+  public static unregisterStopPatterns = (id: number): void => {
+    return native.ModInstaller.unregisterStopPatterns(id);
+  }
 }
\ No newline at end of file
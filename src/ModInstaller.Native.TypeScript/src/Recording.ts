@@ -0,0 +1,17 @@
+import { addon } from './resolve-native';
+import * as types from './types';
+
+const native: types.IRecordingExtension = addon;
+
+export const startRecording = (path: string): void => {
+  native.startRecording(path);
+}
+export const stopRecording = (): types.RecordingStats => {
+  return native.stopRecording();
+}
+export const replayInstall = (path: string, options?: types.ReplayOptions): Promise<types.InstallResult | null> => {
+  return native.replayInstall(path, options);
+}
+export const getReplayStats = (): types.ReplayStats => {
+  return native.getReplayStats();
+}
\ No newline at end of file
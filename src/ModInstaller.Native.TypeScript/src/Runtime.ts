@@ -0,0 +1,13 @@
+import { addon } from './resolve-native';
+import * as types from './types';
+
+const native: types.IRuntimeExtension = addon;
+
+export const warmup = (options?: types.WarmupOptions): Promise<types.WarmupResult> => {
+  return native.warmup(options);
+}
+
+// gcServer and gcConserveMemory only apply when this is the first call into the library, later calls can't change them
+export const configureRuntime = (options?: types.RuntimeOptions): types.RuntimeSettings => {
+  return native.configureRuntime(options);
+}
\ No newline at end of file
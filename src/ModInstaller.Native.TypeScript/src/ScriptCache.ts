@@ -0,0 +1,17 @@
+import { addon } from './resolve-native';
+import * as types from './types';
+
+const native: types.IScriptCacheExtension = addon;
+
+export const precompileScript = (scriptPath: string, validate: boolean): Promise<boolean> => {
+  return native.precompileScript(scriptPath, validate);
+}
+export const clearScriptCache = (): void => {
+  return native.clearScriptCache();
+}
+export const setScriptCacheDirectory = (directory: string | null): void => {
+  return native.setScriptCacheDirectory(directory);
+}
+export const scriptCacheStats = (): types.ScriptCacheStats => {
+  return native.scriptCacheStats();
+}
\ No newline at end of file
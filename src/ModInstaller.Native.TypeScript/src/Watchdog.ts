@@ -0,0 +1,14 @@
+import { addon } from './resolve-native';
+import * as types from './types';
+
+const native: types.IWatchdogExtension = addon;
+
+export const configureWatchdog = (options?: types.WatchdogOptions): types.WatchdogTimeouts => {
+  return native.configureWatchdog(options);
+}
+export const getStallStats = (): types.StallStats => {
+  return native.getStallStats();
+}
+export const resetStallStats = (): void => {
+  native.resetStallStats();
+}
\ No newline at end of file
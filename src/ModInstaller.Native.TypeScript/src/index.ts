@@ -4,6 +4,11 @@ export * from './Common';
 export * from './Logger';
 export * from './ModInstaller';
 export * from './FileSystem';
+export * from './ScriptCache';
+export * from './ImagePrefetch';
+export * from './Runtime';
+export * from './Recording';
+export * from './Watchdog';
 
 export {
     types
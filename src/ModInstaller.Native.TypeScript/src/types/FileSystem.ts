@@ -1,12 +1,19 @@
 
+export interface FileSystemStat {
+  kind: 'file' | 'directory';
+  size: number;
+}
+
 export interface FileSystemConstructor {
   new(
     readFileContent: (filePath: string, offset: number, length: number) => Uint8Array | null,
     readDirectoryFileList: (directoryPath: string, pattern: string, searchType: number) => string[] | null,
-    readDirectoryList: (directoryPath: string) => string[] | null
+    readDirectoryList: (directoryPath: string) => string[] | null,
+    stat?: (path: string) => FileSystemStat | null
   ): FileSystem;
 
   setDefaultCallbacks(): void;
+  setDirectorySnapshots(enabled: boolean): void;
 }
 
 export interface FileSystem {
@@ -0,0 +1,17 @@
+export interface ImagePrefetchStats {
+  count: number;
+  bytes: number;
+  capacity: number;
+  hits: number;
+  misses: number;
+  evictions: number;
+  reads: number;
+  failures: number;
+  /** Reads started and not finished, at most 4 of them run at a time */
+  pending: number;
+}
+
+export interface IImagePrefetchExtension {
+  /** Capacity in bytes of each ModInstaller's image cache, 0 disables prefetching */
+  setImagePrefetchCapacity(capacity: number): void;
+}
\ No newline at end of file
@@ -8,7 +8,22 @@ export interface InstallInstruction {
   data: Uint8Array;
   priority: string;
 }
+export interface InstallDecision {
+  step: string;
+  group: string;
+  selected: string[];
+  fromPreset: boolean;
+}
 export interface InstallResult {
   message: string;
   instructions: InstallInstruction[];
+  decisions?: InstallDecision[];
+}
+export interface NativeInstallResult extends Iterable<InstallInstruction> {
+  readonly length: number;
+  /** undefined when the install didn't produce a message */
+  readonly message?: string;
+  readonly decisions?: InstallDecision[];
+  get(index: number): InstallInstruction | undefined;
+  filter(type: string): InstallInstruction[];
 }
\ No newline at end of file
@@ -1,6 +1,6 @@
 import {
-  SupportedResult, InstallResult, IHeaderImage,
-  SelectCallback, ContinueCallback, CancelCallback, IInstallStep
+  SupportedResult, SupportedRequest, InstallResult, NativeInstallResult, IHeaderImage,
+  SelectCallback, ContinueCallback, CancelCallback, IInstallStep, ImagePrefetchStats
 } from ".";
 
 export interface ModInstallerConstructor {
@@ -15,11 +15,30 @@ export interface ModInstallerConstructor {
   ): ModInstaller;
 
   testSupported(files: string[], allowedTypes: string[]): SupportedResult;
+  testSupportedAsync(files: string[], allowedTypes: string[]): Promise<SupportedResult>;
+  testSupportedMany(requests: SupportedRequest[]): Promise<SupportedResult[]>;
+  registerStopPatterns(stopPatterns: string[]): number;
+  unregisterStopPatterns(id: number): void;
 }
 
 export interface ModInstaller {
-  install(files: string[], stopPatterns: string[], pluginPath: string, scriptPath: string,
-    preset: any, preselect: boolean, validate: boolean): Promise<InstallResult | null>;
+  install(files: string[], stopPatterns: string[] | number, pluginPath: string, scriptPath: string,
+    preset: any, preselect: boolean, validate: boolean, headless?: boolean): Promise<InstallResult | null>;
+  installCompact(files: string[], stopPatterns: string[] | number, pluginPath: string, scriptPath: string,
+    preset: any, preselect: boolean, validate: boolean, headless?: boolean): Promise<InstallResult | null>;
+  installLazy(files: string[], stopPatterns: string[] | number, pluginPath: string, scriptPath: string,
+    preset: any, preselect: boolean, validate: boolean, headless?: boolean): Promise<NativeInstallResult | null>;
+  reset(
+    pluginsGetAll: (activeOnly: boolean) => string[],
+    contextGetAppVersion: () => string,
+    contextGetCurrentGameVersion: () => string,
+    contextGetExtenderVersion: (extender: string) => string,
+    uiStartDialog: (moduleName: string, image: IHeaderImage, selectCallback: SelectCallback, contCallback: ContinueCallback, cancelCallback: CancelCallback) => void,
+    uiEndDialog: () => void,
+    uiUpdateState: (installSteps: IInstallStep[], currentStep: number) => void
+  ): void;
+  getImage(path: string): Buffer | null;
+  imagePrefetchStats(): ImagePrefetchStats;
 }
 
 export interface IModInstallerExtension {
@@ -0,0 +1,25 @@
+import { InstallResult } from './InstallResult';
+
+export interface RecordingStats {
+  records: number;
+  bytes: number;
+}
+
+export interface ReplayOptions {
+  /** Waits for the recorded duration of every callback before answering */
+  timing?: boolean;
+}
+
+export interface ReplayStats {
+  running: boolean;
+  answered: number;
+  missed: number;
+  dialogActions: number;
+}
+
+export interface IRecordingExtension {
+  startRecording(path: string): void;
+  stopRecording(): RecordingStats;
+  replayInstall(path: string, options?: ReplayOptions): Promise<InstallResult | null>;
+  getReplayStats(): ReplayStats;
+}
\ No newline at end of file
@@ -0,0 +1,43 @@
+// Only the parts set to true run, warmup() without options runs all of them
+export interface WarmupOptions {
+  schemas?: boolean;
+  scriptTypes?: boolean;
+  logger?: boolean;
+}
+
+export interface WarmupResult {
+  schemaSets: number;
+  scriptsParsed: number;
+  schemas: number;
+  scriptTypes: number;
+  logger: number;
+  serializers: number;
+  total: number;
+}
+
+/**
+ * Omitted values keep the current setting.
+ * gcServer and gcConserveMemory are read when the .NET runtime starts, on the first call into the library:
+ * call configureRuntime before any other function of this module, including ModInstaller and warmup.
+ * A later call throws when they differ from the settings in effect, and changes nothing.
+ */
+export interface RuntimeOptions {
+  minThreads?: number;
+  maxThreads?: number;
+  gcServer?: boolean;
+  gcConserveMemory?: number;
+}
+
+/** The settings in effect after the call */
+export interface RuntimeSettings {
+  minThreads: number;
+  maxThreads: number;
+  threadCount: number;
+  gcServer: boolean;
+  gcConserveMemory: number;
+}
+
+export interface IRuntimeExtension {
+  warmup(options?: WarmupOptions): Promise<WarmupResult>;
+  configureRuntime(options?: RuntimeOptions): RuntimeSettings;
+}
\ No newline at end of file
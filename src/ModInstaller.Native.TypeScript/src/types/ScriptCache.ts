@@ -0,0 +1,17 @@
+export interface ScriptCacheStats {
+  count: number;
+  bytes: number;
+  capacity: number;
+  hits: number;
+  misses: number;
+  evictions: number;
+  diskHits: number;
+  diskWrites: number;
+}
+
+export interface IScriptCacheExtension {
+  precompileScript(scriptPath: string, validate: boolean): Promise<boolean>;
+  clearScriptCache(): void;
+  setScriptCacheDirectory(directory: string | null): void;
+  scriptCacheStats(): ScriptCacheStats;
+}
\ No newline at end of file
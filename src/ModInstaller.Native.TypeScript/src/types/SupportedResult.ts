@@ -1,4 +1,9 @@
 export interface SupportedResult {
   supported: boolean;
   requiredFiles: string[];
+}
+
+export interface SupportedRequest {
+  files: string[];
+  allowedTypes: string[];
 }
\ No newline at end of file
@@ -0,0 +1,37 @@
+export interface WatchdogTimeouts {
+  fileSystem: number;
+  context: number;
+  ui: number;
+  logging: number;
+}
+
+/**
+ * Deadlines in milliseconds for callbacks made from install threads, 0 waits without one.
+ * ui starts without a deadline, since a ui deadline also cuts short a dialog waiting for the user;
+ * the other categories start at 30000.
+ */
+export type WatchdogOptions = Partial<WatchdogTimeouts>;
+
+export interface StallRecord {
+  callback: string;
+  category: keyof WatchdogTimeouts;
+  waitedMs: number;
+  /** queued when the event loop never got to the callback, running when the JS callback didn't return in time */
+  state: 'queued' | 'running';
+  /** Time since the event loop last started any of these callbacks, null when it never did */
+  sinceLastCallbackMs: number | null;
+}
+
+export interface StallStats {
+  timeouts: WatchdogTimeouts;
+  stalls: Record<keyof WatchdogTimeouts, number>;
+  /** Callbacks that finished after their caller gave up */
+  late: number;
+  recent: StallRecord[];
+}
+
+export interface IWatchdogExtension {
+  configureWatchdog(options?: WatchdogOptions): WatchdogTimeouts;
+  getStallStats(): StallStats;
+  resetStallStats(): void;
+}
\ No newline at end of file
@@ -3,10 +3,20 @@ export * from './FileSystem';
 export * from './Logger';
 export * from './SupportedResult';
 export * from './InstallResult';
+export * from './ScriptCache';
+export * from './ImagePrefetch';
+export * from './Runtime';
+export * from './Recording';
+export * from './Watchdog';
 
 import { IFileSystemExtension } from './FileSystem';
 import { ILoggerExtension } from './Logger';
 import { IModInstallerExtension } from './ModInstaller';
+import { IScriptCacheExtension } from './ScriptCache';
+import { IImagePrefetchExtension } from './ImagePrefetch';
+import { IRuntimeExtension } from './Runtime';
+import { IRecordingExtension } from './Recording';
+import { IWatchdogExtension } from './Watchdog';
 
 export type OrderType = 'AlphaAsc' | 'AlphaDesc' | 'Explicit';
 export type GroupType = 'SelectAtLeastOne' | 'SelectAtMostOne' | 'SelectExactlyOne' | 'SelectAll' | 'SelectAny';
@@ -52,7 +62,7 @@ export type SelectCallback = (stepId: number, groupId: number, optionId: number[
 export type ContinueCallback = (forward: boolean, currentStepId: number) => void;
 export type CancelCallback = () => void;
 
-export interface IExtension extends IModInstallerExtension, IFileSystemExtension {
+export interface IExtension extends IModInstallerExtension, IFileSystemExtension, IScriptCacheExtension, IImagePrefetchExtension, IRuntimeExtension, IRecordingExtension, IWatchdogExtension {
     allocWithOwnership(length: number): Buffer | null;
     allocWithoutOwnership(length: number): Buffer | null;
     allocAliveCount(): number;
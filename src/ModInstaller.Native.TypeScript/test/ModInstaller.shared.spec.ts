@@ -1,5 +1,8 @@
 import { test, expect } from 'vitest';
-import { NativeModInstaller, NativeFileSystem, allocAliveCount } from '../src';
+import * as fs from 'fs';
+import * as os from 'os';
+import * as path from 'path';
+import { NativeModInstaller, NativeFileSystem, allocAliveCount, startRecording, stopRecording, replayInstall, getReplayStats, configureWatchdog, getStallStats, resetStallStats, setImagePrefetchCapacity, configureRuntime } from '../src';
 import * as types from '../src/types';
 import {
   getAllTestCases,
@@ -100,8 +103,11 @@ const compareInstructions = (actual: types.InstallInstruction[], expected: Instr
   return true;
 };
 
-// Run a single test case
-async function runTestCase(testCase: TestCase): Promise<void> {
+// One installer serving every case of the reuse variant, rebound with reset() before each install
+let reusedInstaller: NativeModInstaller | undefined;
+
+// Run a single test case, returning the decisions of a headless run and the last steps the dialog was shown
+async function runTestCase(testCase: TestCase, options: { registerStopPatterns?: boolean; headless?: boolean; compact?: boolean; lazy?: boolean; reuse?: boolean } = {}): Promise<{ decisions?: types.InstallDecision[]; steps: types.IInstallStep[] }> {
   const archive = await preloadArchive(testCase.archiveFile, testCase.game);
 
   try {
@@ -166,26 +172,64 @@ async function runTestCase(testCase: TestCase): Promise<void> {
       testCase.extenderVersion
     );
 
-    const installer = new NativeModInstaller(
+    let dialogs = 0;
+    let steps: types.IInstallStep[] = [];
+    const handlerCallbacks: ConstructorParameters<typeof NativeModInstaller> = [
       callbacks.pluginsGetAll,
       callbacks.contextGetAppVersion,
       callbacks.contextGetCurrentGameVersion,
       callbacks.contextGetExtenderVersion,
-      callbacks.uiStartDialog,
+      (...args: Parameters<typeof callbacks.uiStartDialog>) => {
+        dialogs++;
+        callbacks.uiStartDialog(...args);
+      },
       callbacks.uiEndDialog,
-      callbacks.uiUpdateState
-    );
+      (...args: Parameters<typeof callbacks.uiUpdateState>) => {
+        steps = args[0];
+        callbacks.uiUpdateState(...args);
+      }
+    ];
+    let installer: NativeModInstaller;
+    if (options.reuse) {
+      reusedInstaller ??= new NativeModInstaller(...handlerCallbacks);
+      reusedInstaller.reset(...handlerCallbacks);
+      installer = reusedInstaller;
+    } else {
+      installer = new NativeModInstaller(...handlerCallbacks);
+    }
+
+    // Reads the lazy result back into the shape install returns, checking its accessors agree
+    const installLazy = async (...args: Parameters<typeof installer.installLazy>): Promise<types.InstallResult | null> => {
+      const lazy = await installer.installLazy(...args);
+      if (lazy === null) {
+        return null;
+      }
+      const instructions = Array.from(lazy);
+      expect(instructions.length).toBe(lazy.length);
+      expect(lazy.get(lazy.length)).toBeUndefined();
+      if (instructions.length > 0) {
+        expect(lazy.get(0)).toEqual(instructions[0]);
+        expect(lazy.filter(instructions[0].type)).toEqual(instructions.filter(i => i.type === instructions[0].type));
+      }
+      return { message: lazy.message ?? '', instructions, decisions: lazy.decisions };
+    };
 
     // Run install
-    const result = await installer.install(
+    const stopPatternSet = options.registerStopPatterns ? NativeModInstaller.registerStopPatterns(stopPatterns) : null;
+    const install = options.lazy ? installLazy : options.compact ? installer.installCompact.bind(installer) : installer.install.bind(installer);
+    const result = await install(
       files,
-      stopPatterns,
+      stopPatternSet ?? stopPatterns,
       testCase.pluginPath,
       '', // scriptPath - empty, auto-detected
       testCase.preset ?? null,
       testCase.preselect ?? false,
-      testCase.validate ?? true
+      testCase.validate ?? true,
+      options.headless ?? false
     );
+    if (stopPatternSet !== null) {
+      NativeModInstaller.unregisterStopPatterns(stopPatternSet);
+    }
 
     // Assertions
     expect(result).toBeTruthy();
@@ -203,18 +247,379 @@ async function runTestCase(testCase: TestCase): Promise<void> {
     }
     expect(instructionsMatch).toBe(true);
 
+    if (options.headless) {
+      expect(dialogs).toBe(0);
+      expect(result!.decisions).toBeTruthy();
+    } else {
+      expect(result!.decisions).toBeUndefined();
+    }
+
     if (isDebug) {
       expect(allocAliveCount()).toBe(0);
     }
 
+    return { decisions: result!.decisions, steps };
   } finally {
     await archive.close();
   }
 }
 
-// Generate tests from shared JSON data (supports both .zip and .7z)
-for (const testCase of getAllTestCases()) {
-  test(`${testCase.game}: ${testCase.name}`, async () => {
+// Record the case and check the replay reproduces it without the JS callbacks
+async function runReplay(testCase: TestCase): Promise<void> {
+  const recording = path.join(os.tmpdir(), `fomod-replay-${process.pid}-${testCase.game}-${testCase.name}`.replace(/[^\w.-]+/g, '_') + '.fmrl');
+  startRecording(recording);
+  try {
     await runTestCase(testCase);
+  } finally {
+    stopRecording();
+  }
+
+  try {
+    const result = await replayInstall(recording);
+    expect(result).toBeTruthy();
+    expect(compareInstructions(result!.instructions, testCase.expectedInstructions)).toBe(true);
+    expect(getReplayStats().missed).toBe(0);
+  } finally {
+    fs.rmSync(recording, { force: true });
+  }
+}
+
+// Every case of the shared JSON data (.zip and .7z) once per way of passing the input and reading the result
+const variants: Array<[string | null, (testCase: TestCase) => Promise<unknown>]> = [
+  [null, testCase => runTestCase(testCase)],
+  ['registered stop patterns', testCase => runTestCase(testCase, { registerStopPatterns: true })],
+  ['compact', testCase => runTestCase(testCase, { compact: true })],
+  ['lazy', testCase => runTestCase(testCase, { lazy: true })],
+  // Cases installed one after another by a single installer rebound with reset()
+  ['reused installer', testCase => runTestCase(testCase, { reuse: true })],
+  ['replay', runReplay],
+];
+for (const testCase of getAllTestCases()) {
+  for (const [variant, run] of variants) {
+    test(`${testCase.game}: ${testCase.name}${variant === null ? '' : ` (${variant})`}`, async () => {
+      await run(testCase);
+    });
+  }
+}
+
+// Headless runs must pick what the dialog ends up with when it is continued without changes:
+// the defaults without a preset, the preset otherwise, whether or not it is only used to preselect.
+// The reference run shows the dialog, so a preset is only preselected there.
+const expectSameChoices = (decisions: types.InstallDecision[], steps: types.IInstallStep[], fromPreset: boolean) => {
+  const visible = steps.filter(step => step.visible);
+  expect(decisions).toHaveLength(visible.reduce((count, step) => count + (step.optionalFileGroups?.group.length ?? 0), 0));
+  for (const decision of decisions) {
+    const step = visible.find(step => step.name === decision.step);
+    const group = step?.optionalFileGroups?.group.find(group => group.name === decision.group);
+    expect(group, `${decision.step} / ${decision.group}`).toBeDefined();
+    expect(decision.selected).toEqual(group!.options.filter(option => option.selected).map(option => option.name));
+    if (!fromPreset) {
+      expect(decision.fromPreset).toBe(false);
+    }
+  }
+};
+
+const headlessCases = getAllTestCases()
+  .filter(testCase => testCase.dialogChoices === undefined)
+  .flatMap(testCase => testCase.preset === undefined
+    ? [{ testCase, variant: 'headless, no preset' }]
+    : [{ testCase: { ...testCase, preselect: false }, variant: 'headless' }, { testCase: { ...testCase, preselect: true }, variant: 'headless, preselect' }]);
+for (const { testCase, variant } of headlessCases) {
+  test(`${testCase.game}: ${testCase.name} (${variant})`, async () => {
+    const { steps } = await runTestCase({ ...testCase, preselect: testCase.preset !== undefined });
+    const { decisions } = await runTestCase(testCase, { headless: true });
+    expectSameChoices(decisions!, steps, testCase.preset !== undefined);
   });
 }
+
+// A responsive event loop answers every callback before its deadline
+test('watchdog: no stalls while the event loop is free', async () => {
+  const defaults = configureWatchdog();
+  expect(() => configureWatchdog({ fileSystem: -1 })).toThrow(RangeError);
+  expect(configureWatchdog()).toEqual(defaults);
+
+  resetStallStats();
+  try {
+    configureWatchdog({ fileSystem: 5000, context: 5000, ui: 5000 });
+    for (const testCase of getAllTestCases().slice(0, 3)) {
+      await runTestCase(testCase);
+    }
+    const stats = getStallStats();
+    expect(stats.stalls).toEqual({ fileSystem: 0, context: 0, ui: 0, logging: 0 });
+    expect(stats.recent).toHaveLength(0);
+  } finally {
+    configureWatchdog(defaults);
+  }
+});
+
+// File system over an archive built by the test; paths are backslash-separated like the install file list
+const createMemoryFileSystem = (files: Map<string, Uint8Array>, directories: string[], onRead?: (filePath: string) => void): NativeFileSystem => {
+  const contents = new Map(Array.from(files, ([file, content]) => [file.replace(/\\/g, '/').toLowerCase(), content]));
+  const under = (directoryPath: string) => directoryPath === '' ? '' : directoryPath.toLowerCase() + '\\';
+  return new NativeFileSystem(
+    (filePath: string, offset: number, length: number): Uint8Array | null => {
+      onRead?.(filePath);
+      const content = contents.get(filePath.replace(/\\/g, '/').toLowerCase());
+      if (!content) return null;
+      return content.slice(offset, length === -1 ? content.length : offset + length);
+    },
+    (directoryPath: string, _pattern: string, _searchType: number): string[] | null =>
+      Array.from(files.keys()).filter(file => file.toLowerCase().startsWith(under(directoryPath))),
+    (directoryPath: string): string[] | null =>
+      directories.filter(dir => dir.toLowerCase().startsWith(under(directoryPath)) && !dir.slice(under(directoryPath).length).includes('\\'))
+  );
+};
+
+const createInstaller = (): NativeModInstaller => {
+  const callbacks = createDeterministicUICallbacks();
+  return new NativeModInstaller(
+    callbacks.pluginsGetAll,
+    callbacks.contextGetAppVersion,
+    callbacks.contextGetCurrentGameVersion,
+    callbacks.contextGetExtenderVersion,
+    callbacks.uiStartDialog,
+    callbacks.uiEndDialog,
+    callbacks.uiUpdateState
+  );
+};
+
+const waitFor = async (condition: () => boolean): Promise<void> => {
+  const deadline = Date.now() + 10_000;
+  while (!condition()) {
+    if (Date.now() > deadline) {
+      throw new Error('Timed out waiting for the condition');
+    }
+    await new Promise(resolve => setTimeout(resolve, 10));
+  }
+};
+
+// The snapshot index is built from the file listing, which has no entries for empty folders.
+// Directory listings of such a folder have to reach the callback instead of being answered as missing.
+test('file system: empty folder in the archive', async () => {
+  const moduleConfig = `<?xml version="1.0" encoding="utf-8"?>
+<config xmlns:xsi="http://www.w3.org/2001/XMLSchema-instance" xsi:noNamespaceSchemaLocation="http://qconsulting.ca/fo3/ModConfig5.0.xsd">
+  <moduleName>Empty Folder</moduleName>
+  <requiredInstallFiles>
+    <folder source="Data" destination="" />
+  </requiredInstallFiles>
+</config>`;
+  const files = new Map<string, Uint8Array>([
+    ['fomod\\ModuleConfig.xml', new TextEncoder().encode(moduleConfig)],
+    ['Data\\plugin.esp', new Uint8Array([0])],
+  ]);
+  createMemoryFileSystem(files, ['fomod', 'Data', 'Data\\Empty']).setCallbacks();
+
+  const result = await createInstaller().install([...files.keys(), 'Data\\Empty\\'], [], '', '', null, false, true, false);
+
+  expect(result).toBeTruthy();
+  expect(result!.instructions.map(normalizeInstruction)).toContain(normalizeInstruction({ type: 'copy', source: 'Data\\plugin.esp', destination: 'plugin.esp' }));
+
+  if (isDebug) {
+    expect(allocAliveCount()).toBe(0);
+  }
+});
+
+// The image prefetch reads from a thread pool thread, so its callback waits under the file system deadline
+test('watchdog: a callback blocking past its deadline', async () => {
+  const moduleConfig = `<?xml version="1.0" encoding="utf-8"?>
+<config xmlns:xsi="http://www.w3.org/2001/XMLSchema-instance" xsi:noNamespaceSchemaLocation="http://qconsulting.ca/fo3/ModConfig5.0.xsd">
+  <moduleName>Blocking Image</moduleName>
+  <installSteps order="Explicit">
+    <installStep name="Step">
+      <optionalFileGroups order="Explicit">
+        <group name="Group" type="SelectAny">
+          <plugins order="Explicit">
+            <plugin name="Option">
+              <description>Option</description>
+              <image path="fomod\\images\\option.png" />
+              <files>
+                <file source="Data\\plugin.esp" destination="plugin.esp" />
+              </files>
+              <typeDescriptor>
+                <type name="Recommended" />
+              </typeDescriptor>
+            </plugin>
+          </plugins>
+        </group>
+      </optionalFileGroups>
+    </installStep>
+  </installSteps>
+</config>`;
+  const files = new Map<string, Uint8Array>([
+    ['fomod\\ModuleConfig.xml', new TextEncoder().encode(moduleConfig)],
+    ['fomod\\images\\option.png', new Uint8Array([1, 2, 3])],
+    ['Data\\plugin.esp', new Uint8Array([0])],
+  ]);
+  let blocked = false;
+  createMemoryFileSystem(files, ['fomod', 'fomod\\images', 'Data'], filePath => {
+    // Hold the JS thread well past the deadline, once
+    if (!blocked && filePath.toLowerCase().endsWith('option.png')) {
+      blocked = true;
+      const until = Date.now() + 1000;
+      while (Date.now() < until) {
+        // busy wait
+      }
+    }
+  }).setCallbacks();
+
+  const defaults = configureWatchdog();
+  expect(defaults).toEqual({ fileSystem: 30000, context: 30000, ui: 0, logging: 30000 });
+  resetStallStats();
+  setImagePrefetchCapacity(1024 * 1024);
+  try {
+    configureWatchdog({ fileSystem: 300 });
+    const installer = createInstaller();
+    const result = await installer.install([...files.keys()], [], '', '', null, false, false, false);
+    expect(result!.instructions.map(normalizeInstruction)).toContain(normalizeInstruction({ type: 'copy', source: 'Data\\plugin.esp', destination: 'plugin.esp' }));
+
+    // The blocked callback finishes after its caller gave up
+    await waitFor(() => getStallStats().late > 0);
+    const stats = getStallStats();
+    expect(stats.late).toBe(1);
+    expect(stats.stalls).toEqual({ fileSystem: 1, context: 0, ui: 0, logging: 0 });
+    expect(stats.recent).toHaveLength(1);
+    expect(stats.recent[0]).toMatchObject({ callback: 'readFileContent', category: 'fileSystem', state: 'running' });
+    expect(stats.recent[0].waitedMs).toBeGreaterThanOrEqual(300);
+    expect(stats.recent[0].waitedMs).toBeLessThan(1000);
+    expect(stats.recent[0].sinceLastCallbackMs).not.toBeNull();
+
+    // The prefetch got the error instead of the image
+    await waitFor(() => installer.imagePrefetchStats().pending === 0);
+    expect(installer.imagePrefetchStats().failures).toBe(1);
+    expect(installer.getImage('fomod\\images\\option.png')).toBeNull();
+  } finally {
+    configureWatchdog(defaults);
+    setImagePrefetchCapacity(0);
+  }
+});
+
+// One step with one option, the dialog stays open until it is continued
+const oneStepModuleConfig = `<?xml version="1.0" encoding="utf-8"?>
+<config xmlns:xsi="http://www.w3.org/2001/XMLSchema-instance" xsi:noNamespaceSchemaLocation="http://qconsulting.ca/fo3/ModConfig5.0.xsd">
+  <moduleName>One Step</moduleName>
+  <installSteps order="Explicit">
+    <installStep name="Step">
+      <optionalFileGroups order="Explicit">
+        <group name="Group" type="SelectAny">
+          <plugins order="Explicit">
+            <plugin name="Option">
+              <description>Option</description>
+              <files>
+                <file source="Data\\plugin.esp" destination="plugin.esp" />
+              </files>
+              <typeDescriptor>
+                <type name="Recommended" />
+              </typeDescriptor>
+            </plugin>
+          </plugins>
+        </group>
+      </optionalFileGroups>
+    </installStep>
+  </installSteps>
+</config>`;
+const oneStepArchive = new Map<string, Uint8Array>([
+  ['fomod\\ModuleConfig.xml', new TextEncoder().encode(oneStepModuleConfig)],
+  ['Data\\plugin.esp', new Uint8Array([0])],
+]);
+
+// Dropping the last reference to a ModInstaller while its dialog waits must not free the handler the install still calls into
+test('handler: ModInstaller collected during an install', async () => {
+  const gc = globalThis.gc;
+  expect(gc, 'needs --expose-gc').toBeTypeOf('function');
+
+  createMemoryFileSystem(oneStepArchive, ['fomod', 'Data']).setCallbacks();
+
+  // The dialog holds on to its continue callback and waits, like a user would
+  let cont = null as types.ContinueCallback | null;
+  let currentStep = -1;
+  let collected = false;
+  const registry = new FinalizationRegistry(() => {
+    collected = true;
+  });
+  const install = (() => {
+    const installer = new NativeModInstaller(
+      () => [],
+      () => '1.0.0',
+      () => '1.0.0',
+      () => '1.0.0',
+      (_moduleName, _image, _select, continueCallback) => {
+        cont = continueCallback;
+      },
+      () => {},
+      (_installSteps, step) => {
+        currentStep = step;
+      }
+    );
+    registry.register(installer['manager'], 'manager');
+    return installer.install([...oneStepArchive.keys()], [], '', '', null, false, false, false);
+  })();
+
+  await waitFor(() => cont !== null && currentStep >= 0);
+  await waitFor(() => {
+    gc!();
+    return collected;
+  });
+  // Let the native finalizer run
+  await new Promise(resolve => setImmediate(resolve));
+
+  cont!(true, currentStep);
+  const result = await install;
+  expect(result!.instructions.map(normalizeInstruction)).toContain(normalizeInstruction({ type: 'copy', source: 'Data\\plugin.esp', destination: 'plugin.esp' }));
+
+  // The handler went back to the pool once the install ended, the next ModInstaller can take it
+  const next = await createInstaller().install([...oneStepArchive.keys()], [], '', '', null, false, false, false);
+  expect(next!.instructions.map(normalizeInstruction)).toEqual(result!.instructions.map(normalizeInstruction));
+
+  if (isDebug) {
+    expect(allocAliveCount()).toBe(0);
+  }
+});
+
+// The earlier tests started the runtime, so its GC settings are fixed by now
+test('runtime: settings in effect', () => {
+  const settings = configureRuntime();
+  expect(settings.minThreads).toBeGreaterThan(0);
+  expect(settings.maxThreads).toBeGreaterThanOrEqual(settings.minThreads);
+  try {
+    expect(configureRuntime({ minThreads: settings.minThreads + 1 }).minThreads).toBe(settings.minThreads + 1);
+
+    // Asking for the GC settings in effect is fine, anything else is rejected and changes nothing
+    expect(configureRuntime({ gcServer: settings.gcServer, gcConserveMemory: settings.gcConserveMemory })).toMatchObject({ gcServer: settings.gcServer, gcConserveMemory: settings.gcConserveMemory });
+    expect(() => configureRuntime({ minThreads: settings.minThreads, gcConserveMemory: (settings.gcConserveMemory + 1) % 10 })).toThrow(/gcConserveMemory/);
+    expect(() => configureRuntime({ gcServer: !settings.gcServer })).toThrow(/gcServer/);
+    expect(configureRuntime()).toMatchObject({ minThreads: settings.minThreads + 1, gcServer: settings.gcServer, gcConserveMemory: settings.gcConserveMemory });
+  } finally {
+    configureRuntime({ minThreads: settings.minThreads });
+  }
+});
+
+// The dialog functions stay with the host after the dialog ends, a late click must not reach the next install
+test('handler: continue after the dialog ended', async () => {
+  createMemoryFileSystem(oneStepArchive, ['fomod', 'Data']).setCallbacks();
+
+  let cont = null as types.ContinueCallback | null;
+  const callbacks = createDeterministicUICallbacks();
+  const handlerCallbacks: ConstructorParameters<typeof NativeModInstaller> = [
+    callbacks.pluginsGetAll,
+    callbacks.contextGetAppVersion,
+    callbacks.contextGetCurrentGameVersion,
+    callbacks.contextGetExtenderVersion,
+    (...args: Parameters<typeof callbacks.uiStartDialog>) => {
+      cont = args[3];
+      callbacks.uiStartDialog(...args);
+    },
+    callbacks.uiEndDialog,
+    callbacks.uiUpdateState
+  ];
+  const installer = new NativeModInstaller(...handlerCallbacks);
+  const first = await installer.install([...oneStepArchive.keys()], [], '', '', null, false, false, false);
+  expect(cont).not.toBeNull();
+
+  const stale = cont!;
+  expect(() => stale(true, 0)).not.toThrow();
+
+  installer.reset(...handlerCallbacks);
+  const second = await installer.install([...oneStepArchive.keys()], [], '', '', null, false, false, false);
+  expect(second!.instructions.map(normalizeInstruction)).toEqual(first!.instructions.map(normalizeInstruction));
+  expect(() => stale(true, 0)).not.toThrow();
+});
@@ -0,0 +1,352 @@
+/**
+ * Synthetic FOMOD generator for scaling tests.
+ * Emits a ModuleConfig.xml valid against XmlScript1.0-5.0.xsd together with the matching
+ * archive listing, with every size knob exposed so install time and memory can be charted
+ * against script and archive size.
+ */
+
+export type XmlScriptVersion = '1.0' | '2.0' | '3.0' | '4.0' | '5.0';
+
+export const XML_SCRIPT_VERSIONS: XmlScriptVersion[] = ['1.0', '2.0', '3.0', '4.0', '5.0'];
+
+export interface SyntheticFomodOptions {
+  /** Install steps; versions before 4.0 have no steps and flatten them into one group list */
+  steps: number;
+  groupsPerStep: number;
+  pluginsPerGroup: number;
+  filesPerPlugin: number;
+  /** Required files installed unconditionally */
+  requiredFiles: number;
+  /** Nesting depth of every generated CompositeCondition */
+  conditionDepth: number;
+  /** Leaf conditions per CompositeCondition level */
+  conditionBreadth: number;
+  /** Every n-th plugin gets a dependency type descriptor instead of a static type, 0 disables */
+  conditionalPluginEvery: number;
+  /** conditionalFileInstalls patterns (2.0+) */
+  conditionalPatterns: number;
+  /** Total archive entries; unreferenced filler files are added up to this count */
+  archiveFiles: number;
+}
+
+export const SYNTHETIC_PRESETS: { [name: string]: SyntheticFomodOptions } = {
+  small: {
+    steps: 3,
+    groupsPerStep: 2,
+    pluginsPerGroup: 4,
+    filesPerPlugin: 2,
+    requiredFiles: 5,
+    conditionDepth: 2,
+    conditionBreadth: 2,
+    conditionalPluginEvery: 3,
+    conditionalPatterns: 4,
+    archiveFiles: 200,
+  },
+  medium: {
+    steps: 15,
+    groupsPerStep: 3,
+    pluginsPerGroup: 8,
+    filesPerPlugin: 4,
+    requiredFiles: 50,
+    conditionDepth: 4,
+    conditionBreadth: 3,
+    conditionalPluginEvery: 3,
+    conditionalPatterns: 50,
+    archiveFiles: 10_000,
+  },
+  // Matches the worst installers seen in production
+  large: {
+    steps: 50,
+    groupsPerStep: 4,
+    pluginsPerGroup: 6,
+    filesPerPlugin: 5,
+    requiredFiles: 200,
+    conditionDepth: 6,
+    conditionBreadth: 4,
+    conditionalPluginEvery: 2,
+    conditionalPatterns: 200,
+    archiveFiles: 100_000,
+  },
+};
+
+export interface SyntheticFomod {
+  version: XmlScriptVersion;
+  options: SyntheticFomodOptions;
+  moduleConfig: string;
+  /** Archive listing with directories ending in '/', as produced by preloadArchive */
+  files: string[];
+  /** Content of the files the installer reads, keyed by lowercase forward slash path */
+  fileCache: Map<string, Uint8Array>;
+}
+
+/**
+ * Scales the size knobs of a preset. Condition shape is kept, only counts grow.
+ */
+export function scaleSyntheticOptions(options: SyntheticFomodOptions, factor: number): SyntheticFomodOptions {
+  const scale = (value: number) => Math.max(1, Math.round(value * factor));
+  return {
+    ...options,
+    steps: scale(options.steps),
+    requiredFiles: scale(options.requiredFiles),
+    conditionalPatterns: scale(options.conditionalPatterns),
+    archiveFiles: scale(options.archiveFiles),
+  };
+}
+
+const MODULE_CONFIG_PATH = 'fomod/ModuleConfig.xml';
+const GROUP_TYPES = ['SelectAny', 'SelectExactlyOne', 'SelectAtMostOne', 'SelectAtLeastOne'];
+
+/**
+ * Element names differ between the 1.0 schema ("dependancy") and later ones.
+ */
+interface Dialect {
+  version: XmlScriptVersion;
+  hasFlags: boolean;
+  hasSteps: boolean;
+  hasConditionalInstalls: boolean;
+  hasOrder: boolean;
+  hasGameDependency: boolean;
+  fileCondition: string;
+  composite: string;
+  dependencyType: string;
+}
+
+const dialectFor = (version: XmlScriptVersion): Dialect => {
+  const major = parseInt(version, 10);
+  return {
+    version,
+    hasFlags: major >= 2,
+    hasSteps: major >= 4,
+    hasConditionalInstalls: major >= 2,
+    hasOrder: major >= 3,
+    hasGameDependency: major >= 5,
+    fileCondition: major === 1 ? 'dependancy' : 'fileDependency',
+    composite: major === 1 ? 'dependancies' : 'dependencies',
+    dependencyType: major === 1 ? 'dependancyType' : 'dependencyType',
+  };
+};
+
+class XmlWriter {
+  private readonly parts: string[] = [];
+  private indent = 0;
+
+  public open(name: string, attributes: { [key: string]: string | number } = {}): void {
+    this.parts.push(`${'\t'.repeat(this.indent)}<${name}${this.formatAttributes(attributes)}>\n`);
+    this.indent++;
+  }
+
+  public close(name: string): void {
+    this.indent--;
+    this.parts.push(`${'\t'.repeat(this.indent)}</${name}>\n`);
+  }
+
+  public empty(name: string, attributes: { [key: string]: string | number } = {}): void {
+    this.parts.push(`${'\t'.repeat(this.indent)}<${name}${this.formatAttributes(attributes)} />\n`);
+  }
+
+  public text(name: string, value: string, attributes: { [key: string]: string | number } = {}): void {
+    this.parts.push(`${'\t'.repeat(this.indent)}<${name}${this.formatAttributes(attributes)}>${value}</${name}>\n`);
+  }
+
+  public raw(value: string): void {
+    this.parts.push(value);
+  }
+
+  public toString(): string {
+    return this.parts.join('');
+  }
+
+  private formatAttributes(attributes: { [key: string]: string | number }): string {
+    return Object.entries(attributes).map(([key, value]) => ` ${key}="${value}"`).join('');
+  }
+}
+
+class SyntheticFomodBuilder {
+  private readonly xml = new XmlWriter();
+  private readonly referenced: string[] = [];
+  private readonly dialect: Dialect;
+  private pluginCounter = 0;
+
+  public constructor(private readonly version: XmlScriptVersion, private readonly options: SyntheticFomodOptions) {
+    this.dialect = dialectFor(version);
+  }
+
+  public build(): SyntheticFomod {
+    const { options, dialect, xml } = this;
+
+    xml.raw('<?xml version="1.0" encoding="utf-8"?>\n');
+    xml.open('config', {
+      'xmlns:xsi': 'http://www.w3.org/2001/XMLSchema-instance',
+      'xsi:noNamespaceSchemaLocation': `http://qconsulting.ca/fo3/ModConfig${this.version}.xsd`,
+    });
+    xml.text('moduleName', `Synthetic ${this.version}`);
+
+    if (options.requiredFiles > 0) {
+      xml.open('requiredInstallFiles');
+      for (let i = 0; i < options.requiredFiles; i++) {
+        this.file(`required/file${i}.esp`, `file${i}.esp`);
+      }
+      xml.close('requiredInstallFiles');
+    }
+
+    if (dialect.hasSteps) {
+      xml.open('installSteps', { order: 'Explicit' });
+      for (let step = 0; step < options.steps; step++) {
+        xml.open('installStep', { name: `Step ${step}` });
+        // The first step is always visible so an unattended install has something to show
+        if (step > 0 && options.conditionDepth > 0) {
+          this.composite('visible', options.conditionDepth, step);
+        }
+        this.groupList(step, options.groupsPerStep);
+        xml.close('installStep');
+      }
+      xml.close('installSteps');
+    } else {
+      this.groupList(0, options.steps * options.groupsPerStep);
+    }
+
+    if (dialect.hasConditionalInstalls && options.conditionalPatterns > 0) {
+      xml.open('conditionalFileInstalls');
+      xml.open('patterns');
+      for (let i = 0; i < options.conditionalPatterns; i++) {
+        xml.open('pattern');
+        this.composite(dialect.composite, options.conditionDepth, i);
+        xml.open('files');
+        this.file(`conditional/pattern${i}/file.esp`, `conditional${i}.esp`);
+        xml.close('files');
+        xml.close('pattern');
+      }
+      xml.close('patterns');
+      xml.close('conditionalFileInstalls');
+    }
+
+    xml.close('config');
+
+    const moduleConfig = xml.toString();
+    const files = this.listing();
+    const fileCache = new Map<string, Uint8Array>();
+    fileCache.set(MODULE_CONFIG_PATH.toLowerCase(), Buffer.from(moduleConfig, 'utf8'));
+
+    return { version: this.version, options, moduleConfig, files, fileCache };
+  }
+
+  private groupList(step: number, groupCount: number): void {
+    const { xml } = this;
+    const order = this.dialect.hasOrder ? { order: 'Explicit' } : {};
+    xml.open('optionalFileGroups', order);
+    for (let group = 0; group < groupCount; group++) {
+      xml.open('group', { name: `Group ${step}.${group}`, type: GROUP_TYPES[group % GROUP_TYPES.length] });
+      xml.open('plugins', order);
+      for (let plugin = 0; plugin < this.options.pluginsPerGroup; plugin++) {
+        this.plugin(step, group, plugin);
+      }
+      xml.close('plugins');
+      xml.close('group');
+    }
+    xml.close('optionalFileGroups');
+  }
+
+  private plugin(step: number, group: number, plugin: number): void {
+    const { xml, dialect, options } = this;
+    const index = this.pluginCounter++;
+    const folder = `options/step${step}/group${group}/plugin${plugin}`;
+
+    xml.open('plugin', { name: `Plugin ${step}.${group}.${plugin}` });
+    xml.text('description', `Synthetic option ${index}`);
+    xml.empty('image', { path: `fomod/images/plugin${index % 16}.png` });
+    xml.open('files');
+    for (let f = 0; f < options.filesPerPlugin; f++) {
+      this.file(`${folder}/file${f}.esp`, `plugin${index}_${f}.esp`);
+    }
+    xml.close('files');
+    if (dialect.hasFlags) {
+      xml.open('conditionFlags');
+      xml.text('flag', `on`, { name: `flag_${step}_${group}_${plugin}` });
+      xml.close('conditionFlags');
+    }
+
+    xml.open('typeDescriptor');
+    // Keep the first plugin of each group static so SelectExactlyOne always has a default
+    if (options.conditionalPluginEvery > 0 && plugin > 0 && index % options.conditionalPluginEvery === 0) {
+      xml.open(dialect.dependencyType);
+      xml.empty('defaultType', { name: 'Optional' });
+      xml.open('patterns');
+      xml.open('pattern');
+      this.composite(dialect.composite, options.conditionDepth, index);
+      xml.empty('type', { name: 'Recommended' });
+      xml.close('pattern');
+      xml.close('patterns');
+      xml.close(dialect.dependencyType);
+    } else {
+      xml.empty('type', { name: plugin === 0 ? 'Recommended' : 'Optional' });
+    }
+    xml.close('typeDescriptor');
+    xml.close('plugin');
+  }
+
+  /**
+   * Writes a composite condition with conditionBreadth leaves per level and one nested
+   * composite per level down to depth, alternating And/Or.
+   */
+  private composite(element: string, depth: number, seed: number): void {
+    const { xml, dialect, options } = this;
+    xml.open(element, { operator: depth % 2 === 0 ? 'And' : 'Or' });
+    for (let leaf = 0; leaf < Math.max(1, options.conditionBreadth); leaf++) {
+      const n = seed * 31 + depth * 7 + leaf;
+      if (dialect.hasFlags && leaf % 2 === 1) {
+        xml.empty('flagDependency', {
+          flag: `flag_${n % Math.max(1, options.steps)}_${n % Math.max(1, options.groupsPerStep)}_${n % Math.max(1, options.pluginsPerGroup)}`,
+          value: n % 3 === 0 ? '' : 'on',
+        });
+      } else {
+        xml.empty(dialect.fileCondition, { file: `Synthetic${n % 64}.esp`, state: n % 2 === 0 ? 'Missing' : 'Active' });
+      }
+    }
+    if (dialect.hasGameDependency) {
+      // Resolved through the contextGetCurrentGameVersion callback
+      xml.empty('gameDependency', { version: '1.0' });
+    }
+    if (depth > 1) {
+      this.composite(dialect.composite, depth - 1, seed + 1);
+    }
+    xml.close(element);
+  }
+
+  private file(source: string, destination: string): void {
+    this.xml.empty('file', { source, destination, priority: 0 });
+    this.referenced.push(source);
+  }
+
+  private listing(): string[] {
+    const files = new Set<string>([MODULE_CONFIG_PATH]);
+    for (let i = 0; i < 16; i++) {
+      files.add(`fomod/images/plugin${i}.png`);
+    }
+    for (const file of this.referenced) {
+      files.add(file);
+    }
+    for (let i = 0; files.size < this.options.archiveFiles; i++) {
+      files.add(`filler/${Math.floor(i / 1000)}/texture${i}.dds`);
+    }
+
+    // Directory entries, as the archive readers report them
+    const directories = new Set<string>();
+    for (const file of files) {
+      const parts = file.split('/');
+      for (let i = 1; i < parts.length; i++) {
+        directories.add(parts.slice(0, i).join('/') + '/');
+      }
+    }
+
+    const listing = [...directories, ...files];
+    // The native library expects the platform separator, see preloadArchive
+    return process.platform === 'win32' ? listing.map(f => f.replace(/\//g, '\\')) : listing;
+  }
+}
+
+/**
+ * Generates a synthetic FOMOD for the given schema version.
+ */
+export function generateSyntheticFomod(version: XmlScriptVersion, options: SyntheticFomodOptions = SYNTHETIC_PRESETS.small): SyntheticFomod {
+  return new SyntheticFomodBuilder(version, options).build();
+}
@@ -5,5 +5,7 @@ export default defineConfig({
     include: ['test/**/*.spec.ts'],
     testTimeout: 60_000,
     forceExit: true,
+    // The handler spec collects a ModInstaller while its install runs
+    execArgv: ['--expose-gc'],
   },
 });
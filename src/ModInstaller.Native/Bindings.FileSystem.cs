@@ -39,7 +39,11 @@ public static unsafe partial class Bindings
     public static int SetFileSystemCallbacks(param_ptr* p_owner,
         delegate* unmanaged[Cdecl]<param_ptr*, param_string*, param_int, param_int, return_value_data*> p_read_file_content,
         delegate* unmanaged[Cdecl]<param_ptr*, param_string*, param_string*, param_int, return_value_json*> p_read_directory_file_list,
-        delegate* unmanaged[Cdecl]<param_ptr*, param_string*, return_value_json*> p_read_directory_list
+        delegate* unmanaged[Cdecl]<param_ptr*, param_string*, return_value_json*> p_read_directory_list,
+        delegate* unmanaged[Cdecl]<param_ptr*, param_string*, return_value_json*> p_stat,
+        delegate* unmanaged[Cdecl]<param_ptr*, param_string*, return_value_json*> p_open_file,
+        delegate* unmanaged[Cdecl]<param_ptr*, param_int, param_int, param_int, return_value_data*> p_read_file,
+        delegate* unmanaged[Cdecl]<param_ptr*, param_int, return_value_void*> p_close_file
     )
     {
 #if DEBUG
@@ -53,7 +57,13 @@ public static unsafe partial class Bindings
             var fileSystemDelegate = new CallbackFileSystem(p_owner,
                 Marshal.GetDelegateForFunctionPointer<N_ReadFileContentDelegate>(new IntPtr(p_read_file_content)),
                 Marshal.GetDelegateForFunctionPointer<N_ReadDirectoryFileList>(new IntPtr(p_read_directory_file_list)),
-                Marshal.GetDelegateForFunctionPointer<N_ReadDirectoryList>(new IntPtr(p_read_directory_list))
+                Marshal.GetDelegateForFunctionPointer<N_ReadDirectoryList>(new IntPtr(p_read_directory_list)),
+                // Optional, hosts without it are asked through ReadFileContent and ReadDirectoryList
+                p_stat == null ? null : Marshal.GetDelegateForFunctionPointer<N_Stat>(new IntPtr(p_stat)),
+                // Optional as a set, without them files are streamed with path based reads
+                p_open_file == null ? null : Marshal.GetDelegateForFunctionPointer<N_OpenFile>(new IntPtr(p_open_file)),
+                p_read_file == null ? null : Marshal.GetDelegateForFunctionPointer<N_ReadFile>(new IntPtr(p_read_file)),
+                p_close_file == null ? null : Marshal.GetDelegateForFunctionPointer<N_CloseFile>(new IntPtr(p_close_file))
             );
 
             FileSystem.Instance = fileSystemDelegate;
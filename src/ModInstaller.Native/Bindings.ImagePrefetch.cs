@@ -0,0 +1,93 @@
+﻿using BUTR.NativeAOT.Shared;
+
+using FomodInstaller.Scripting;
+
+using ModInstaller.Native.Adapters;
+
+using System;
+using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+
+namespace ModInstaller.Native;
+
+public static unsafe partial class Bindings
+{
+    [UnmanagedCallersOnly(EntryPoint = "set_image_prefetch_capacity", CallConvs = [typeof(CallConvCdecl)])]
+    public static return_value_void* SetImagePrefetchCapacity(param_int capacity)
+    {
+#if DEBUG
+        using var logger = LogMethod(&capacity);
+#else
+        using var logger = LogMethod();
+#endif
+        
+        try
+        {
+            ImagePrefetcher.DefaultCapacity = capacity;
+
+            return return_value_void.AsValue(false);
+        }
+        catch (Exception e)
+        {
+            logger.LogException(e);
+            return return_value_void.AsException(e, false);
+        }
+    }
+
+    [UnmanagedCallersOnly(EntryPoint = "get_image", CallConvs = [typeof(CallConvCdecl)]), IsNotConst<IsPtrConst>]
+    public static return_value_data* GetImage(param_ptr* p_handle, [IsConst<IsPtrConst>] param_string* p_path)
+    {
+#if DEBUG
+        using var logger = LogMethod(p_path);
+#else
+        using var logger = LogMethod();
+#endif
+        
+        try
+        {
+            if (p_handle is null || NativeCoreDelegatesHandler.FromPointer(p_handle) is not { } handler)
+                return return_value_data.AsError(BUTR.NativeAOT.Shared.Utils.Copy("Handler is null or wrong!", false), false);
+
+            var path = new string(param_string.ToSpan(p_path));
+
+            // a miss is not an error, the image is just not there yet
+            var data = handler.imagePrefetcher.TryGet(path);
+            if (data is null)
+                return return_value_data.AsValue(null, 0, false);
+
+            var buffer = (byte*) Allocator.Alloc((nuint) data.Length);
+            data.AsSpan().CopyTo(new Span<byte>(buffer, data.Length));
+            return return_value_data.AsValue(buffer, data.Length, false);
+        }
+        catch (Exception e)
+        {
+            logger.LogException(e);
+            return return_value_data.AsException(e, false);
+        }
+    }
+
+    [UnmanagedCallersOnly(EntryPoint = "image_prefetch_stats", CallConvs = [typeof(CallConvCdecl)]), IsNotConst<IsPtrConst>]
+    public static return_value_json* GetImagePrefetchStats(param_ptr* p_handle)
+    {
+#if DEBUG
+        using var logger = LogMethod();
+#else
+        using var logger = LogMethod();
+#endif
+        
+        try
+        {
+            if (p_handle is null || NativeCoreDelegatesHandler.FromPointer(p_handle) is not { } handler)
+                return return_value_json.AsError(BUTR.NativeAOT.Shared.Utils.Copy("Handler is null or wrong!", false), false);
+
+            var result = handler.imagePrefetcher.GetStats();
+
+            return return_value_json.AsValue(result, CustomSourceGenerationContext.ImagePrefetchStats, false);
+        }
+        catch (Exception e)
+        {
+            logger.LogException(e);
+            return return_value_json.AsException(e, false);
+        }
+    }
+}
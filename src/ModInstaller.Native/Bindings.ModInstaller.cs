@@ -9,6 +9,7 @@ using System;
 using System.Linq;
 using System.Runtime.CompilerServices;
 using System.Runtime.InteropServices;
+using System.Threading.Tasks;
 
 namespace ModInstaller.Native;
 
@@ -129,6 +130,114 @@ public static unsafe partial class Bindings
         }
     }
 
+    [UnmanagedCallersOnly(EntryPoint = "test_supported_async", CallConvs = [typeof(CallConvCdecl)]), IsNotConst<IsPtrConst>]
+    public static return_value_async* TestSupportedAsync(
+        [IsConst<IsPtrConst>] param_json* p_mod_archive_file_list,
+        [IsConst<IsPtrConst>] param_json* p_allowed_types,
+        param_ptr* p_callback_handler,
+        delegate* unmanaged[Cdecl]<param_ptr*, return_value_json*, void> p_callback)
+    {
+#if DEBUG
+        using var logger = LogMethod(p_mod_archive_file_list, p_allowed_types);
+#else
+        using var logger = LogMethod();
+#endif
+        
+        try
+        {
+            // The parameters are owned by the caller and are only valid for the duration of this call,
+            // so they are deserialized here and only the scan itself is moved to the thread pool
+            var modArchiveFileList = BUTR.NativeAOT.Shared.Utils.DeserializeJson(p_mod_archive_file_list, CustomSourceGenerationContext.StringArray);
+            var allowedTypes = BUTR.NativeAOT.Shared.Utils.DeserializeJson(p_allowed_types, CustomSourceGenerationContext.StringArray);
+
+            Task.Run(() => Installer.TestSupported(modArchiveFileList.ToList(), allowedTypes.ToList())).ContinueWith(result =>
+            {
+#if DEBUG
+                using var logger = LogMethod($"{nameof(TestSupportedAsync)}_Callback");
+#else
+                using var logger = LogMethod($"{nameof(TestSupportedAsync)}_Callback");
+#endif
+                
+                try
+                {
+                    if (result.Exception is not null)
+                    {
+                        p_callback(p_callback_handler, return_value_json.AsException(result.Exception, false));
+                        logger.LogException(result.Exception);
+                    }
+                    else
+                    {
+                        p_callback(p_callback_handler, return_value_json.AsValue(result.Result, CustomSourceGenerationContext.SupportedResult, false));
+                    }
+                }
+                catch (Exception e)
+                {
+                    p_callback(p_callback_handler, return_value_json.AsException(e, false));
+                    logger.LogException(e);
+                }
+            });
+
+            return return_value_async.AsValue(false);
+        }
+        catch (Exception e)
+        {
+            logger.LogException(e);
+            return return_value_async.AsException(e, false);
+        }
+    }
+
+    [UnmanagedCallersOnly(EntryPoint = "test_supported_many", CallConvs = [typeof(CallConvCdecl)]), IsNotConst<IsPtrConst>]
+    public static return_value_async* TestSupportedMany(
+        [IsConst<IsPtrConst>] param_json* p_requests,
+        param_ptr* p_callback_handler,
+        delegate* unmanaged[Cdecl]<param_ptr*, return_value_json*, void> p_callback)
+    {
+#if DEBUG
+        using var logger = LogMethod(p_requests);
+#else
+        using var logger = LogMethod();
+#endif
+        
+        try
+        {
+            var requests = BUTR.NativeAOT.Shared.Utils.DeserializeJson(p_requests, CustomSourceGenerationContext.SupportedRequestArray);
+
+            Task.Run(() => Installer.TestSupportedMany(requests)).ContinueWith(result =>
+            {
+#if DEBUG
+                using var logger = LogMethod($"{nameof(TestSupportedMany)}_Callback");
+#else
+                using var logger = LogMethod($"{nameof(TestSupportedMany)}_Callback");
+#endif
+                
+                try
+                {
+                    if (result.Exception is not null)
+                    {
+                        p_callback(p_callback_handler, return_value_json.AsException(result.Exception, false));
+                        logger.LogException(result.Exception);
+                    }
+                    else
+                    {
+                        p_callback(p_callback_handler, return_value_json.AsValue(result.Result, CustomSourceGenerationContext.SupportedResultArray, false));
+                    }
+                }
+                catch (Exception e)
+                {
+                    p_callback(p_callback_handler, return_value_json.AsException(e, false));
+                    logger.LogException(e);
+                }
+            });
+
+            return return_value_async.AsValue(false);
+        }
+        catch (Exception e)
+        {
+            logger.LogException(e);
+            return return_value_async.AsException(e, false);
+        }
+    }
+
     [UnmanagedCallersOnly(EntryPoint = "install", CallConvs = [typeof(CallConvCdecl)]), IsNotConst<IsPtrConst>]
     public static return_value_async* Install(
         param_ptr* p_handle,
@@ -139,11 +248,12 @@ public static unsafe partial class Bindings
         [IsConst<IsPtrConst>] param_json* p_preset,
         [IsConst<IsPtrConst>] param_bool preselect,
         [IsConst<IsPtrConst>] param_bool validate,
+        [IsConst<IsPtrConst>] param_bool headless,
         param_ptr* p_callback_handler,
         delegate* unmanaged[Cdecl]<param_ptr*, return_value_json*, void> p_callback)
     {
 #if DEBUG
-        using var logger = LogMethod(p_mod_archive_file_list, p_stop_patterns, p_plugin_path, p_script_path, p_preset, &validate);
+        using var logger = LogMethod(p_mod_archive_file_list, p_stop_patterns, p_plugin_path, p_script_path, p_preset, &validate, &headless);
 #else
         using var logger = LogMethod();
 #endif
@@ -161,7 +271,7 @@ public static unsafe partial class Bindings
 
             var progressDelegate = new ProgressDelegate((progress) => { });
 
-            Installer.Install(modArchiveFileList.ToList(), stopPatterns.ToList(), pluginPath, scriptPath, preset, preselect, validate, progressDelegate, handler).ContinueWith(result =>
+            Installer.Install(modArchiveFileList.ToList(), stopPatterns.ToList(), pluginPath, scriptPath, preset, preselect, validate, progressDelegate, handler, headless).ContinueWith(result =>
             {
 #if DEBUG
                 using var logger = LogMethod($"{nameof(Install)}_Callback");
@@ -201,4 +311,80 @@ public static unsafe partial class Bindings
             return return_value_async.AsException(e, false);
         }
     }
+
+    // Same as install, with the result in the layout of InstallResultEncoder instead of JSON
+    [UnmanagedCallersOnly(EntryPoint = "install_compact", CallConvs = [typeof(CallConvCdecl)]), IsNotConst<IsPtrConst>]
+    public static return_value_async* InstallCompact(
+        param_ptr* p_handle,
+        [IsConst<IsPtrConst>] param_json* p_mod_archive_file_list,
+        [IsConst<IsPtrConst>] param_json* p_stop_patterns,
+        [IsConst<IsPtrConst>] param_string* p_plugin_path,
+        [IsConst<IsPtrConst>] param_string* p_script_path,
+        [IsConst<IsPtrConst>] param_json* p_preset,
+        [IsConst<IsPtrConst>] param_bool preselect,
+        [IsConst<IsPtrConst>] param_bool validate,
+        [IsConst<IsPtrConst>] param_bool headless,
+        param_ptr* p_callback_handler,
+        delegate* unmanaged[Cdecl]<param_ptr*, return_value_data*, void> p_callback)
+    {
+#if DEBUG
+        using var logger = LogMethod(p_mod_archive_file_list, p_stop_patterns, p_plugin_path, p_script_path, p_preset, &validate, &headless);
+#else
+        using var logger = LogMethod();
+#endif
+        
+        try
+        {
+            if (p_handle is null || NativeCoreDelegatesHandler.FromPointer(p_handle) is not { } handler)
+                return return_value_async.AsError(BUTR.NativeAOT.Shared.Utils.Copy("Handler is null or wrong!", false), false);
+
+            var modArchiveFileList = BUTR.NativeAOT.Shared.Utils.DeserializeJson(p_mod_archive_file_list, CustomSourceGenerationContext.StringArray);
+            var stopPatterns = BUTR.NativeAOT.Shared.Utils.DeserializeJson(p_stop_patterns, CustomSourceGenerationContext.StringArray);
+            var pluginPath = p_plugin_path is null ? null : new string(param_string.ToSpan(p_plugin_path));
+            var scriptPath = new string(param_string.ToSpan(p_script_path));
+            var preset = BUTR.NativeAOT.Shared.Utils.DeserializeJson(p_preset, CustomSourceGenerationContext.JsonDocument);
+
+            var progressDelegate = new ProgressDelegate((progress) => { });
+
+            Installer.Install(modArchiveFileList.ToList(), stopPatterns.ToList(), pluginPath, scriptPath, preset, preselect, validate, progressDelegate, handler, headless).ContinueWith(result =>
+            {
+#if DEBUG
+                using var logger = LogMethod($"{nameof(InstallCompact)}_Callback");
+#else
+                using var logger = LogMethod($"{nameof(InstallCompact)}_Callback");
+#endif
+                
+                try
+                {
+                    if (result.Exception is not null)
+                    {
+                        p_callback(p_callback_handler, return_value_data.AsException(result.Exception, false));
+                        logger.LogException(result.Exception);
+                    }
+                    else if (result.IsCanceled)
+                    {
+                        p_callback(p_callback_handler, return_value_data.AsValue(null, 0, false));
+                        logger.Log("Installation cancelled");
+                    }
+                    else
+                    {
+                        var data = InstallResultEncoder.Encode(result.Result, out var length);
+                        p_callback(p_callback_handler, return_value_data.AsValue(data, length, false));
+                    }
+                }
+                catch (Exception e)
+                {
+                    p_callback(p_callback_handler, return_value_data.AsException(e, false));
+                    logger.LogException(e);
+                }
+            });
+
+            return return_value_async.AsValue(false);
+        }
+        catch (Exception e)
+        {
+            logger.LogException(e);
+            return return_value_async.AsException(e, false);
+        }
+    }
 }
\ No newline at end of file
@@ -0,0 +1,201 @@
+﻿using BUTR.NativeAOT.Shared;
+
+using FomodInstaller.Interface;
+using FomodInstaller.Scripting;
+
+using ModInstaller.Lite;
+
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.Runtime;
+using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+using System.Text.Json;
+using System.Threading;
+using System.Threading.Tasks;
+
+namespace ModInstaller.Native;
+
+public static unsafe partial class Bindings
+{
+    [UnmanagedCallersOnly(EntryPoint = "warmup", CallConvs = [typeof(CallConvCdecl)]), IsNotConst<IsPtrConst>]
+    public static return_value_async* Warmup(
+        [IsConst<IsPtrConst>] param_json* p_options,
+        param_ptr* p_callback_handler,
+        delegate* unmanaged[Cdecl]<param_ptr*, return_value_json*, void> p_callback)
+    {
+#if DEBUG
+        using var logger = LogMethod(p_options);
+#else
+        using var logger = LogMethod();
+#endif
+        
+        try
+        {
+            var options = p_options is null
+                ? WarmupOptions.All
+                : BUTR.NativeAOT.Shared.Utils.DeserializeJson(p_options, CustomSourceGenerationContext.WarmupOptions) ?? WarmupOptions.All;
+
+            Task.Run(() => RunWarmup(options)).ContinueWith(result =>
+            {
+#if DEBUG
+                using var logger = LogMethod($"{nameof(Warmup)}_Callback");
+#else
+                using var logger = LogMethod($"{nameof(Warmup)}_Callback");
+#endif
+                
+                try
+                {
+                    if (result.Exception is not null)
+                    {
+                        p_callback(p_callback_handler, return_value_json.AsException(result.Exception, false));
+                        logger.LogException(result.Exception);
+                    }
+                    else
+                    {
+                        p_callback(p_callback_handler, return_value_json.AsValue(result.Result, CustomSourceGenerationContext.WarmupResult, false));
+                    }
+                }
+                catch (Exception e)
+                {
+                    p_callback(p_callback_handler, return_value_json.AsException(e, false));
+                    logger.LogException(e);
+                }
+            });
+
+            return return_value_async.AsValue(false);
+        }
+        catch (Exception e)
+        {
+            logger.LogException(e);
+            return return_value_async.AsException(e, false);
+        }
+    }
+
+    /// <summary>
+    /// Applies the thread pool limits and reports the runtime settings in effect.
+    /// </summary>
+    /// <remarks>
+    /// Installs and bridge callbacks block thread pool threads, so parallel installs need a higher minimum
+    /// than the pool starts with. The GC mode can't change once the runtime runs: the addon sets
+    /// DOTNET_gcServer and DOTNET_GCConserveMemory before calling this, which only the first call into
+    /// the library picks up. A later call asking for a GC setting other than the one in effect fails
+    /// without changing anything.
+    /// </remarks>
+    [UnmanagedCallersOnly(EntryPoint = "configure_runtime", CallConvs = [typeof(CallConvCdecl)]), IsNotConst<IsPtrConst>]
+    public static return_value_json* ConfigureRuntime([IsConst<IsPtrConst>] param_json* p_options)
+    {
+#if DEBUG
+        using var logger = LogMethod(p_options);
+#else
+        using var logger = LogMethod();
+#endif
+
+        try
+        {
+            var options = p_options is null
+                ? new RuntimeOptions()
+                : BUTR.NativeAOT.Shared.Utils.DeserializeJson(p_options, CustomSourceGenerationContext.RuntimeOptions) ?? new RuntimeOptions();
+
+            CheckStartupSettings(options);
+            ApplyThreadPoolLimits(options);
+
+            return return_value_json.AsValue(GetRuntimeSettings(), CustomSourceGenerationContext.RuntimeSettings, false);
+        }
+        catch (Exception e)
+        {
+            logger.LogException(e);
+            return return_value_json.AsException(e, false);
+        }
+    }
+
+    // The GC reads its configuration once, when the runtime starts
+    private static void CheckStartupSettings(RuntimeOptions options)
+    {
+        var configuration = GC.GetConfigurationVariables();
+        var gcServer = configuration.TryGetValue("ServerGC", out var server) && Convert.ToBoolean(server);
+        var gcConserveMemory = configuration.TryGetValue("ConserveMemory", out var conserveMemory) ? Convert.ToInt32(conserveMemory) : 0;
+        if (options.GcServer is { } requestedGcServer && requestedGcServer != gcServer)
+            throw new InvalidOperationException($"gcServer is {gcServer}, the runtime was started before configureRuntime could set it");
+        if (options.GcConserveMemory is { } requestedGcConserveMemory && requestedGcConserveMemory != gcConserveMemory)
+            throw new InvalidOperationException($"gcConserveMemory is {gcConserveMemory}, the runtime was started before configureRuntime could set it");
+    }
+
+    private static void ApplyThreadPoolLimits(RuntimeOptions options)
+    {
+        ThreadPool.GetMinThreads(out var minThreads, out var minIoThreads);
+        ThreadPool.GetMaxThreads(out var maxThreads, out var maxIoThreads);
+        var min = options.MinThreads ?? minThreads;
+        var max = options.MaxThreads ?? maxThreads;
+        if (min > max)
+            throw new ArgumentOutOfRangeException("minThreads", min, $"minThreads is above maxThreads {max}");
+
+        // Each call is checked against the other limit, so a raised maximum goes first and a lowered one last
+        if (max >= maxThreads)
+        {
+            SetMax();
+            SetMin();
+        }
+        else
+        {
+            SetMin();
+            SetMax();
+        }
+
+        void SetMin()
+        {
+            if (!ThreadPool.SetMinThreads(min, minIoThreads))
+                throw new ArgumentOutOfRangeException("minThreads", min, "The thread pool rejected minThreads");
+        }
+
+        void SetMax()
+        {
+            if (!ThreadPool.SetMaxThreads(max, maxIoThreads))
+                throw new ArgumentOutOfRangeException("maxThreads", max, "The thread pool rejected maxThreads");
+        }
+    }
+
+    private static RuntimeSettings GetRuntimeSettings()
+    {
+        ThreadPool.GetMinThreads(out var minThreads, out _);
+        ThreadPool.GetMaxThreads(out var maxThreads, out _);
+        var conserveMemory = GC.GetConfigurationVariables().TryGetValue("ConserveMemory", out var value) ? Convert.ToInt32(value) : 0;
+        return new RuntimeSettings
+        {
+            MinThreads = minThreads,
+            MaxThreads = maxThreads,
+            ThreadCount = ThreadPool.ThreadCount,
+            GcServer = GCSettings.IsServerGC,
+            GcConserveMemory = conserveMemory,
+        };
+    }
+
+    private static WarmupResult RunWarmup(WarmupOptions options)
+    {
+        var stopwatch = Stopwatch.StartNew();
+
+        var loggerTime = 0.0;
+        if (options.Logger)
+        {
+            EnsureDefault();
+            loggerTime = stopwatch.Elapsed.TotalMilliseconds;
+        }
+
+        // serializing once builds the metadata of the types every install returns
+        var start = stopwatch.Elapsed;
+        JsonSerializer.SerializeToUtf8Bytes(SupportedResult.AsNotSupported, CustomSourceGenerationContext.SupportedResult);
+        JsonSerializer.SerializeToUtf8Bytes(new InstallResult { Message = string.Empty, Instructions = new List<Instruction>() }, CustomSourceGenerationContext.InstallResult);
+        JsonSerializer.SerializeToUtf8Bytes(new ScriptCacheStats(), CustomSourceGenerationContext.ScriptCacheStats);
+        var serializersTime = (stopwatch.Elapsed - start).TotalMilliseconds;
+
+        var result = Installer.Warmup(options);
+
+        return result with
+        {
+            Logger = loggerTime,
+            Serializers = serializersTime,
+            Total = stopwatch.Elapsed.TotalMilliseconds,
+        };
+    }
+}
\ No newline at end of file
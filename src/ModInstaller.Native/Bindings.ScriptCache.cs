@@ -0,0 +1,136 @@
+﻿using BUTR.NativeAOT.Shared;
+
+using FomodInstaller.Scripting;
+
+using ModInstaller.Lite;
+
+using System;
+using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+using System.Threading.Tasks;
+
+namespace ModInstaller.Native;
+
+public static unsafe partial class Bindings
+{
+    [UnmanagedCallersOnly(EntryPoint = "precompile_script", CallConvs = [typeof(CallConvCdecl)]), IsNotConst<IsPtrConst>]
+    public static return_value_async* PrecompileScript(
+        [IsConst<IsPtrConst>] param_string* p_script_path,
+        [IsConst<IsPtrConst>] param_bool validate,
+        param_ptr* p_callback_handler,
+        delegate* unmanaged[Cdecl]<param_ptr*, return_value_bool*, void> p_callback)
+    {
+#if DEBUG
+        using var logger = LogMethod(p_script_path, &validate);
+#else
+        using var logger = LogMethod();
+#endif
+        
+        try
+        {
+            var scriptPath = new string(param_string.ToSpan(p_script_path));
+
+            Task.Run(() => Installer.PrecompileScript(scriptPath, validate)).ContinueWith(result =>
+            {
+#if DEBUG
+                using var logger = LogMethod($"{nameof(PrecompileScript)}_Callback");
+#else
+                using var logger = LogMethod($"{nameof(PrecompileScript)}_Callback");
+#endif
+                
+                try
+                {
+                    if (result.Exception is not null)
+                    {
+                        p_callback(p_callback_handler, return_value_bool.AsException(result.Exception, false));
+                        logger.LogException(result.Exception);
+                    }
+                    else
+                    {
+                        p_callback(p_callback_handler, return_value_bool.AsValue(result.Result, false));
+                    }
+                }
+                catch (Exception e)
+                {
+                    p_callback(p_callback_handler, return_value_bool.AsException(e, false));
+                    logger.LogException(e);
+                }
+            });
+
+            return return_value_async.AsValue(false);
+        }
+        catch (Exception e)
+        {
+            logger.LogException(e);
+            return return_value_async.AsException(e, false);
+        }
+    }
+
+    [UnmanagedCallersOnly(EntryPoint = "clear_script_cache", CallConvs = [typeof(CallConvCdecl)])]
+    public static return_value_void* ClearScriptCache()
+    {
+#if DEBUG
+        using var logger = LogMethod();
+#else
+        using var logger = LogMethod();
+#endif
+        
+        try
+        {
+            ScriptCache.Shared.Clear();
+
+            return return_value_void.AsValue(false);
+        }
+        catch (Exception e)
+        {
+            logger.LogException(e);
+            return return_value_void.AsException(e, false);
+        }
+    }
+
+    [UnmanagedCallersOnly(EntryPoint = "set_script_cache_directory", CallConvs = [typeof(CallConvCdecl)]), IsNotConst<IsPtrConst>]
+    public static return_value_void* SetScriptCacheDirectory([IsConst<IsPtrConst>] param_string* p_directory)
+    {
+#if DEBUG
+        using var logger = LogMethod(p_directory);
+#else
+        using var logger = LogMethod();
+#endif
+        
+        try
+        {
+            var directory = p_directory is null ? null : new string(param_string.ToSpan(p_directory));
+
+            ScriptCache.Shared.CacheDirectory = directory;
+
+            return return_value_void.AsValue(false);
+        }
+        catch (Exception e)
+        {
+            logger.LogException(e);
+            return return_value_void.AsException(e, false);
+        }
+    }
+
+    [UnmanagedCallersOnly(EntryPoint = "script_cache_stats", CallConvs = [typeof(CallConvCdecl)]), IsNotConst<IsPtrConst>]
+    public static return_value_json* GetScriptCacheStats()
+    {
+#if DEBUG
+        using var logger = LogMethod();
+#else
+        using var logger = LogMethod();
+#endif
+        
+        try
+        {
+            var result = ScriptCache.Shared.GetStats();
+
+            return return_value_json.AsValue(result, CustomSourceGenerationContext.ScriptCacheStats, false);
+        }
+        catch (Exception e)
+        {
+            logger.LogException(e);
+            return return_value_json.AsException(e, false);
+        }
+    }
+}
\ No newline at end of file
@@ -108,6 +108,24 @@ internal unsafe delegate return_value_json* N_ReadDirectoryFileList(param_ptr* p
 internal unsafe delegate return_value_json* N_ReadDirectoryList(param_ptr* p_owner,
     param_string* p_directory_path);
 
+[UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+internal unsafe delegate return_value_json* N_Stat(param_ptr* p_owner,
+    param_string* p_path);
+
+[UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+internal unsafe delegate return_value_json* N_OpenFile(param_ptr* p_owner,
+    param_string* p_file_path);
+
+[UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+internal unsafe delegate return_value_data* N_ReadFile(param_ptr* p_owner,
+    param_int handle,
+    param_int offset,
+    param_int length);
+
+[UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+internal unsafe delegate return_value_void* N_CloseFile(param_ptr* p_owner,
+    param_int handle);
+
 [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
 internal unsafe delegate param_int N_Log(param_ptr* p_owner,
     param_int level,
@@ -2,27 +2,43 @@
 
 using System;
 using System.IO;
+using System.Linq;
 
 using Utils;
 
 namespace ModInstaller.Native.Adapters;
 
-internal class CallbackFileSystem : IFileSystem
+internal class CallbackFileSystem : IFileSystem, IFileHandleSystem
 {
     private readonly unsafe param_ptr* _pOwner;
     private readonly N_ReadFileContentDelegate _readFileContent;
     private readonly N_ReadDirectoryFileList _readDirectoryFileList;
     private readonly N_ReadDirectoryList _readDirectoryList;
+    private readonly N_Stat? _stat;
+    private readonly N_OpenFile? _openFile;
+    private readonly N_ReadFile? _readFile;
+    private readonly N_CloseFile? _closeFile;
 
     public unsafe CallbackFileSystem(param_ptr* pOwner,
         N_ReadFileContentDelegate readFileContent,
         N_ReadDirectoryFileList readDirectoryFileList,
-        N_ReadDirectoryList readDirectoryList)
+        N_ReadDirectoryList readDirectoryList,
+        N_Stat? stat,
+        N_OpenFile? openFile,
+        N_ReadFile? readFile,
+        N_CloseFile? closeFile)
     {
         _pOwner = pOwner;
         _readFileContent = readFileContent;
         _readDirectoryFileList = readDirectoryFileList;
         _readDirectoryList = readDirectoryList;
+        _stat = stat;
+        if (openFile is not null && readFile is not null && closeFile is not null)
+        {
+            _openFile = openFile;
+            _readFile = readFile;
+            _closeFile = closeFile;
+        }
     }
 
     public unsafe byte[]? ReadFileContent(string filePath, int offset, int length)
@@ -98,4 +114,127 @@ internal class CallbackFileSystem : IFileSystem
             }
         }
     }
+
+    public unsafe FileSystemEntryInfo? Stat(string path)
+    {
+#if DEBUG
+        using var logger = LogMethod(path.ToFormattable());
+#else
+        using var logger = LogMethod();
+#endif
+
+        if (_stat is null)
+            return StatFallback(path);
+
+        fixed (char* pPath = path)
+        {
+            try
+            {
+                using var result = SafeStructMallocHandle.Create(_stat(_pOwner, (param_string*) pPath), true);
+                logger.LogResult(result);
+                var stat = result.ValueAsJson(Bindings.CustomSourceGenerationContext.FileSystemStat);
+                if (stat is null) return null;
+                var kind = string.Equals(stat.Kind, "directory", StringComparison.OrdinalIgnoreCase) ? FileSystemEntryKind.Directory : FileSystemEntryKind.File;
+                return new FileSystemEntryInfo(kind, stat.Size);
+            }
+            catch (Exception e)
+            {
+                logger.LogException(e);
+                return null;
+            }
+        }
+    }
+
+    // Hosts without a stat callback: probe with a one byte read, then the parent listing
+    private FileSystemEntryInfo? StatFallback(string path)
+    {
+        if (ReadFileContent(path, 0, 1) != null)
+            return new FileSystemEntryInfo(FileSystemEntryKind.File, -1);
+
+        var parentDir = Path.GetDirectoryName(path);
+        if (parentDir != null && ReadDirectoryList(parentDir)?.Contains(path) == true)
+            return new FileSystemEntryInfo(FileSystemEntryKind.Directory, 0);
+
+        return null;
+    }
+
+    public unsafe FileHandle? OpenFile(string filePath)
+    {
+#if DEBUG
+        using var logger = LogMethod(filePath.ToFormattable());
+#else
+        using var logger = LogMethod();
+#endif
+
+        // Without the handle callbacks the stream reads by path, handle id 0
+        if (_openFile is null)
+        {
+            var stat = Stat(filePath);
+            return stat?.Kind == FileSystemEntryKind.File ? new FileHandle(filePath, stat.Value.Size, 0) : null;
+        }
+
+        fixed (char* pFilePath = filePath)
+        {
+            try
+            {
+                using var result = SafeStructMallocHandle.Create(_openFile(_pOwner, (param_string*) pFilePath), true);
+                logger.LogResult(result);
+                var handle = result.ValueAsJson(Bindings.CustomSourceGenerationContext.FileSystemHandle);
+                return handle is null ? null : new FileHandle(filePath, handle.Size, handle.Handle);
+            }
+            catch (Exception e)
+            {
+                logger.LogException(e);
+                return null;
+            }
+        }
+    }
+
+    public unsafe byte[]? ReadFile(FileHandle handle, int offset, int length)
+    {
+#if DEBUG
+        using var logger = LogMethod(handle.Id, offset, length);
+#else
+        using var logger = LogMethod();
+#endif
+
+        if (_readFile is null || handle.Id == 0)
+            return ReadFileContent(handle.FilePath, offset, length);
+
+        try
+        {
+            using var result = SafeStructMallocHandle.Create(_readFile(_pOwner, handle.Id, offset, length), true);
+            logger.LogResult(result);
+            using var data = result.ValueAsData();
+            return data.ToSpan().ToArray();
+        }
+        catch (Exception e)
+        {
+            logger.LogException(e);
+            return null;
+        }
+    }
+
+    public unsafe void CloseFile(FileHandle handle)
+    {
+#if DEBUG
+        using var logger = LogMethod(handle.Id);
+#else
+        using var logger = LogMethod();
+#endif
+
+        if (_closeFile is null || handle.Id == 0)
+            return;
+
+        try
+        {
+            using var result = SafeStructMallocHandle.Create(_closeFile(_pOwner, handle.Id), true);
+            logger.LogResult(result);
+            result.ValueAsVoid();
+        }
+        catch (Exception e)
+        {
+            logger.LogException(e);
+        }
+    }
 }
\ No newline at end of file
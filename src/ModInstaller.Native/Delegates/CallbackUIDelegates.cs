@@ -6,6 +6,7 @@ using FomodInstaller.Interface.ui;
 using System;
 using System.Runtime.CompilerServices;
 using System.Runtime.InteropServices;
+using System.Threading;
 using System.Threading.Tasks;
 
 namespace ModInstaller.Native.Adapters;
@@ -19,6 +20,21 @@ internal class CallbackUIDelegates : UIDelegates
         public Action Cancel { get; init; }
     }
 
+    /// <summary>
+    /// What the dialog functions given to the host point to. JS can call them at any time, also after the
+    /// dialog ended, so the handle is never freed. Ending the dialog drops the callbacks and late calls do nothing.
+    /// </summary>
+    private sealed class StartDialogHandle
+    {
+        private StartDialogCallbacksData? _callbacks;
+
+        public StartDialogHandle(StartDialogCallbacksData callbacks) => _callbacks = callbacks;
+
+        public StartDialogCallbacksData? Callbacks => Volatile.Read(ref _callbacks);
+
+        public void End() => Volatile.Write(ref _callbacks, null);
+    }
+
     private readonly unsafe param_ptr* _pOwner;
     private readonly N_UI_StartDialog _startDialog;
     private readonly N_UI_EndDialog _endDialog;
@@ -46,30 +62,30 @@ internal class CallbackUIDelegates : UIDelegates
         using var logger = LogMethod();
 #endif
 
-        if (_currentDialogHandle is not null)
-            throw new Exception("Should be null");
+        // The handler serves sequential installs, a canceled one never reaches EndDialog
+        EndCurrentDialog();
 
-        _currentDialogHandle = GCHandle.Alloc(new StartDialogCallbacksData
+        _currentDialog = new StartDialogHandle(new StartDialogCallbacksData
         {
             Select = select,
             Continue = cont,
             Cancel = cancel,
-        }, GCHandleType.Normal);
+        });
+        var dialogHandle = GCHandle.Alloc(_currentDialog, GCHandleType.Normal);
 
         fixed (char* pModuleName = moduleName)
         fixed (char* pImage = BUTR.NativeAOT.Shared.Utils.SerializeJson(image, Bindings.CustomSourceGenerationContext.HeaderImage))
         {
             try
             {
-                using var result = SafeStructMallocHandle.Create(_startDialog(_pOwner, (param_string*) pModuleName, (param_json*) pImage, (param_ptr*) GCHandle.ToIntPtr(_currentDialogHandle.Value), &StartDialogSelectCallback, &StartDialogContinueCallback, &StartDialogCancelCallback), true);
+                using var result = SafeStructMallocHandle.Create(_startDialog(_pOwner, (param_string*) pModuleName, (param_json*) pImage, (param_ptr*) GCHandle.ToIntPtr(dialogHandle), &StartDialogSelectCallback, &StartDialogContinueCallback, &StartDialogCancelCallback), true);
                 logger.LogResult(result);
                 result.ValueAsVoid();
             }
             catch (Exception e)
             {
                 logger.LogException(e);
-                _currentDialogHandle?.Free();
-                _currentDialogHandle = null;
+                EndCurrentDialog();
             }
         }
     }
@@ -92,7 +108,7 @@ internal class CallbackUIDelegates : UIDelegates
                 return;
             }
 
-            if (GCHandle.FromIntPtr((IntPtr) pOwner) is not {Target: StartDialogCallbacksData callbacksData})
+            if (GCHandle.FromIntPtr((IntPtr) pOwner) is not {Target: StartDialogHandle dialogHandle})
             {
                 logger.LogException(new InvalidOperationException("Invalid GCHandle."));
                 return;
@@ -102,6 +118,12 @@ internal class CallbackUIDelegates : UIDelegates
             logger.LogResult(result);
             result.ValueAsVoid();
 
+            if (dialogHandle.Callbacks is not { } callbacksData)
+            {
+                logger.LogException(new InvalidOperationException("The dialog already ended."));
+                return;
+            }
+
             var optionIds = BUTR.NativeAOT.Shared.Utils.DeserializeJson<int[]>(optionIdsJson, Bindings.CustomSourceGenerationContext.Int32Array);
             callbacksData.Select(stepId, groupId, optionIds);
         }
@@ -130,7 +152,7 @@ internal class CallbackUIDelegates : UIDelegates
                 return;
             }
 
-            if (GCHandle.FromIntPtr((IntPtr) pOwner) is not {Target: StartDialogCallbacksData callbacksData})
+            if (GCHandle.FromIntPtr((IntPtr) pOwner) is not {Target: StartDialogHandle dialogHandle})
             {
                 logger.LogException(new InvalidOperationException("Invalid GCHandle."));
                 return;
@@ -140,6 +162,12 @@ internal class CallbackUIDelegates : UIDelegates
             logger.LogResult(result);
             result.ValueAsVoid();
 
+            if (dialogHandle.Callbacks is not { } callbacksData)
+            {
+                logger.LogException(new InvalidOperationException("The dialog already ended."));
+                return;
+            }
+
             callbacksData.Continue(forward, currentStepId);
         }
         catch (Exception e)
@@ -166,7 +194,7 @@ internal class CallbackUIDelegates : UIDelegates
                 return;
             }
 
-            if (GCHandle.FromIntPtr((IntPtr) pOwner) is not {Target: StartDialogCallbacksData callbacksData})
+            if (GCHandle.FromIntPtr((IntPtr) pOwner) is not {Target: StartDialogHandle dialogHandle})
             {
                 logger.LogException(new InvalidOperationException("Invalid GCHandle."));
                 return;
@@ -176,6 +204,12 @@ internal class CallbackUIDelegates : UIDelegates
             logger.LogResult(result);
             result.ValueAsVoid();
 
+            if (dialogHandle.Callbacks is not { } callbacksData)
+            {
+                logger.LogException(new InvalidOperationException("The dialog already ended."));
+                return;
+            }
+
             callbacksData.Cancel();
         }
         catch (Exception e)
@@ -185,7 +219,13 @@ internal class CallbackUIDelegates : UIDelegates
         }
     }
 
-    private GCHandle? _currentDialogHandle;
+    private StartDialogHandle? _currentDialog;
+
+    private void EndCurrentDialog()
+    {
+        _currentDialog?.End();
+        _currentDialog = null;
+    }
 
     public override unsafe void EndDialog()
     {
@@ -205,6 +245,10 @@ internal class CallbackUIDelegates : UIDelegates
         {
             logger.LogException(e);
         }
+        finally
+        {
+            EndCurrentDialog();
+        }
     }
 
     public override unsafe void UpdateState(InstallerStep[] installSteps, int currentStepId)
@@ -215,7 +259,7 @@ internal class CallbackUIDelegates : UIDelegates
         using var logger = LogMethod();
 #endif
 
-        fixed (char* pInstallSteps = BUTR.NativeAOT.Shared.Utils.SerializeJson(installSteps, Bindings.CustomSourceGenerationContext.InstallerStepArray))
+        fixed (char* pInstallSteps = BUTR.NativeAOT.Shared.Utils.SerializeJson(InstallerStepsState.Create(installSteps), Bindings.CustomSourceGenerationContext.InstallerStepsState))
         {
             try
             {
@@ -2,6 +2,7 @@
 
 using FomodInstaller.Interface;
 using FomodInstaller.Interface.ui;
+using FomodInstaller.Scripting;
 
 using System;
 using System.Runtime.InteropServices;
@@ -16,11 +17,13 @@ internal class NativeCoreDelegatesHandler : CoreDelegates, IDisposable
     private CallbackContextDelegates _contextDelegates;
     private CallbackIniDelegates _iniDelegates;
     private CallbackUIDelegates _uiDelegates;
+    private readonly ImagePrefetcher _imagePrefetcher = new();
 
     public override PluginDelegates plugin => _pluginDelegates;
     public override IniDelegates ini => _iniDelegates;
     public override ContextDelegates context => _contextDelegates;
     public override UIDelegates ui => _uiDelegates;
+    public override ImagePrefetcher imagePrefetcher => _imagePrefetcher;
 
     public unsafe param_ptr* OwnerPtr { get; }
     public unsafe VoidPtr* HandlePtr { get; }
@@ -47,6 +50,7 @@ internal class NativeCoreDelegatesHandler : CoreDelegates, IDisposable
 
     public void Dispose()
     {
+        _imagePrefetcher.Clear();
         ReleaseUnmanagedResources();
         GC.SuppressFinalize(this);
     }
@@ -0,0 +1,10 @@
+﻿namespace ModInstaller.Native;
+
+/// <summary>
+/// What the open file callback returns for an existing file. Size is -1 when it is not known.
+/// </summary>
+internal record FileSystemHandle
+{
+    public int Handle { get; set; }
+    public long Size { get; set; }
+}
\ No newline at end of file
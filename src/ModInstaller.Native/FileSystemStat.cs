@@ -0,0 +1,10 @@
+﻿namespace ModInstaller.Native;
+
+/// <summary>
+/// What the stat callback returns for an existing entry. Kind is "file" or "directory".
+/// </summary>
+internal record FileSystemStat
+{
+    public string Kind { get; set; } = string.Empty;
+    public long Size { get; set; }
+}
\ No newline at end of file
@@ -0,0 +1,203 @@
+﻿using BUTR.NativeAOT.Shared;
+
+using FomodInstaller.Interface;
+
+using ModInstaller.Lite;
+
+using System;
+using System.Buffers.Binary;
+using System.Collections.Generic;
+using System.Text;
+using System.Text.Json;
+
+namespace ModInstaller.Native;
+
+/// <summary>
+/// Writes an <see cref="InstallResult"/> in the compact layout decoded by the addon.
+/// </summary>
+/// <remarks>
+/// All integers are little-endian. Strings are stored once in a table and referenced by index, -1 for null.
+/// A path is stored as its last segment after the index of its directory, so directories shared by many
+/// files are sent once.
+/// <code>
+/// u32 magic "FMIR", u32 version
+/// u32 string count, per string: i32 prefix (an earlier string, -1 for none), u32 UTF-8 suffix length, bytes
+/// i32 message
+/// u32 instruction count n
+/// u8[n] type, u8[n] flags, i32[n] source, i32[n] destination, i32[n] priority
+/// per instruction in order, if flagged: i32 type name, i32 section, i32 key, i32 value, u32 data length and bytes
+/// u32 decisions length, UTF-8 JSON (0 when there are none)
+/// </code>
+/// The result is written straight into memory from <see cref="Allocator"/>, which the caller frees.
+/// </remarks>
+internal static unsafe class InstallResultEncoder
+{
+    public const uint Magic = 0x52494d46;
+    public const uint Version = 2;
+
+    // Indices of the type column, the order is part of the format
+    private static readonly string[] Types = ["copy", "mkdir", "generatefile", "iniedit", "enableplugin", "enableallplugins", "unsupported", "error"];
+    private const byte OtherType = 0xFF;
+
+    private const byte FlagTypeName = 1;
+    private const byte FlagIni = 2;
+    private const byte FlagData = 4;
+
+    private sealed class StringTable
+    {
+        private readonly Dictionary<string, int> _indices = new(StringComparer.Ordinal);
+        public readonly List<(int Prefix, string Suffix)> Strings = [];
+        public long Size = sizeof(uint);
+
+        public int Add(string? value)
+        {
+            if (value is null) return -1;
+            if (_indices.TryGetValue(value, out var index)) return index;
+
+            // A trailing separator belongs to the segment, so directories chain up to their parents
+            var separator = value.Length < 2 ? -1 : value.AsSpan(0, value.Length - 1).LastIndexOfAny('/', '\\');
+            var prefix = separator > 0 ? Add(value.Substring(0, separator + 1)) : -1;
+            var suffix = separator > 0 ? value.Substring(separator + 1) : value;
+
+            index = Strings.Count;
+            _indices.Add(value, index);
+            Strings.Add((prefix, suffix));
+            Size += sizeof(int) + sizeof(uint) + Encoding.UTF8.GetByteCount(suffix);
+            return index;
+        }
+    }
+
+    private ref struct Writer
+    {
+        private readonly Span<byte> _span;
+        private int _offset;
+
+        public Writer(Span<byte> span) => _span = span;
+
+        public void WriteUInt32(uint value)
+        {
+            BinaryPrimitives.WriteUInt32LittleEndian(_span.Slice(_offset), value);
+            _offset += sizeof(uint);
+        }
+
+        public void WriteInt32(int value)
+        {
+            BinaryPrimitives.WriteInt32LittleEndian(_span.Slice(_offset), value);
+            _offset += sizeof(int);
+        }
+
+        public void WriteRaw(ReadOnlySpan<byte> value)
+        {
+            value.CopyTo(_span.Slice(_offset));
+            _offset += value.Length;
+        }
+
+        public void WriteBytes(ReadOnlySpan<byte> value)
+        {
+            WriteUInt32((uint) value.Length);
+            WriteRaw(value);
+        }
+
+        public void WriteString(string value)
+        {
+            var length = Encoding.UTF8.GetBytes(value, _span.Slice(_offset + sizeof(uint)));
+            WriteUInt32((uint) length);
+            _offset += length;
+        }
+    }
+
+    public static byte* Encode(InstallResult result, out int length)
+    {
+        var instructions = result.Instructions;
+        var count = instructions.Count;
+        var strings = new StringTable();
+
+        var message = strings.Add(result.Message);
+        var types = new byte[count];
+        var flags = new byte[count];
+        var sources = new int[count];
+        var destinations = new int[count];
+        long extrasSize = 0;
+        for (var i = 0; i < count; i++)
+        {
+            var instruction = instructions[i];
+            var type = Array.IndexOf(Types, instruction.type);
+            types[i] = type < 0 ? OtherType : (byte) type;
+            if (type < 0)
+            {
+                flags[i] |= FlagTypeName;
+                extrasSize += sizeof(int);
+                strings.Add(instruction.type);
+            }
+            if (instruction.section is not null || instruction.key is not null || instruction.value is not null)
+            {
+                flags[i] |= FlagIni;
+                extrasSize += 3 * sizeof(int);
+                strings.Add(instruction.section);
+                strings.Add(instruction.key);
+                strings.Add(instruction.value);
+            }
+            if (instruction.data is not null)
+            {
+                flags[i] |= FlagData;
+                extrasSize += sizeof(uint) + instruction.data.Length;
+            }
+            sources[i] = strings.Add(instruction.source);
+            destinations[i] = strings.Add(instruction.destination);
+        }
+
+        var decisions = result.Decisions is null
+            ? []
+            : JsonSerializer.SerializeToUtf8Bytes(result.Decisions, Bindings.CustomSourceGenerationContext.ListInstallDecision);
+
+        var size = 2 * sizeof(uint) + strings.Size + sizeof(int) + sizeof(uint)
+                   + (long) count * (2 + 3 * sizeof(int)) + extrasSize
+                   + sizeof(uint) + decisions.Length;
+        if (size > int.MaxValue) throw new InvalidOperationException("The install result is too large to encode");
+
+        length = (int) size;
+        var buffer = (byte*) Allocator.Alloc((nuint) length);
+        var writer = new Writer(new Span<byte>(buffer, length));
+
+        writer.WriteUInt32(Magic);
+        writer.WriteUInt32(Version);
+        writer.WriteUInt32((uint) strings.Strings.Count);
+        foreach (var (prefix, suffix) in strings.Strings)
+        {
+            writer.WriteInt32(prefix);
+            writer.WriteString(suffix);
+        }
+        writer.WriteInt32(message);
+        writer.WriteUInt32((uint) count);
+
+        writer.WriteRaw(types);
+        writer.WriteRaw(flags);
+        foreach (var source in sources) writer.WriteInt32(source);
+        foreach (var destination in destinations) writer.WriteInt32(destination);
+        foreach (var instruction in instructions) writer.WriteInt32(instruction.priority);
+
+        for (var i = 0; i < count; i++)
+        {
+            if (flags[i] == 0) continue;
+
+            var instruction = instructions[i];
+            if ((flags[i] & FlagTypeName) != 0)
+            {
+                writer.WriteInt32(strings.Add(instruction.type));
+            }
+            if ((flags[i] & FlagIni) != 0)
+            {
+                writer.WriteInt32(strings.Add(instruction.section));
+                writer.WriteInt32(strings.Add(instruction.key));
+                writer.WriteInt32(strings.Add(instruction.value));
+            }
+            if ((flags[i] & FlagData) != 0)
+            {
+                writer.WriteBytes(instruction.data);
+            }
+        }
+
+        writer.WriteBytes(decisions);
+        return buffer;
+    }
+}
@@ -0,0 +1,66 @@
+﻿using FomodInstaller.Interface.ui;
+
+using System;
+using System.Collections.Generic;
+
+namespace ModInstaller.Native;
+
+/// <summary>
+/// The install steps as sent to uiUpdateState. Option images all sit under the mod's folder and every
+/// step is sent on each update, so their directories are sent once in <see cref="Prefixes"/>.
+/// </summary>
+/// <remarks>
+/// <see cref="ImagePrefixes"/> has an entry per option in step, group and option order: the index of the
+/// directory the option's image was cut from, or -1 when the image is sent whole.
+/// </remarks>
+internal record InstallerStepsState
+{
+    public string[] Prefixes { get; set; } = [];
+    public int[] ImagePrefixes { get; set; } = [];
+    public InstallerStep[] Steps { get; set; } = [];
+
+    /// <summary>
+    /// Cuts the directories off the option images. The steps are built for a single update, so they are changed in place.
+    /// </summary>
+    public static InstallerStepsState Create(InstallerStep[] steps)
+    {
+        var prefixes = new List<string>();
+        var indices = new Dictionary<string, int>(StringComparer.Ordinal);
+        var imagePrefixes = new List<int>();
+        foreach (var step in steps)
+        {
+            if (step.optionalFileGroups.group is null) continue;
+
+            foreach (var group in step.optionalFileGroups.group)
+            {
+                foreach (var option in group.options)
+                {
+                    var image = option.image;
+                    var separator = image?.LastIndexOfAny(['/', '\\']) ?? -1;
+                    if (separator <= 0)
+                    {
+                        imagePrefixes.Add(-1);
+                        continue;
+                    }
+
+                    var prefix = image!.Substring(0, separator + 1);
+                    if (!indices.TryGetValue(prefix, out var index))
+                    {
+                        index = prefixes.Count;
+                        indices.Add(prefix, index);
+                        prefixes.Add(prefix);
+                    }
+                    imagePrefixes.Add(index);
+                    option.image = image.Substring(separator + 1);
+                }
+            }
+        }
+
+        return new InstallerStepsState
+        {
+            Prefixes = prefixes.ToArray(),
+            ImagePrefixes = imagePrefixes.ToArray(),
+            Steps = steps,
+        };
+    }
+}
@@ -74,6 +74,15 @@ internal static partial class Logger
         ExternalInstance = Factory.CreateLogger("C++");
     }
 
+    /// <summary>
+    /// Creates the default logger unless a logger is already set.
+    /// </summary>
+    public static void EnsureDefault()
+    {
+        if (NativeInstance is null)
+            CreateDefault();
+    }
+
     private static void PrefixFormatter(in MessageTemplate template, in LogInfo info)
     {
         template.Format(info.Timestamp.Utc, _logLevel4Letters[(int) info.LogLevel], info.Category.Name);
@@ -0,0 +1,13 @@
+﻿namespace ModInstaller.Native;
+
+/// <summary>
+/// Runtime settings requested by configure_runtime, null keeps the current value.
+/// GcServer and GcConserveMemory are read by the runtime when it starts, see <see cref="Bindings.ConfigureRuntime"/>.
+/// </summary>
+internal record RuntimeOptions
+{
+    public int? MinThreads { get; set; }
+    public int? MaxThreads { get; set; }
+    public bool? GcServer { get; set; }
+    public int? GcConserveMemory { get; set; }
+}
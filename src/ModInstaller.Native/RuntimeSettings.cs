@@ -0,0 +1,13 @@
+﻿namespace ModInstaller.Native;
+
+/// <summary>
+/// The runtime settings in effect, as reported by configure_runtime.
+/// </summary>
+internal record RuntimeSettings
+{
+    public int MinThreads { get; set; }
+    public int MaxThreads { get; set; }
+    public int ThreadCount { get; set; }
+    public bool GcServer { get; set; }
+    public int GcConserveMemory { get; set; }
+}
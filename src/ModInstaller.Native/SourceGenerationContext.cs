@@ -1,5 +1,6 @@
 ﻿using FomodInstaller.Interface;
 using FomodInstaller.Interface.ui;
+using FomodInstaller.Scripting;
 
 using ModInstaller.Lite;
 
@@ -22,9 +23,21 @@ namespace ModInstaller.Native;
 [JsonSerializable(typeof(string[]))]
 [JsonSerializable(typeof(List<string>))]
 [JsonSerializable(typeof(SupportedResult))]
+[JsonSerializable(typeof(SupportedResult[]))]
+[JsonSerializable(typeof(SupportedRequest[]))]
 [JsonSerializable(typeof(Instruction))]
 [JsonSerializable(typeof(InstallResult))]
+[JsonSerializable(typeof(List<InstallDecision>))]
 [JsonSerializable(typeof(JsonDocument))]
 [JsonSerializable(typeof(InstallerStep[]))]
+[JsonSerializable(typeof(InstallerStepsState))]
 [JsonSerializable(typeof(HeaderImage))]
+[JsonSerializable(typeof(ScriptCacheStats))]
+[JsonSerializable(typeof(ImagePrefetchStats))]
+[JsonSerializable(typeof(WarmupOptions))]
+[JsonSerializable(typeof(WarmupResult))]
+[JsonSerializable(typeof(RuntimeOptions))]
+[JsonSerializable(typeof(RuntimeSettings))]
+[JsonSerializable(typeof(FileSystemStat))]
+[JsonSerializable(typeof(FileSystemHandle))]
 internal partial class SourceGenerationContext : JsonSerializerContext;
\ No newline at end of file
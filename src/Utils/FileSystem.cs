@@ -5,11 +5,60 @@ using System.Text;
 
 namespace Utils
 {
+    public enum FileSystemEntryKind
+    {
+	    File,
+	    Directory
+    }
+
+    /// <summary>
+    /// Metadata of a file system entry, size is -1 when it is not known
+    /// </summary>
+    public readonly struct FileSystemEntryInfo
+    {
+	    public FileSystemEntryKind Kind { get; }
+	    public long Size { get; }
+
+	    public FileSystemEntryInfo(FileSystemEntryKind kind, long size)
+	    {
+		    Kind = kind;
+		    Size = size;
+	    }
+    }
+
+    /// <summary>
+    /// A file opened through <see cref="IFileHandleSystem"/>, length is -1 when it is not known
+    /// </summary>
+    public sealed class FileHandle
+    {
+	    public string FilePath { get; }
+	    public long Length { get; }
+	    public int Id { get; }
+
+	    public FileHandle(string filePath, long length, int id)
+	    {
+		    FilePath = filePath;
+		    Length = length;
+		    Id = id;
+	    }
+    }
+
+    /// <summary>
+    /// File system that can keep a file open between the chunked reads of a <see cref="FileSystemStream"/>
+    /// </summary>
+    public interface IFileHandleSystem
+    {
+	    FileHandle? OpenFile(string filePath);
+	    byte[]? ReadFile(FileHandle handle, int offset, int length);
+	    void CloseFile(FileHandle handle);
+    }
+
     public interface IFileSystem
     {
 	    byte[]? ReadFileContent(string filePath, int offset, int length);
 	    string[]? ReadDirectoryFileList(string directoryPath, string pattern, SearchOption searchOption);
 	    string[]? ReadDirectoryList(string directoryPath);
+	    FileSystemEntryInfo? Stat(string path);
     }
     
     public class DefaultFileSystem : IFileSystem
@@ -44,6 +93,13 @@ namespace Utils
 			if (!Directory.Exists(directoryPath)) return null;
 			return Directory.GetDirectories(directoryPath);
 		}
+
+		public FileSystemEntryInfo? Stat(string path)
+		{
+			if (File.Exists(path)) return new FileSystemEntryInfo(FileSystemEntryKind.File, new FileInfo(path).Length);
+			if (Directory.Exists(path)) return new FileSystemEntryInfo(FileSystemEntryKind.Directory, 0);
+			return null;
+		}
 	}
     
     public static class FileSystem
@@ -57,7 +113,7 @@ namespace Utils
 		/// <returns></returns>
 		public static bool FileExists(string filePath)
 		{
-			return Instance.ReadFileContent(filePath, 0, 1) != null;
+			return Instance.Stat(filePath)?.Kind == FileSystemEntryKind.File;
 		}
 
         /// <summary>
@@ -67,9 +123,7 @@ namespace Utils
         /// <returns></returns>
         public static bool DirectoryExists(string directoryPath)
         {
-	        var parentDir = Path.GetDirectoryName(directoryPath);
-	        if (parentDir == null) return false;
-	        return Instance.ReadDirectoryList(parentDir)?.Contains(directoryPath) == true;
+	        return Instance.Stat(directoryPath)?.Kind == FileSystemEntryKind.Directory;
         }
 
         /// <summary>
@@ -79,14 +133,16 @@ namespace Utils
         /// <returns></returns>
         public static string[] ReadAllLines(string filePath)
 		{
-			var data = Instance.ReadFileContent(filePath, 0, -1) ??
-			           throw new FileNotFoundException($"File not found: {filePath}");;
-			return TextUtil.ByteToStringWithoutBOM(data ?? []).Split(["\r\n", "\n"], StringSplitOptions.None);
+			return TextUtil.ByteToStringWithoutBOM(ReadAllBytes(filePath)).Split(["\r\n", "\n"], StringSplitOptions.None);
 		}
 
         /// <summary>
         /// Read whole uninterpreted content of a file into a byte array
         /// </summary>
+        /// <remarks>
+        /// A single read by path: the whole file ends up in one array either way, and opening a handle
+        /// first would cost another call to the file system for every script and image.
+        /// </remarks>
         /// <param name="filePath">path to the file to read</param>
         /// <returns></returns>
         public static byte[] ReadAllBytes(string filePath)
@@ -103,9 +159,8 @@ namespace Utils
         /// <returns></returns>
         public static Stream Open(string filePath, FileMode fileMode)
 		{
-			var data = Instance.ReadFileContent(filePath, 0, -1) ??
-			           (fileMode == FileMode.Open ? throw new FileNotFoundException($"File not found: {filePath}") : null);
-			return new MemoryStream(data ?? []);
+			return FileSystemStream.Open(Instance, filePath) ??
+			       (fileMode == FileMode.Open ? throw new FileNotFoundException($"File not found: {filePath}") : new MemoryStream());
 		}
 
         /// <summary>
@@ -0,0 +1,238 @@
+﻿using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Threading;
+
+namespace Utils
+{
+    /// <summary>
+    /// Read-only stream over a file of an <see cref="IFileSystem"/> that is fetched in chunks
+    /// </summary>
+    /// <remarks>
+    /// Sequential reads double the chunk size up to <see cref="MaxChunkSize"/>, so small files take
+    /// a single call and large ones only a few, while at most one chunk is buffered.
+    /// The read-ahead stays on the reading thread: the file system callbacks may have to run on it.
+    /// A stream keeps its file handle until it is disposed, <see cref="TrackOpenStreams"/> closes the
+    /// ones an install left open.
+    /// </remarks>
+    public sealed class FileSystemStream : Stream
+    {
+        public const int MinChunkSize = 64 * 1024;
+        public const int MaxChunkSize = 1024 * 1024;
+
+        /// <summary>
+        /// The streams opened in an async flow, see <see cref="TrackOpenStreams"/>
+        /// </summary>
+        private sealed class OpenStreams : IDisposable
+        {
+            private readonly HashSet<FileSystemStream> _streams = [];
+            private bool _disposed;
+
+            public bool Add(FileSystemStream stream)
+            {
+                lock (_streams)
+                    return !_disposed && _streams.Add(stream);
+            }
+
+            public void Remove(FileSystemStream stream)
+            {
+                lock (_streams)
+                    _streams.Remove(stream);
+            }
+
+            public void Dispose()
+            {
+                FileSystemStream[] streams;
+                lock (_streams)
+                {
+                    _disposed = true;
+                    streams = [.._streams];
+                    _streams.Clear();
+                }
+                foreach (var stream in streams)
+                    stream.Dispose();
+            }
+        }
+
+        private static readonly AsyncLocal<OpenStreams?> s_OpenStreams = new();
+
+        /// <summary>
+        /// Tracks the streams opened from here on in the calling async flow, disposing the result closes
+        /// the ones that are still open
+        /// </summary>
+        public static IDisposable TrackOpenStreams()
+        {
+            var streams = new OpenStreams();
+            s_OpenStreams.Value = streams;
+            return streams;
+        }
+
+        private readonly IFileSystem _fileSystem;
+        private readonly FileHandle _handle;
+        private readonly OpenStreams? _openStreams;
+        private byte[] _chunk = [];
+        private long _chunkStart;
+        private long _position;
+        private long _length;
+        private int _chunkSize;
+        private bool _disposed;
+
+        private FileSystemStream(IFileSystem fileSystem, FileHandle handle)
+        {
+            _fileSystem = fileSystem;
+            _handle = handle;
+            _length = handle.Length;
+            if (s_OpenStreams.Value is { } openStreams && openStreams.Add(this))
+            {
+                _openStreams = openStreams;
+            }
+        }
+
+        /// <summary>
+        /// Opens a file, returns null if it does not exist
+        /// </summary>
+        public static FileSystemStream? Open(IFileSystem fileSystem, string filePath)
+        {
+            if (fileSystem is IFileHandleSystem handles)
+            {
+                var handle = handles.OpenFile(filePath);
+                return handle == null ? null : new FileSystemStream(fileSystem, handle);
+            }
+
+            var stat = fileSystem.Stat(filePath);
+            if (stat?.Kind != FileSystemEntryKind.File) return null;
+            return new FileSystemStream(fileSystem, new FileHandle(filePath, stat.Value.Size, 0));
+        }
+
+        public override bool CanRead => !_disposed;
+        public override bool CanSeek => !_disposed;
+        public override bool CanWrite => false;
+
+        public override long Length => _length >= 0 ? _length : throw new NotSupportedException("The file system did not report the file size");
+
+        public override long Position
+        {
+            get => _position;
+            set => _position = value >= 0 ? value : throw new ArgumentOutOfRangeException(nameof(value));
+        }
+
+        /// <summary>
+        /// Reads the rest of the file into a single array, in chunks of at most <see cref="MaxChunkSize"/>
+        /// </summary>
+        public byte[] ReadToEnd()
+        {
+            if (_length < 0)
+            {
+                var rest = ReadChunk(_position, -1);
+                _position += rest.Length;
+                _length = _position;
+                return rest;
+            }
+
+            var buffer = new byte[Math.Max(0, _length - _position)];
+            var read = 0;
+            while (read < buffer.Length)
+            {
+                var chunk = ReadChunk(_position, Math.Min(MaxChunkSize, buffer.Length - read));
+                if (chunk.Length == 0) break;
+                Buffer.BlockCopy(chunk, 0, buffer, read, chunk.Length);
+                read += chunk.Length;
+                _position += chunk.Length;
+            }
+
+            if (read < buffer.Length)
+            {
+                Array.Resize(ref buffer, read);
+            }
+            return buffer;
+        }
+
+        public override int Read(byte[] buffer, int offset, int count)
+        {
+            if (_disposed) throw new ObjectDisposedException(nameof(FileSystemStream));
+            if (buffer == null) throw new ArgumentNullException(nameof(buffer));
+            if (offset < 0 || count < 0 || offset + count > buffer.Length) throw new ArgumentOutOfRangeException(nameof(count));
+
+            var total = 0;
+            while (count > 0)
+            {
+                var inChunk = _position - _chunkStart;
+                if (inChunk < 0 || inChunk >= _chunk.Length)
+                {
+                    if (_length >= 0 && _position >= _length) break;
+                    Fill();
+                    if (_chunk.Length == 0) break;
+                    inChunk = 0;
+                }
+
+                var copy = (int) Math.Min(count, _chunk.Length - inChunk);
+                Buffer.BlockCopy(_chunk, (int) inChunk, buffer, offset, copy);
+                offset += copy;
+                count -= copy;
+                total += copy;
+                _position += copy;
+            }
+            return total;
+        }
+
+        public override long Seek(long offset, SeekOrigin origin)
+        {
+            Position = origin switch
+            {
+                SeekOrigin.Begin => offset,
+                SeekOrigin.Current => _position + offset,
+                SeekOrigin.End => Length + offset,
+                _ => throw new ArgumentOutOfRangeException(nameof(origin)),
+            };
+            return _position;
+        }
+
+        public override void Flush() { }
+
+        public override void SetLength(long value) => throw new NotSupportedException();
+
+        public override void Write(byte[] buffer, int offset, int count) => throw new NotSupportedException();
+
+        protected override void Dispose(bool disposing)
+        {
+            if (!_disposed)
+            {
+                _disposed = true;
+                _chunk = [];
+                _openStreams?.Remove(this);
+                if (_fileSystem is IFileHandleSystem handles && _handle.Id != 0)
+                {
+                    handles.CloseFile(_handle);
+                }
+            }
+            base.Dispose(disposing);
+        }
+
+        private void Fill()
+        {
+            // Seeking away starts over with a small chunk
+            var sequential = _chunk.Length > 0 && _position == _chunkStart + _chunk.Length;
+            _chunkSize = sequential ? Math.Min(_chunkSize * 2, MaxChunkSize) : MinChunkSize;
+
+            var size = _length >= 0 ? (int) Math.Min(_chunkSize, _length - _position) : _chunkSize;
+            _chunk = ReadChunk(_position, size);
+            _chunkStart = _position;
+
+            // A short read is the end of a file of unknown size
+            if (_length < 0 && _chunk.Length < size)
+            {
+                _length = _position + _chunk.Length;
+            }
+        }
+
+        private byte[] ReadChunk(long position, int length)
+        {
+            if (position > int.MaxValue) throw new IOException($"Offset {position} is out of range for {_handle.FilePath}");
+
+            var data = _fileSystem is IFileHandleSystem handles && _handle.Id != 0
+                ? handles.ReadFile(_handle, (int) position, length)
+                : _fileSystem.ReadFileContent(_handle.FilePath, (int) position, length);
+            return data ?? throw new IOException($"Failed to read {_handle.FilePath}");
+        }
+    }
+}
@@ -1,65 +1,276 @@
 ﻿using System;
 using System.Collections.Generic;
 using System.IO;
-using System.Linq;
 
 namespace Utils
 {
+    /// <summary>
+    /// Directory tree of an archive listing.
+    /// </summary>
+    /// <remarks>
+    /// The tree is built once, eagerly, into a flat arena of nodes. Path segments are interned, a directory's
+    /// children are found through a single hash lookup and directory names compare case-insensitively, so
+    /// selecting a directory costs one lookup per segment regardless of the archive size.
+    /// </remarks>
     public class FileTree
     {
-        public IEnumerable<FileTree> SubDirectories { get; private set; }
-        public IEnumerable<string> Files { get; private set; }
-        public string Name { get; private set; }
+        private static readonly char[] PathSeparators = new char[] { Path.DirectorySeparatorChar, Path.AltDirectorySeparatorChar };
+
+        private readonly Arena m_arena;
+        private readonly int m_node;
+        private FileTree[] m_subDirectories;
+        private string[] m_files;
+
+        public IEnumerable<FileTree> SubDirectories => m_subDirectories ?? (m_subDirectories = m_arena.SubDirectories(m_node));
+        public IEnumerable<string> Files => m_files ?? (m_files = m_arena.Files(m_node));
+        public string Name => m_arena.Name(m_node);
 
         public FileTree(IEnumerable<string> paths)
         {
-            Name = "/";
-            IEnumerable<string[]> pathsSegmented = paths.Select(path => path.Split(PathSeparators, StringSplitOptions.None));
-            InsertPaths(pathsSegmented);
+            m_arena = new Arena("/", this);
+            foreach (var path in paths)
+            {
+                m_arena.Add(path);
+            }
         }
 
         public FileTree(string name, IEnumerable<string[]> paths)
         {
-            Name = name;
-            InsertPaths(paths);
+            m_arena = new Arena(name, this);
+            foreach (var path in paths)
+            {
+                m_arena.Add(path);
+            }
         }
 
+        private FileTree(Arena arena, int node)
+        {
+            m_arena = arena;
+            m_node = node;
+        }
+
+        /// <summary>
+        /// Returns the directory at the path relative to this one, null if there is none
+        /// </summary>
         public FileTree SelectDirectory(string path)
         {
-            return SelectDirectory(path.Split(PathSeparators, StringSplitOptions.RemoveEmptyEntries));
+            // empty segments are skipped, so "" and "/" select this directory
+            var node = m_node;
+            var start = 0;
+            while (start < path.Length)
+            {
+                var end = path.IndexOfAny(PathSeparators, start);
+                if (end < 0)
+                {
+                    end = path.Length;
+                }
+                if (end > start)
+                {
+                    node = m_arena.FindChild(node, path.Substring(start, end - start));
+                    if (node < 0)
+                    {
+                        return null;
+                    }
+                }
+                start = end + 1;
+            }
+            return m_arena.View(node);
         }
 
-        private static char[] PathSeparators = new char[] { Path.DirectorySeparatorChar, Path.AltDirectorySeparatorChar };
+        private struct Node
+        {
+            public string Name;
+            public int FirstChild;
+            public int LastChild;
+            public int NextSibling;
+            public int ChildCount;
+            public int FirstFile;
+            public int LastFile;
+            public int FileCount;
+        }
 
-        private void InsertPaths(IEnumerable<string[]> pathsSegmented)
+        private struct FileEntry
         {
-            // we assume directories have a tailing separator so they would have at least two path segments, the latter of which
-            // is empty
-            Files = pathsSegmented.Where(path => path.Length == 1).Select(path => path[0]);
-
-            // group the remaining paths by the first path element, then turn each group into a new tree
-            SubDirectories = pathsSegmented
-                .Where(path => path.Length > 1)
-                .GroupBy(path => path[0])
-                .Select(group => new FileTree(group.Key, group.Select(path => path.Skip(1).ToArray())));
+            public string Name;
+            public int Next;
         }
 
-        private FileTree SelectDirectory(string[] path)
+        private struct ChildKey
         {
-            // make the top level directory selectable by passing an empty path
-            //if ((path.Length == 0) || ((path.Length == 1) && (path[0].Length == 1) && (PathSeparators.Contains(path[0][0]))))
-            if (path.Length == 0)
+            public int Parent;
+            public string Name;
+        }
+
+        private sealed class ChildKeyComparer : IEqualityComparer<ChildKey>
+        {
+            public static readonly ChildKeyComparer Instance = new ChildKeyComparer();
+
+            public bool Equals(ChildKey x, ChildKey y)
+            {
+                return x.Parent == y.Parent && string.Equals(x.Name, y.Name, StringComparison.OrdinalIgnoreCase);
+            }
+
+            public int GetHashCode(ChildKey key)
+            {
+                return (key.Parent * 397) ^ StringComparer.OrdinalIgnoreCase.GetHashCode(key.Name);
+            }
+        }
+
+        /// <summary>
+        /// Storage shared by all directories of a tree. Node 0 is the root, the children and files
+        /// of a node are singly linked in insertion order.
+        /// </summary>
+        private sealed class Arena
+        {
+            private Node[] m_nodes = new Node[16];
+            private int m_nodeCount;
+            private FileEntry[] m_files = new FileEntry[16];
+            private int m_fileCount;
+            private FileTree[] m_views = new FileTree[16];
+            private readonly Dictionary<ChildKey, int> m_children = new Dictionary<ChildKey, int>(ChildKeyComparer.Instance);
+            private readonly Dictionary<string, string> m_segments = new Dictionary<string, string>(StringComparer.Ordinal);
+
+            public Arena(string name, FileTree root)
+            {
+                AddNode(name);
+                m_views[0] = root;
+            }
+
+            public void Add(string path)
             {
-                return this;
+                // we assume directories have a tailing separator, so their last segment is empty
+                var node = 0;
+                var start = 0;
+                while (true)
+                {
+                    var end = path.IndexOfAny(PathSeparators, start);
+                    if (end < 0)
+                    {
+                        AddFile(node, start == 0 ? path : path.Substring(start));
+                        return;
+                    }
+                    node = GetOrAddChild(node, path.Substring(start, end - start));
+                    start = end + 1;
+                }
             }
 
-            FileTree sub = SubDirectories.First(subDir => subDir.Name == path[0]);
-            if ((sub != null) && (path.Length > 1))
+            public void Add(string[] segments)
             {
-                return sub.SelectDirectory(path.Skip(1).ToArray());
-            } else
+                var node = 0;
+                for (var i = 0; i < segments.Length - 1; i++)
+                {
+                    node = GetOrAddChild(node, segments[i]);
+                }
+                if (segments.Length > 0)
+                {
+                    AddFile(node, segments[segments.Length - 1]);
+                }
+            }
+
+            public string Name(int node)
+            {
+                return m_nodes[node].Name;
+            }
+
+            public int FindChild(int parent, string name)
+            {
+                return m_children.TryGetValue(new ChildKey { Parent = parent, Name = name }, out var child) ? child : -1;
+            }
+
+            public FileTree View(int node)
             {
-                return sub;
+                return m_views[node] ?? (m_views[node] = new FileTree(this, node));
+            }
+
+            public FileTree[] SubDirectories(int node)
+            {
+                var result = new FileTree[m_nodes[node].ChildCount];
+                var child = m_nodes[node].FirstChild;
+                for (var i = 0; i < result.Length; i++)
+                {
+                    result[i] = View(child);
+                    child = m_nodes[child].NextSibling;
+                }
+                return result;
+            }
+
+            public string[] Files(int node)
+            {
+                var result = new string[m_nodes[node].FileCount];
+                var file = m_nodes[node].FirstFile;
+                for (var i = 0; i < result.Length; i++)
+                {
+                    result[i] = m_files[file].Name;
+                    file = m_files[file].Next;
+                }
+                return result;
+            }
+
+            private string Intern(string segment)
+            {
+                if (m_segments.TryGetValue(segment, out var interned))
+                {
+                    return interned;
+                }
+                m_segments.Add(segment, segment);
+                return segment;
+            }
+
+            private int AddNode(string name)
+            {
+                if (m_nodeCount == m_nodes.Length)
+                {
+                    Array.Resize(ref m_nodes, m_nodes.Length * 2);
+                    Array.Resize(ref m_views, m_nodes.Length);
+                }
+                m_nodes[m_nodeCount] = new Node { Name = Intern(name), FirstChild = -1, LastChild = -1, NextSibling = -1, FirstFile = -1, LastFile = -1 };
+                return m_nodeCount++;
+            }
+
+            private int GetOrAddChild(int parent, string name)
+            {
+                var key = new ChildKey { Parent = parent, Name = name };
+                if (m_children.TryGetValue(key, out var child))
+                {
+                    return child;
+                }
+
+                child = AddNode(name);
+                key.Name = m_nodes[child].Name;
+                m_children.Add(key, child);
+
+                if (m_nodes[parent].LastChild < 0)
+                {
+                    m_nodes[parent].FirstChild = child;
+                }
+                else
+                {
+                    m_nodes[m_nodes[parent].LastChild].NextSibling = child;
+                }
+                m_nodes[parent].LastChild = child;
+                m_nodes[parent].ChildCount++;
+                return child;
+            }
+
+            private void AddFile(int node, string name)
+            {
+                if (m_fileCount == m_files.Length)
+                {
+                    Array.Resize(ref m_files, m_files.Length * 2);
+                }
+                m_files[m_fileCount] = new FileEntry { Name = Intern(name), Next = -1 };
+
+                if (m_nodes[node].LastFile < 0)
+                {
+                    m_nodes[node].FirstFile = m_fileCount;
+                }
+                else
+                {
+                    m_files[m_nodes[node].LastFile].Next = m_fileCount;
+                }
+                m_nodes[node].LastFile = m_fileCount;
+                m_nodes[node].FileCount++;
+                m_fileCount++;
             }
         }
     }
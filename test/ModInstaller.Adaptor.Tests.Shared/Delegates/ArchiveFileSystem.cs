@@ -69,4 +69,20 @@ public class ArchiveFileSystem : IFileSystem
             .OfType<string>()
             .ToArray();
     }
+
+    public FileSystemEntryInfo? Stat(string path)
+    {
+        var trimmed = path.TrimEnd('/', '\\');
+        var entry = _mod.Entries.FirstOrDefault(x => x.GetNormalizedName()?.TrimEnd('/', '\\') == trimmed);
+        if (entry != null)
+            return entry.IsDirectory
+                ? new FileSystemEntryInfo(FileSystemEntryKind.Directory, 0)
+                : new FileSystemEntryInfo(FileSystemEntryKind.File, entry.Size);
+
+        // Archives do not always carry entries for their directories
+        var prefix = trimmed + Path.DirectorySeparatorChar;
+        return _mod.Entries.Any(x => x.GetNormalizedName()?.StartsWith(prefix) == true)
+            ? new FileSystemEntryInfo(FileSystemEntryKind.Directory, 0)
+            : null;
+    }
 }
\ No newline at end of file
@@ -0,0 +1,174 @@
+﻿using FomodInstaller.Interface;
+using FomodInstaller.Scripting.XmlScript;
+
+using ModInstaller.Adaptor.Tests.Shared.Delegates;
+
+namespace ModInstaller.Adaptor.Typed.Tests;
+
+public class ConditionCacheTests
+{
+    // A condition type the cache doesn't know, counting how often it is evaluated
+    private class CountingCondition : ICondition
+    {
+        private readonly ICondition _inner;
+
+        public int Evaluations { get; private set; }
+
+        public CountingCondition(ICondition inner) => _inner = inner;
+
+        public bool GetIsFulfilled(ConditionStateManager csmState, CoreDelegates coreDelegates)
+        {
+            Evaluations++;
+            return _inner.GetIsFulfilled(csmState, coreDelegates);
+        }
+
+        public string GetMessage(ConditionStateManager csmState, CoreDelegates coreDelegates, bool invert) => _inner.GetMessage(csmState, coreDelegates, invert);
+    }
+
+    private int _gameVersionQueries;
+
+    private CoreDelegates CreateDelegates() => new TestCoreDelegates(
+        new CallbackPluginDelegates(_ => ["Active.esp"]),
+        new CallbackIniDelegates(null!, null!),
+        new CallbackContextDelegates(
+            () => "1.0.0",
+            () =>
+            {
+                _gameVersionQueries++;
+                return "1.5.0";
+            },
+            _ => "1.0.0",
+            null!, null!, null!, null!
+        ),
+        null!
+    );
+
+    private static Option CreateOption(string name) => new(name, "", null, new StaticOptionTypeResolver(OptionType.Optional));
+
+    // The game version is read every time the condition is evaluated, so it counts evaluations of the composite
+    private static CompositeCondition FlagAndGameVersion(string flagName, string value)
+    {
+        var condition = new CompositeCondition(ConditionOperator.And);
+        condition.Conditions.Add(new FlagCondition(flagName, value));
+        condition.Conditions.Add(new GameVersionCondition(new Version("1.0")));
+        return condition;
+    }
+
+    [Test]
+    public async Task SetFlagValueWithChangedValueInvalidates()
+    {
+        var state = new ConditionStateManager();
+        var cache = new ConditionCache(state, CreateDelegates());
+        var owner = CreateOption("Owner");
+        var condition = FlagAndGameVersion("Flag", "On");
+
+        await Assert.That(cache.IsFulfilled(condition)).IsFalse();
+        state.SetFlagValue("Flag", "On", owner);
+        await Assert.That(cache.IsFulfilled(condition)).IsTrue();
+        await Assert.That(_gameVersionQueries).IsEqualTo(2);
+    }
+
+    [Test]
+    public async Task SetFlagValueWithUnchangedValueKeepsResult()
+    {
+        var state = new ConditionStateManager();
+        var cache = new ConditionCache(state, CreateDelegates());
+        var owner = CreateOption("Owner");
+        var condition = FlagAndGameVersion("Flag", "On");
+
+        state.SetFlagValue("Flag", "On", owner);
+        await Assert.That(cache.IsFulfilled(condition)).IsTrue();
+        state.SetFlagValue("Flag", "On", CreateOption("Other"));
+        await Assert.That(cache.IsFulfilled(condition)).IsTrue();
+        await Assert.That(_gameVersionQueries).IsEqualTo(1);
+    }
+
+    [Test]
+    public async Task SetFlagValueOnlyInvalidatesDependents()
+    {
+        var state = new ConditionStateManager();
+        var cache = new ConditionCache(state, CreateDelegates());
+        var owner = CreateOption("Owner");
+        var condition = FlagAndGameVersion("Flag", "On");
+
+        await Assert.That(cache.IsFulfilled(condition)).IsFalse();
+        state.SetFlagValue("Unrelated", "On", owner);
+        await Assert.That(cache.IsFulfilled(condition)).IsFalse();
+        await Assert.That(_gameVersionQueries).IsEqualTo(1);
+    }
+
+    [Test]
+    public async Task RemoveFlagsInvalidates()
+    {
+        var state = new ConditionStateManager();
+        var cache = new ConditionCache(state, CreateDelegates());
+        var owner = CreateOption("Owner");
+        var condition = FlagAndGameVersion("Flag", "On");
+
+        state.SetFlagValue("Flag", "On", owner);
+        await Assert.That(cache.IsFulfilled(condition)).IsTrue();
+        state.RemoveFlags(owner);
+        await Assert.That(cache.IsFulfilled(condition)).IsFalse();
+        await Assert.That(_gameVersionQueries).IsEqualTo(2);
+    }
+
+    [Test]
+    public async Task PluginAndVersionConditionsAreEvaluatedOnce()
+    {
+        var state = new ConditionStateManager();
+        var cache = new ConditionCache(state, CreateDelegates());
+        var plugin = new PluginCondition("Active.esp", PluginState.Active);
+        var version = new GameVersionCondition(new Version("2.0"));
+
+        await Assert.That(cache.IsFulfilled(plugin)).IsTrue();
+        await Assert.That(cache.IsFulfilled(version)).IsFalse();
+        state.SetFlagValue("Flag", "On", CreateOption("Owner"));
+        await Assert.That(cache.IsFulfilled(plugin)).IsTrue();
+        await Assert.That(cache.IsFulfilled(version)).IsFalse();
+        await Assert.That(_gameVersionQueries).IsEqualTo(1);
+    }
+
+    [Test]
+    public async Task UnknownConditionsAreNotCached()
+    {
+        var state = new ConditionStateManager();
+        var cache = new ConditionCache(state, CreateDelegates());
+        var condition = new CountingCondition(new FlagCondition("Flag", "On"));
+        var composite = new CompositeCondition(ConditionOperator.Or);
+        composite.Conditions.Add(new FlagCondition("Other", "On"));
+        composite.Conditions.Add(condition);
+
+        await Assert.That(cache.IsFulfilled(condition)).IsFalse();
+        await Assert.That(cache.IsFulfilled(condition)).IsFalse();
+        await Assert.That(cache.IsFulfilled(composite)).IsFalse();
+        await Assert.That(cache.IsFulfilled(composite)).IsFalse();
+        await Assert.That(condition.Evaluations).IsEqualTo(4);
+    }
+
+    // A later step and an option type depending on a flag set in an earlier step, then changed by going back
+    [Test]
+    public async Task FlagChangedBetweenStepsIsNotStale()
+    {
+        var state = new ConditionStateManager();
+        var cache = new ConditionCache(state, CreateDelegates());
+        var first = CreateOption("First");
+        var second = CreateOption("Second");
+        var visible = new FlagCondition("Choice", "First");
+        var resolver = new ConditionalOptionTypeResolver(OptionType.Optional);
+        resolver.AddPattern(OptionType.Required, new FlagCondition("Choice", "Second"));
+        var option = new Option("Dependent", "", null, resolver);
+
+        state.SetFlagValue("Choice", "First", first);
+        await Assert.That(cache.IsFulfilled(visible)).IsTrue();
+        await Assert.That(cache.ResolveOptionType(option)).IsEqualTo(OptionType.Optional);
+
+        state.RemoveFlags(first);
+        state.SetFlagValue("Choice", "Second", second);
+        await Assert.That(cache.IsFulfilled(visible)).IsFalse();
+        await Assert.That(cache.ResolveOptionType(option)).IsEqualTo(OptionType.Required);
+
+        state.SetFlagValue("Choice", "First", first);
+        await Assert.That(cache.IsFulfilled(visible)).IsTrue();
+        await Assert.That(cache.ResolveOptionType(option)).IsEqualTo(OptionType.Optional);
+    }
+}
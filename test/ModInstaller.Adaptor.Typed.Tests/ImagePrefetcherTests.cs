@@ -0,0 +1,190 @@
+﻿using FomodInstaller.Scripting;
+
+using Utils;
+
+namespace ModInstaller.Adaptor.Typed.Tests;
+
+// ImagePrefetcher reads through the process-wide FileSystem.Instance
+[NotInParallel]
+public class ImagePrefetcherTests
+{
+    private sealed class GatedFileSystem : IFileSystem
+    {
+        private readonly Dictionary<string, byte[]> _files;
+        private readonly ManualResetEventSlim _gate;
+        private int _active;
+        private int _maxActive;
+
+        public int Active => Volatile.Read(ref _active);
+        public int MaxActive => Volatile.Read(ref _maxActive);
+
+        public GatedFileSystem(Dictionary<string, byte[]> files, bool open = true)
+        {
+            _files = files;
+            _gate = new ManualResetEventSlim(open);
+        }
+
+        public void Open() => _gate.Set();
+
+        public byte[]? ReadFileContent(string filePath, int offset, int length)
+        {
+            var active = Interlocked.Increment(ref _active);
+            int max;
+            while (active > (max = Volatile.Read(ref _maxActive)) && Interlocked.CompareExchange(ref _maxActive, active, max) != max)
+            {
+            }
+
+            try
+            {
+                _gate.Wait(TimeSpan.FromSeconds(10));
+                if (!_files.TryGetValue(filePath, out var content)) return null;
+                if (length == -1) length = content.Length - offset;
+                return content.Skip(offset).Take(length).ToArray();
+            }
+            finally
+            {
+                Interlocked.Decrement(ref _active);
+            }
+        }
+
+        public string[]? ReadDirectoryFileList(string directoryPath, string pattern, SearchOption searchOption) => null;
+
+        public string[]? ReadDirectoryList(string directoryPath) => null;
+
+        public FileSystemEntryInfo? Stat(string path) => _files.TryGetValue(path, out var content)
+            ? new FileSystemEntryInfo(FileSystemEntryKind.File, content.Length)
+            : null;
+    }
+
+    private static async Task WaitUntil(Func<bool> condition)
+    {
+        var deadline = DateTime.UtcNow.AddSeconds(10);
+        while (!condition())
+        {
+            if (DateTime.UtcNow > deadline)
+                throw new TimeoutException("The prefetcher didn't get there in time");
+            await Task.Delay(10);
+        }
+    }
+
+    private static Dictionary<string, byte[]> CreateImages(int count) =>
+        Enumerable.Range(0, count).ToDictionary(i => $"image{i}.png", i => new byte[] { (byte) i, 1, 2, 3 });
+
+    [Test]
+    public async Task PrefetchedImageIsAHit()
+    {
+        var images = CreateImages(1);
+        FileSystem.Instance = new GatedFileSystem(images);
+        var prefetcher = new ImagePrefetcher(1024);
+
+        prefetcher.Prefetch("", ["image0.png"]);
+        await WaitUntil(() => prefetcher.GetStats().Pending == 0);
+
+        await Assert.That(prefetcher.TryGet("image0.png")).IsEquivalentTo(images["image0.png"]);
+        // keys don't depend on the separators
+        await Assert.That(prefetcher.TryGet("/image0.png")).IsNotNull();
+        var stats = prefetcher.GetStats();
+        await Assert.That(stats.Hits).IsEqualTo(2);
+        await Assert.That(stats.Reads).IsEqualTo(1);
+        await Assert.That(stats.Count).IsEqualTo(1);
+        await Assert.That(stats.Bytes).IsEqualTo(4);
+    }
+
+    [Test]
+    public async Task UnreadOrMissingImageIsAMiss()
+    {
+        FileSystem.Instance = new GatedFileSystem(CreateImages(1));
+        var prefetcher = new ImagePrefetcher(1024);
+
+        await Assert.That(prefetcher.TryGet("image0.png")).IsNull();
+        prefetcher.Prefetch("", ["missing.png"]);
+        await WaitUntil(() => prefetcher.GetStats().Pending == 0);
+        await Assert.That(prefetcher.TryGet("missing.png")).IsNull();
+
+        var stats = prefetcher.GetStats();
+        await Assert.That(stats.Misses).IsEqualTo(2);
+        await Assert.That(stats.Failures).IsEqualTo(1);
+        await Assert.That(stats.Reads).IsEqualTo(0);
+    }
+
+    [Test]
+    public async Task NextStepCancelsReadsThatHaveNotStarted()
+    {
+        var images = CreateImages(ImagePrefetcher.MaxConcurrentReads + 2);
+        images["next.png"] = [9];
+        var fileSystem = new GatedFileSystem(images, open: false);
+        FileSystem.Instance = fileSystem;
+        var prefetcher = new ImagePrefetcher(1024);
+
+        prefetcher.Prefetch("", Enumerable.Range(0, ImagePrefetcher.MaxConcurrentReads + 2).Select(i => $"image{i}.png"));
+        await WaitUntil(() => fileSystem.Active == ImagePrefetcher.MaxConcurrentReads);
+        // the reads beyond the limit wait for a slot and are dropped with their step
+        prefetcher.Prefetch("", ["next.png"]);
+        await WaitUntil(() => prefetcher.GetStats().Pending == ImagePrefetcher.MaxConcurrentReads + 1);
+        fileSystem.Open();
+        await WaitUntil(() => prefetcher.GetStats().Pending == 0);
+
+        var stats = prefetcher.GetStats();
+        await Assert.That(fileSystem.MaxActive).IsEqualTo(ImagePrefetcher.MaxConcurrentReads);
+        await Assert.That(stats.Reads).IsEqualTo(ImagePrefetcher.MaxConcurrentReads + 1);
+        await Assert.That(stats.Count).IsEqualTo(ImagePrefetcher.MaxConcurrentReads + 1);
+        await Assert.That(prefetcher.TryGet("next.png")).IsNotNull();
+    }
+
+    [Test]
+    public async Task ImagesSharedWithThePreviousStepAreRead()
+    {
+        var images = CreateImages(ImagePrefetcher.MaxConcurrentReads + 1);
+        images["banner.png"] = [9];
+        var fileSystem = new GatedFileSystem(images, open: false);
+        FileSystem.Instance = fileSystem;
+        var prefetcher = new ImagePrefetcher(1024);
+
+        // the banner is read for the first step, the last image waits for a slot
+        var last = $"image{ImagePrefetcher.MaxConcurrentReads}.png";
+        prefetcher.Prefetch("", Enumerable.Range(0, ImagePrefetcher.MaxConcurrentReads + 1).Select(i => $"image{i}.png").Prepend("banner.png"));
+        await WaitUntil(() => fileSystem.Active == ImagePrefetcher.MaxConcurrentReads);
+        // the next step shows the banner and the last image again before either is cached
+        prefetcher.Prefetch("", ["banner.png", last]);
+        fileSystem.Open();
+        await WaitUntil(() => prefetcher.GetStats().Pending == 0);
+
+        await Assert.That(prefetcher.TryGet("banner.png")).IsNotNull();
+        await Assert.That(prefetcher.TryGet(last)).IsNotNull();
+    }
+
+    [Test]
+    public async Task ClearDropsReadsInFlight()
+    {
+        var fileSystem = new GatedFileSystem(CreateImages(1), open: false);
+        FileSystem.Instance = fileSystem;
+        var prefetcher = new ImagePrefetcher(1024);
+
+        prefetcher.Prefetch("", ["image0.png"]);
+        await WaitUntil(() => fileSystem.Active == 1);
+        // the next mod reuses the path, its read must not wait for the discarded one
+        prefetcher.Clear();
+        prefetcher.Prefetch("", ["image0.png"]);
+        await Assert.That(prefetcher.GetStats().Pending).IsEqualTo(1);
+        fileSystem.Open();
+        await WaitUntil(() => prefetcher.GetStats().Reads == 2);
+
+        await Assert.That(prefetcher.GetStats().Pending).IsEqualTo(0);
+        await Assert.That(prefetcher.TryGet("image0.png")).IsNotNull();
+    }
+
+    [Test]
+    public async Task PrefetchersDoNotShareImages()
+    {
+        FileSystem.Instance = new GatedFileSystem(CreateImages(1));
+        var first = new ImagePrefetcher(1024);
+        var second = new ImagePrefetcher(1024);
+
+        first.Prefetch("", ["image0.png"]);
+        second.Prefetch("", []);
+        await WaitUntil(() => first.GetStats().Pending == 0);
+
+        await Assert.That(first.TryGet("image0.png")).IsNotNull();
+        await Assert.That(second.TryGet("image0.png")).IsNull();
+    }
+}
@@ -1,4 +1,6 @@
 using FomodInstaller.ModInstaller;
+using FomodInstaller.Scripting;
+using FomodInstaller.Scripting.XmlScript;
 
 using ModInstaller.Adaptor.Tests.Shared.Delegates;
 using ModInstaller.Lite;
@@ -155,6 +157,142 @@ public class InstallTests
         await Assert.That(result.Message).IsEquivalentTo(data.Message);
     }
 
+    [Test]
+    [MethodDataSource(nameof(SkyrimData))]
+    [MethodDataSource(nameof(Fallout4Data))]
+    //[MethodDataSource(nameof(FalloutNVData))]
+    [MethodDataSource(nameof(FomodComplianceTestsData))]
+    [NotInParallel]
+    public async Task TestScriptCache(InstallData data)
+    {
+        ScriptCache.Shared.Clear();
+
+        // the second install reuses the parsed script, which must come out of the first one unmodified
+        for (var i = 0; i < 2; i++)
+        {
+            var coreDelegates = new TestCoreDelegates(
+                new CallbackPluginDelegates(
+                    _ => data.InstalledPlugins.ToArray()
+                ),
+                new CallbackIniDelegates(null!, null!),
+                new CallbackContextDelegates(
+                    () => data.AppVersion,
+                    () => data.GameVersion,
+                    (_) => data.ExtenderVersion,
+                    null!, null!, null!, null!
+                ),
+                new DeterministicUIContext(data.DialogChoices)
+            );
+
+            FileSystem.Instance = new ArchiveFileSystem(data.ModArchive);
+
+            var progressDelegate = new ProgressDelegate((perc) => { });
+            var result = await Installer.Install(
+                data.ModArchive.Entries.Select(x => x.GetNormalizedName()).ToList(),
+                data.StopPatterns,
+                data.PluginPath,
+                "",
+                data.Preset,
+                false,
+                data.Validate,
+                progressDelegate,
+                coreDelegates);
+
+            await Assert.That(result.Instructions.Order()).IsEquivalentTo(data.Instructions.Order());
+            await Assert.That(result.Message).IsEquivalentTo(data.Message);
+        }
+
+        // every data set comes with an install script, so the cache can't stay empty
+        var stats = ScriptCache.Shared.GetStats();
+        await Assert.That(stats.Count).IsEqualTo(1);
+        await Assert.That(stats.Hits).IsEqualTo(1);
+        await Assert.That(stats.Misses).IsEqualTo(1);
+    }
+
+    [Test]
+    [MethodDataSource(nameof(SkyrimData))]
+    [MethodDataSource(nameof(Fallout4Data))]
+    //[MethodDataSource(nameof(FalloutNVData))]
+    [MethodDataSource(nameof(FomodComplianceTestsData))]
+    [NotInParallel]
+    public async Task TestScriptDiskCache(InstallData data)
+    {
+        var cacheDirectory = Path.Combine(Path.GetTempPath(), "fomod-script-cache-" + Guid.NewGuid().ToString("N"));
+        ScriptCache.Shared.CacheDirectory = cacheDirectory;
+        try
+        {
+            // the second install starts with an empty memory cache, so the script has to come back from disk
+            for (var i = 0; i < 2; i++)
+            {
+                ScriptCache.Shared.Clear();
+
+                var coreDelegates = new TestCoreDelegates(
+                    new CallbackPluginDelegates(
+                        _ => data.InstalledPlugins.ToArray()
+                    ),
+                    new CallbackIniDelegates(null!, null!),
+                    new CallbackContextDelegates(
+                        () => data.AppVersion,
+                        () => data.GameVersion,
+                        (_) => data.ExtenderVersion,
+                        null!, null!, null!, null!
+                    ),
+                    new DeterministicUIContext(data.DialogChoices)
+                );
+
+                FileSystem.Instance = new ArchiveFileSystem(data.ModArchive);
+
+                var progressDelegate = new ProgressDelegate((perc) => { });
+                var result = await Installer.Install(
+                    data.ModArchive.Entries.Select(x => x.GetNormalizedName()).ToList(),
+                    data.StopPatterns,
+                    data.PluginPath,
+                    "",
+                    data.Preset,
+                    false,
+                    data.Validate,
+                    progressDelegate,
+                    coreDelegates);
+
+                await Assert.That(result.Instructions.Order()).IsEquivalentTo(data.Instructions.Order());
+                await Assert.That(result.Message).IsEquivalentTo(data.Message);
+
+                // the first install has to leave the parsed script behind on disk
+                if (i == 0)
+                    await Assert.That(Directory.EnumerateFiles(cacheDirectory, "*.bin").Count()).IsEqualTo(1);
+            }
+
+            var stats = ScriptCache.Shared.GetStats();
+            await Assert.That(stats.DiskHits).IsEqualTo(1);
+            await Assert.That(stats.Misses).IsEqualTo(1);
+        }
+        finally
+        {
+            ScriptCache.Shared.CacheDirectory = null;
+            ScriptCache.Shared.Clear();
+            if (Directory.Exists(cacheDirectory))
+                Directory.Delete(cacheDirectory, true);
+        }
+    }
+
+    [Test]
+    [NotInParallel]
+    public async Task TestWarmup()
+    {
+        var result = Installer.Warmup(WarmupOptions.All);
+
+        await Assert.That(result.SchemaSets).IsEqualTo(XmlScriptType.ScriptVersions.Length);
+        await Assert.That(result.ScriptsParsed).IsEqualTo(1);
+        await Assert.That(result.Total).IsGreaterThanOrEqualTo(result.Schemas + result.ScriptTypes);
+
+        // parts that aren't requested are skipped
+        var partial = Installer.Warmup(new WarmupOptions { Schemas = true });
+
+        await Assert.That(partial.SchemaSets).IsEqualTo(XmlScriptType.ScriptVersions.Length);
+        await Assert.That(partial.ScriptsParsed).IsEqualTo(0);
+        await Assert.That(partial.ScriptTypes).IsEqualTo(0);
+    }
+
     [Test]
     [MethodDataSource(nameof(SkyrimData))]
     [MethodDataSource(nameof(Fallout4Data))]
@@ -26,4 +26,27 @@ public class TestSupportedTests
             RequiredFiles = data.RequiredFiles
         });
     }
+
+    [Test]
+    public async Task TestMany()
+    {
+        var data = BasicData().Concat(XmlData()).Concat(LiteData()).Select(x => x()).ToList();
+        var requests = data.Select(x => new SupportedRequest
+        {
+            Files = x.ModArchiveFileList,
+            AllowedTypes = x.AllowedTypes,
+        }).ToList();
+
+        var results = Installer.TestSupportedMany(requests);
+
+        await Assert.That(results.Length).IsEqualTo(data.Count);
+        for (var i = 0; i < data.Count; i++)
+        {
+            await Assert.That(results[i]).IsEquivalentTo(new SupportedResult()
+            {
+                Supported = data[i].Supported,
+                RequiredFiles = data[i].RequiredFiles
+            });
+        }
+    }
 }
\ No newline at end of file
@@ -27,7 +27,11 @@ public sealed partial class InstallTests : BaseTests
         // FileSystem Delegates
         delegate* unmanaged[Cdecl]<param_ptr*, param_string*, param_int, param_int, return_value_data*> p_read_file_content,
         delegate* unmanaged[Cdecl]<param_ptr*, param_string*, param_string*, param_int, return_value_json*> p_read_directory_file_list,
-        delegate* unmanaged[Cdecl]<param_ptr*, param_string*, return_value_json*> p_read_directory_list);
+        delegate* unmanaged[Cdecl]<param_ptr*, param_string*, return_value_json*> p_read_directory_list,
+        delegate* unmanaged[Cdecl]<param_ptr*, param_string*, return_value_json*> p_stat,
+        delegate* unmanaged[Cdecl]<param_ptr*, param_string*, return_value_json*> p_open_file,
+        delegate* unmanaged[Cdecl]<param_ptr*, param_int, param_int, param_int, return_value_data*> p_read_file,
+        delegate* unmanaged[Cdecl]<param_ptr*, param_int, return_value_void*> p_close_file);
 
     
     [LibraryImport(DllPath), UnmanagedCallConv(CallConvs = [typeof(CallConvStdcall)])]
@@ -58,6 +62,7 @@ public sealed partial class InstallTests : BaseTests
         param_json* p_preset,
         param_bool preselect,
         param_bool validate,
+        param_bool headless,
         param_ptr* p_callback_handler,
         delegate* unmanaged[Cdecl]<param_ptr*, return_value_json*, void> p_callback);
 
@@ -85,7 +90,11 @@ public sealed partial class InstallTests : BaseTests
         var fsResult = set_file_system_callbacks((param_ptr*) handle.ToPointer(),
             p_read_file_content: &ModInstallerWrapper.ReadFileContent,
             p_read_directory_file_list: &ModInstallerWrapper.ReadDirectoryFileList,
-            p_read_directory_list: &ModInstallerWrapper.ReadDirectoryList);
+            p_read_directory_list: &ModInstallerWrapper.ReadDirectoryList,
+            p_stat: &ModInstallerWrapper.Stat,
+            p_open_file: null,
+            p_read_file: null,
+            p_close_file: null);
         if (fsResult != 0) throw new Exception($"set_file_system_callbacks failed with code {fsResult}");
         
         var ptr = GetResult(create_handler((param_ptr*) handle.ToPointer(),
@@ -126,6 +135,7 @@ public sealed partial class InstallTests : BaseTests
             data.Preset is null ? (param_json*) null : preset,
             data.Preselect,
             data.Validate,
+            false,
             (param_ptr*) tcsPtr,
             &InstallCallback));
     }
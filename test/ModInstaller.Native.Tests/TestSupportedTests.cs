@@ -25,6 +25,13 @@ public sealed partial class TestSupportedTests : BaseTests
         param_json* p_mod_archive_file_list,
         param_json* p_allowed_types);
 
+    [LibraryImport(DllPath), UnmanagedCallConv(CallConvs = [typeof(CallConvStdcall)])]
+    private static unsafe partial return_value_async* test_supported_async(
+        param_json* p_mod_archive_file_list,
+        param_json* p_allowed_types,
+        param_ptr* p_callback_handler,
+        delegate* unmanaged[Cdecl]<param_ptr*, return_value_json*, void> p_callback);
+
     public static TestClass BasicData() => TestSupportDataSource.BasicData().NUnit();
     public static TestClass XmlData() => TestSupportDataSource.XmlData().NUnit();
     public static TestClass LiteData() => TestSupportDataSource.LiteData().NUnit();
@@ -47,4 +54,41 @@ public sealed partial class TestSupportedTests : BaseTests
 
         LibraryAliveCount().Should().Be(0);
     }
+
+    [UnmanagedCallersOnly(CallConvs = [typeof(CallConvCdecl)])]
+    private static unsafe void TestSupportedCallback(param_ptr* owner, return_value_json* result)
+    {
+        var tcs = (TaskCompletionSource<SupportedResult?>) GCHandle.FromIntPtr((IntPtr) owner).Target!;
+        GetResult(result, tcs);
+    }
+
+    private static unsafe void CallAsync(TestSupportData data, IntPtr tcsPtr)
+    {
+        using var modArchiveFileListJson = ToJson(data.ModArchiveFileList);
+        using var allowedTypesJson = ToJson(data.AllowedTypes);
+
+        GetResult(test_supported_async(modArchiveFileListJson, allowedTypesJson, (param_ptr*) tcsPtr, &TestSupportedCallback));
+    }
+
+    [Test]
+    [TestCaseSource(nameof(BasicData))]
+    [TestCaseSource(nameof(XmlData))]
+    [TestCaseSource(nameof(LiteData))]
+    public async Task TestAsync(TestSupportData data)
+    {
+        {
+            var tcs = new TaskCompletionSource<SupportedResult?>(TaskCreationOptions.RunContinuationsAsynchronously);
+            var tcsPtr = GCHandle.ToIntPtr(GCHandle.Alloc(tcs, GCHandleType.Normal));
+
+            CallAsync(data, tcsPtr);
+
+            var result = await tcs.Task;
+            GCHandle.FromIntPtr(tcsPtr).Free();
+
+            result.Should().NotBeNull();
+            result!.RequiredFiles.Order().Should().BeEquivalentTo(data.RequiredFiles.Order());
+        }
+
+        LibraryAliveCount().Should().Be(0);
+    }
 }
\ No newline at end of file
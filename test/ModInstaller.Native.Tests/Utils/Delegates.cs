@@ -34,5 +34,8 @@ public unsafe delegate return_value_json* ReadDirectoryFileListDelegate(param_pt
 [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
 public unsafe delegate return_value_json* ReadDirectoryListDelegate(param_ptr* handler, param_string* pDirectoryPath);
 
+[UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+public unsafe delegate return_value_json* StatDelegate(param_ptr* handler, param_string* pPath);
+
 [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
 public unsafe delegate void InstallCallbackDelegate(param_ptr* owner, return_value_json* result);
\ No newline at end of file
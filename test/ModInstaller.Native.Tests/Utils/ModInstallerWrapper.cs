@@ -130,6 +130,33 @@ public sealed class ModInstallerWrapper
         }
     }
 
+    [UnmanagedCallersOnly(CallConvs = [typeof(CallConvCdecl)])]
+    public static unsafe return_value_json* Stat(param_ptr* handler, param_string* pPath)
+    {
+        try
+        {
+            var path = new string(param_string.ToSpan(pPath)).TrimEnd('/', '\\');
+
+            var modInstallerWrapper = (ModInstallerWrapper) GCHandle.FromIntPtr((IntPtr) handler).Target!;
+            var entries = modInstallerWrapper._data.ModArchive.Entries;
+
+            var entry = entries.FirstOrDefault(x => x.GetNormalizedName()?.TrimEnd('/', '\\') == path);
+            StatResult? stat = entry switch
+            {
+                { IsDirectory: true } => new StatResult("directory", 0),
+                not null => new StatResult("file", entry.Size),
+                _ when entries.Any(x => x.GetNormalizedName()?.StartsWith(path + Path.DirectorySeparatorChar) == true) => new StatResult("directory", 0),
+                _ => null,
+            };
+
+            return return_value_json.AsValue(stat, Utils2.CustomSourceGenerationContext.StatResult, false);
+        }
+        catch (Exception e)
+        {
+            return return_value_json.AsException(e, false);
+        }
+    }
+
     [UnmanagedCallersOnly(CallConvs = [typeof(CallConvCdecl)])]
     public static unsafe return_value_json* PluginsGetAll(param_ptr* handler, param_bool includeDisabled)
     {
@@ -248,7 +275,7 @@ public sealed class ModInstallerWrapper
         {
             var modInstallerWrapper = (ModInstallerWrapper) GCHandle.FromIntPtr((IntPtr) handler).Target!;
 
-            var installSteps = BUTR.NativeAOT.Shared.Utils.DeserializeJson(p_install_steps, SourceGenerationContext.Default.InstallerStepArray);
+            var installSteps = BUTR.NativeAOT.Shared.Utils.DeserializeJson(p_install_steps, SourceGenerationContext.Default.InstallerStepsState)!.ToInstallerSteps();
             var currentStepValue = (int) current_step;
 
             modInstallerWrapper._installerSteps = installSteps;
@@ -23,4 +23,35 @@ namespace ModInstaller.Native.Tests.Utils;
 [JsonSerializable(typeof(InstallResult))]
 [JsonSerializable(typeof(JsonDocument))]
 [JsonSerializable(typeof(InstallerStep[]))]
-internal partial class SourceGenerationContext : JsonSerializerContext;
\ No newline at end of file
+[JsonSerializable(typeof(InstallerStepsState))]
+[JsonSerializable(typeof(StatResult))]
+internal partial class SourceGenerationContext : JsonSerializerContext;
+
+public record StatResult(string Kind, long Size);
+
+// The uiUpdateState payload, option images are cut from the directories in Prefixes
+public record InstallerStepsState(string[] Prefixes, int[] ImagePrefixes, InstallerStep[] Steps)
+{
+    /// <summary>
+    /// Joins the option images back onto their directories, in step, group and option order like ImagePrefixes.
+    /// </summary>
+    public InstallerStep[] ToInstallerSteps()
+    {
+        var option = 0;
+        foreach (var step in Steps)
+        {
+            if (step.optionalFileGroups.group is null) continue;
+
+            foreach (var group in step.optionalFileGroups.group)
+            {
+                foreach (var item in group.options)
+                {
+                    var prefix = ImagePrefixes[option++];
+                    if (prefix >= 0)
+                        item.image = Prefixes[prefix] + item.image;
+                }
+            }
+        }
+        return Steps;
+    }
+}
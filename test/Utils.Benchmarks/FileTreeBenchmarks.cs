@@ -0,0 +1,58 @@
+﻿using System.Collections.Generic;
+using System.IO;
+using System.Linq;
+using BenchmarkDotNet.Attributes;
+
+namespace Utils.Benchmarks;
+
+/// <summary>
+/// Builds a tree from a large archive listing and walks it the way ArchiveStructure.FindPathPrefix does
+/// </summary>
+[MemoryDiagnoser]
+public class FileTreeBenchmarks
+{
+    [Params(1_000, 100_000)]
+    public int FileCount { get; set; }
+
+    private string[] _paths = [];
+    private string[] _directories = [];
+
+    [GlobalSetup]
+    public void Setup()
+    {
+        // Deterministic mod-like layout: a few top level folders with deep texture/mesh trees
+        string[] roots = ["Data", "Docs", "fomod", "Optional"];
+        string[] kinds = ["textures", "meshes", "sound", "scripts"];
+        var paths = new List<string>(FileCount);
+        for (var i = 0; i < FileCount; i++)
+        {
+            paths.Add($@"{roots[i % roots.Length]}\{kinds[i / 7 % kinds.Length]}\set{i / 97 % 50}\group{i / 13 % 20}\file{i}.dat");
+        }
+        _paths = [.. paths];
+        _directories = [.. paths.Select(path => Path.GetDirectoryName(path.Replace('\\', '/'))!).Distinct().Take(1000)];
+    }
+
+    [Benchmark(Baseline = true)]
+    public int LinqBuildAndWalk() => Walk(new LinqFileTree(_paths));
+
+    [Benchmark]
+    public int TrieBuildAndWalk() => Walk(new FileTree(_paths));
+
+    [Benchmark]
+    public int LinqSelect()
+    {
+        var tree = new LinqFileTree(_paths);
+        return _directories.Sum(directory => tree.SelectDirectory(directory).Files.Count());
+    }
+
+    [Benchmark]
+    public int TrieSelect()
+    {
+        var tree = new FileTree(_paths);
+        return _directories.Sum(directory => tree.SelectDirectory(directory)!.Files.Count());
+    }
+
+    private static int Walk(LinqFileTree tree) => tree.Files.Count() + tree.SubDirectories.Sum(Walk);
+
+    private static int Walk(FileTree tree) => tree.Files.Count() + tree.SubDirectories.Sum(Walk);
+}
@@ -0,0 +1,188 @@
+﻿using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Linq;
+using System.Threading.Tasks;
+
+namespace Utils.Tests;
+
+public class FileSystemStreamTests
+{
+    private sealed class HandleFileSystem : IFileSystem, IFileHandleSystem
+    {
+        private readonly MemoryFileSystem _files;
+        private int _next = 1;
+
+        public HashSet<int> Open { get; } = [];
+
+        public HandleFileSystem(MemoryFileSystem files) => _files = files;
+
+        public FileHandle? OpenFile(string filePath) => _files.Stat(filePath) is { } stat
+            ? new FileHandle(filePath, stat.Size, Add(_next++))
+            : null;
+
+        public byte[]? ReadFile(FileHandle handle, int offset, int length) => Open.Contains(handle.Id)
+            ? _files.ReadFileContent(handle.FilePath, offset, length)
+            : throw new InvalidOperationException("The handle is closed");
+
+        public void CloseFile(FileHandle handle) => Open.Remove(handle.Id);
+
+        public byte[]? ReadFileContent(string filePath, int offset, int length) => _files.ReadFileContent(filePath, offset, length);
+
+        public string[]? ReadDirectoryFileList(string directoryPath, string pattern, SearchOption searchOption) => null;
+
+        public string[]? ReadDirectoryList(string directoryPath) => null;
+
+        public FileSystemEntryInfo? Stat(string path) => _files.Stat(path);
+
+        private int Add(int id)
+        {
+            Open.Add(id);
+            return id;
+        }
+    }
+
+    private sealed class MemoryFileSystem : IFileSystem
+    {
+        private readonly Dictionary<string, byte[]> _files;
+        private readonly bool _knownSize;
+
+        public List<(int Offset, int Length)> Reads { get; } = [];
+
+        public MemoryFileSystem(Dictionary<string, byte[]> files, bool knownSize = true)
+        {
+            _files = files;
+            _knownSize = knownSize;
+        }
+
+        public byte[]? ReadFileContent(string filePath, int offset, int length)
+        {
+            if (!_files.TryGetValue(filePath, out var content)) return null;
+            Reads.Add((offset, length));
+            if (length == -1) length = content.Length - offset;
+            return content.Skip(offset).Take(length).ToArray();
+        }
+
+        public string[]? ReadDirectoryFileList(string directoryPath, string pattern, SearchOption searchOption) => null;
+
+        public string[]? ReadDirectoryList(string directoryPath) => null;
+
+        public FileSystemEntryInfo? Stat(string path) => _files.TryGetValue(path, out var content)
+            ? new FileSystemEntryInfo(FileSystemEntryKind.File, _knownSize ? content.Length : -1)
+            : null;
+    }
+
+    private static byte[] CreateContent(int length) => Enumerable.Range(0, length).Select(i => (byte) (i * 31)).ToArray();
+
+    [Test]
+    public async Task ReadsAcrossGrowingChunks()
+    {
+        var content = CreateContent(FileSystemStream.MinChunkSize * 5 + 123);
+        var fileSystem = new MemoryFileSystem(new() { ["big.bin"] = content });
+
+        using var stream = FileSystemStream.Open(fileSystem, "big.bin")!;
+        using var copy = new MemoryStream();
+        stream.CopyTo(copy, 4096);
+
+        await Assert.That(copy.ToArray().SequenceEqual(content)).IsTrue();
+        await Assert.That(fileSystem.Reads.Select(x => x.Length).Max()).IsLessThanOrEqualTo(FileSystemStream.MaxChunkSize);
+        // 64 KiB, 128 KiB and the rest
+        await Assert.That(fileSystem.Reads.Count).IsEqualTo(3);
+    }
+
+    [Test]
+    public async Task SeekingRestartsWithSmallChunks()
+    {
+        var content = CreateContent(FileSystemStream.MaxChunkSize * 2);
+        var fileSystem = new MemoryFileSystem(new() { ["big.bin"] = content });
+
+        using var stream = FileSystemStream.Open(fileSystem, "big.bin")!;
+        stream.Seek(-10, SeekOrigin.End);
+        var buffer = new byte[20];
+        var read = stream.Read(buffer, 0, buffer.Length);
+
+        await Assert.That(read).IsEqualTo(10);
+        await Assert.That(buffer.Take(10).SequenceEqual(content.Skip(content.Length - 10))).IsTrue();
+        await Assert.That(fileSystem.Reads.Single()).IsEqualTo((content.Length - 10, 10));
+    }
+
+    [Test]
+    public async Task FindsTheEndOfFilesWithUnknownSize()
+    {
+        var content = CreateContent(FileSystemStream.MinChunkSize + 1);
+        var fileSystem = new MemoryFileSystem(new() { ["file.bin"] = content }, knownSize: false);
+
+        using var stream = FileSystemStream.Open(fileSystem, "file.bin")!;
+        using var copy = new MemoryStream();
+        stream.CopyTo(copy);
+
+        await Assert.That(copy.ToArray().SequenceEqual(content)).IsTrue();
+        await Assert.That(stream.Length).IsEqualTo(content.Length);
+    }
+
+    [Test]
+    public async Task ReadToEndUsesLargestChunks()
+    {
+        var content = CreateContent(FileSystemStream.MaxChunkSize + 1);
+        var fileSystem = new MemoryFileSystem(new() { ["file.bin"] = content });
+
+        using var stream = FileSystemStream.Open(fileSystem, "file.bin")!;
+        var data = stream.ReadToEnd();
+
+        await Assert.That(data.SequenceEqual(content)).IsTrue();
+        await Assert.That(fileSystem.Reads.Count).IsEqualTo(2);
+    }
+
+    [Test]
+    public async Task MissingFilesAreNotOpened()
+    {
+        var fileSystem = new MemoryFileSystem(new());
+
+        await Assert.That(FileSystemStream.Open(fileSystem, "missing.bin")).IsNull();
+    }
+
+    [Test]
+    [NotInParallel]
+    public async Task ReadAllBytesIsASingleRead()
+    {
+        var content = CreateContent(FileSystemStream.MaxChunkSize + 1);
+        var files = new MemoryFileSystem(new() { ["file.bin"] = content });
+        var fileSystem = new HandleFileSystem(files);
+        var previous = FileSystem.Instance;
+        FileSystem.Instance = fileSystem;
+        try
+        {
+            await Assert.That(FileSystem.ReadAllBytes("file.bin").SequenceEqual(content)).IsTrue();
+            await Assert.That(files.Reads.Single()).IsEqualTo((0, -1));
+            await Assert.That(fileSystem.Open).IsEmpty();
+        }
+        finally
+        {
+            FileSystem.Instance = previous;
+        }
+    }
+
+    [Test]
+    public async Task TrackedStreamsAreClosed()
+    {
+        var fileSystem = new HandleFileSystem(new MemoryFileSystem(new() { ["a.bin"] = CreateContent(10), ["b.bin"] = CreateContent(10) }));
+
+        FileSystemStream? leaked = null;
+        await Task.Run(async () =>
+        {
+            using var openStreams = FileSystemStream.TrackOpenStreams();
+            using (FileSystemStream.Open(fileSystem, "a.bin"))
+            {
+            }
+            // opened further down the flow and never disposed
+            leaked = await Task.Run(() => FileSystemStream.Open(fileSystem, "b.bin"));
+            await Assert.That(fileSystem.Open.Count).IsEqualTo(1);
+        });
+
+        await Assert.That(fileSystem.Open).IsEmpty();
+        await Assert.That(leaked!.CanRead).IsFalse();
+        // outside of the tracked flow streams are left to their owner
+        using var untracked = FileSystemStream.Open(fileSystem, "a.bin");
+        await Assert.That(fileSystem.Open.Count).IsEqualTo(1);
+    }
+}
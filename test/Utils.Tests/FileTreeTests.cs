@@ -72,4 +72,42 @@ public class FileTreeTests
 
         await Assert.That(tree.SelectDirectory("/top/middle/end").Files).IsEquivalentTo(["somefile.txt"]);
     }
+
+    [Test]
+    public async Task DirectoryNamesIgnoreCase()
+    {
+        var tree = new FileTree(
+        [
+            @"Data/Textures/a.dds",
+            @"data/textures/b.dds",
+            @"DATA/meshes/c.nif",
+        ]);
+
+        await Assert.That(tree.SubDirectories.Select(dir => dir.Name)).IsEquivalentTo(["Data"]);
+        await Assert.That(tree.SelectDirectory("data/TEXTURES").Files).IsEquivalentTo(["a.dds", "b.dds"]);
+        await Assert.That(tree.SelectDirectory("Data").SubDirectories.Select(dir => dir.Name)).IsEquivalentTo(["Textures", "meshes"]);
+    }
+
+    [Test]
+    public async Task MissingDirectoriesSelectNull()
+    {
+        var tree = new FileTree(
+        [
+            @"top/middle/somefile.txt",
+        ]);
+
+        await Assert.That(tree.SelectDirectory("/top/other")).IsNull();
+        await Assert.That(tree.SelectDirectory("top/middle/somefile.txt")).IsNull();
+    }
+
+    [Test]
+    public async Task SelectingTwiceReturnsTheSameDirectory()
+    {
+        var tree = new FileTree(
+        [
+            @"top/middle/somefile.txt",
+        ]);
+
+        await Assert.That(tree.SelectDirectory("top/middle")).IsSameReferenceAs(tree.SubDirectories.First().SubDirectories.First());
+    }
 }
\ No newline at end of file